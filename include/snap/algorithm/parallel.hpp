@@ -0,0 +1,510 @@
+#ifndef SNP_INCLUDE_SNAP_ALGORITHM_PARALLEL_HPP
+#define SNP_INCLUDE_SNAP_ALGORITHM_PARALLEL_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/span.hpp"
+#include "snap/stop_token/stop_source.hpp"
+#include "snap/thread/thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace parallel
+{
+	// Where and how a parallel algorithm runs.
+	struct policy
+	{
+		// Pool that runs the helper tasks. nullptr uses default_pool().
+		thread_pool* pool = nullptr;
+
+		// Checked between chunks. Once stop is requested no further chunk starts and the algorithm throws
+		// operation_cancelled; output written by chunks that already ran is left in place.
+		stop_token token{};
+
+		// Minimum number of elements per chunk. 0 picks a default suited to cheap per-element work; raise it for
+		// very cheap bodies, lower it when each element is expensive.
+		std::size_t grain = 0;
+	};
+
+	// Thrown by a parallel algorithm whose policy token was stopped before all of its chunks ran.
+	class operation_cancelled : public std::exception
+	{
+	public:
+		[[nodiscard]] const char* what() const noexcept override { return "snap::parallel: operation cancelled"; }
+	};
+
+	// Process-wide pool used when a policy names none. Created on first use with hardware_concurrency() workers.
+	thread_pool& default_pool();
+} // namespace parallel
+
+namespace internal::detail
+{
+	using parallel_chunk_fn = void (*)(void* ctx, std::size_t begin, std::size_t end);
+
+	inline constexpr std::size_t parallel_default_grain = 2048;
+
+	// Runs fn over [0, n) in chunks of at least `grain` indices. The calling thread takes part, and helper tasks on
+	// the pool claim chunks from a shared cursor. Chunks shrink as the remaining range shrinks (guided
+	// self-scheduling), so uneven per-element cost still balances. The first exception thrown by fn stops the
+	// remaining chunks and is rethrown here.
+	void parallel_chunks(const parallel::policy& pol, std::size_t n, std::size_t grain, parallel_chunk_fn fn, void* ctx);
+
+	// Number of threads that can take part in a call with `pol`: the pool's workers plus the caller.
+	std::size_t parallel_concurrency(const parallel::policy& pol);
+
+	template <class Body> void for_chunks(const parallel::policy& pol, std::size_t n, std::size_t grain, Body& body)
+	{
+		parallel_chunks(
+			pol, n, grain, [](void* ctx, std::size_t begin, std::size_t end) { (*static_cast<Body*>(ctx))(begin, end); }, &body);
+	}
+
+	inline std::size_t parallel_grain(const parallel::policy& pol) noexcept
+	{
+		return pol.grain != 0 ? pol.grain : parallel_default_grain;
+	}
+
+	// Splits n elements into a fixed number of contiguous blocks for the algorithms that combine per-block results
+	// (reduce, scan, sort). The block count depends only on n, the grain and the concurrency, so results of
+	// associative but non-commutative operations are reproducible.
+	class parallel_blocks
+	{
+	public:
+		parallel_blocks(const parallel::policy& pol, std::size_t n) : n_(n)
+		{
+			const std::size_t by_grain = (n + parallel_grain(pol) - 1) / parallel_grain(pol);
+			count_					   = std::max<std::size_t>(1, std::min(by_grain, parallel_concurrency(pol) * 4));
+		}
+
+		[[nodiscard]] std::size_t count() const noexcept { return count_; }
+		[[nodiscard]] std::size_t begin(std::size_t block) const noexcept { return block * n_ / count_; }
+		[[nodiscard]] std::size_t end(std::size_t block) const noexcept { return (block + 1) * n_ / count_; }
+
+	private:
+		std::size_t n_;
+		std::size_t count_;
+	};
+
+	// Block-wise reduce of project(i) for i in [0, n); blocks are combined left to right after init.
+	template <class U, class Reduce, class Project>
+	U parallel_reduce_blocks(const parallel::policy& pol, std::size_t n, U init, Reduce& reduce, Project& project)
+	{
+		const parallel_blocks blocks(pol, n);
+		std::vector<std::optional<U>> partial(blocks.count());
+
+		auto body = [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t k = first; k < last; ++k)
+			{
+				const std::size_t b = blocks.begin(k);
+				const std::size_t e = blocks.end(k);
+				if (b == e) { continue; }
+
+				U acc = project(b);
+				for (std::size_t i = b + 1; i < e; ++i) { acc = reduce(std::move(acc), project(i)); }
+				partial[k].emplace(std::move(acc));
+			}
+		};
+		for_chunks(pol, blocks.count(), 1, body);
+
+		for (auto& p : partial)
+		{
+			if (p) { init = reduce(std::move(init), std::move(*p)); }
+		}
+		return init;
+	}
+
+	// Number of elements the first d outputs of merging sorted a[0, na) and b[0, nb) take from a, with ties taken
+	// from a as std::merge does; parallel::sort uses it to find where each merge piece starts in both inputs.
+	template <class T, class Compare> std::size_t merge_corank(std::size_t d, const T* a, std::size_t na, const T* b, std::size_t nb, Compare& comp)
+	{
+		std::size_t lo = d > nb ? d - nb : 0;
+		std::size_t hi = d < na ? d : na;
+		while (lo < hi)
+		{
+			const std::size_t i = lo + (hi - lo) / 2;
+			const std::size_t j = d - i;
+			if (j > 0 && !comp(b[j - 1], a[i])) { lo = i + 1; }
+			else { hi = i; }
+		}
+		return lo;
+	}
+
+	// Moves the merge of [a, a_end) and [b, b_end) to out. With Construct the output is raw storage and the elements
+	// are move-constructed into it; if that throws, the ones already built are destroyed.
+	template <bool Construct, class T, class Compare> void merge_move(T* a, T* a_end, T* b, T* b_end, T* out, Compare& comp)
+	{
+		T* const out_begin = out;
+		const auto put	   = [&out](T& x)
+		{
+			if constexpr (Construct) { ::new (static_cast<void*>(out)) T(std::move(x)); }
+			else { *out = std::move(x); }
+			++out;
+		};
+		try
+		{
+			while (a != a_end && b != b_end)
+			{
+				if (comp(*b, *a)) { put(*b++); }
+				else { put(*a++); }
+			}
+			while (a != a_end) { put(*a++); }
+			while (b != b_end) { put(*b++); }
+		}
+		catch (...)
+		{
+			if constexpr (Construct) { std::destroy(out_begin, out); }
+			throw;
+		}
+	}
+
+	// Uninitialized buffer of n elements for the merge rounds of parallel::sort.
+	template <class T> class merge_scratch
+	{
+	public:
+		explicit merge_scratch(std::size_t n) : n_(n), data_(std::allocator<T>().allocate(n)) {}
+		~merge_scratch() { std::allocator<T>().deallocate(data_, n_); }
+
+		merge_scratch(const merge_scratch&)			   = delete;
+		merge_scratch& operator=(const merge_scratch&) = delete;
+
+		[[nodiscard]] T* data() const noexcept { return data_; }
+
+	private:
+		std::size_t n_;
+		T* data_;
+	};
+} // namespace internal::detail
+
+// Parallel algorithms over snap::span, for toolchains where <execution> is missing or drags in TBB.
+//
+// Every algorithm has an overload taking a parallel::policy first; the overloads without one use default_pool()
+// and no cancellation. Small inputs run inline on the calling thread. Exceptions thrown by user callables
+// propagate out of the algorithm once every chunk in flight has finished.
+namespace parallel
+{
+	// Calls f(x) for every element of s.
+	template <class T, std::size_t Extent, class F> void for_each(const policy& pol, span<T, Extent> s, F f)
+	{
+		T* data	  = s.data();
+		auto body = [&](std::size_t b, std::size_t e)
+		{
+			for (std::size_t i = b; i < e; ++i) { std::invoke(f, data[i]); }
+		};
+		internal::detail::for_chunks(pol, s.size(), internal::detail::parallel_grain(pol), body);
+	}
+
+	template <class T, std::size_t Extent, class F> void for_each(span<T, Extent> s, F f)
+	{
+		parallel::for_each(policy{}, s, std::move(f));
+	}
+
+	// out[i] = f(in[i]). out must hold at least in.size() elements; in and out may be the same range.
+	template <class T, std::size_t InExtent, class U, std::size_t OutExtent, class F>
+	void transform(const policy& pol, span<T, InExtent> in, span<U, OutExtent> out, F f)
+	{
+		assert(out.size() >= in.size());
+		T* src	  = in.data();
+		U* dst	  = out.data();
+		auto body = [&](std::size_t b, std::size_t e)
+		{
+			for (std::size_t i = b; i < e; ++i) { dst[i] = std::invoke(f, src[i]); }
+		};
+		internal::detail::for_chunks(pol, in.size(), internal::detail::parallel_grain(pol), body);
+	}
+
+	template <class T, std::size_t InExtent, class U, std::size_t OutExtent, class F> void transform(span<T, InExtent> in, span<U, OutExtent> out, F f)
+	{
+		parallel::transform(policy{}, in, out, std::move(f));
+	}
+
+	// Folds s into init with op. op must be associative; the grouping is fixed for a given size and policy, so
+	// floating-point results are reproducible from run to run.
+	template <class T, std::size_t Extent, class U, class Op = std::plus<>> U reduce(const policy& pol, span<T, Extent> s, U init, Op op = Op{})
+	{
+		T* data		 = s.data();
+		auto project = [data](std::size_t i) -> T& { return data[i]; };
+		return internal::detail::parallel_reduce_blocks(pol, s.size(), std::move(init), op, project);
+	}
+
+	template <class T, std::size_t Extent, class U, class Op = std::plus<>> U reduce(span<T, Extent> s, U init, Op op = Op{})
+	{
+		return parallel::reduce(policy{}, s, std::move(init), std::move(op));
+	}
+
+	// Folds transform(x) for every x in s into init with reduce.
+	template <class T, std::size_t Extent, class U, class Reduce, class Transform>
+	U transform_reduce(const policy& pol, span<T, Extent> s, U init, Reduce reduce, Transform transform)
+	{
+		T* data		 = s.data();
+		auto project = [&](std::size_t i) { return std::invoke(transform, data[i]); };
+		return internal::detail::parallel_reduce_blocks(pol, s.size(), std::move(init), reduce, project);
+	}
+
+	template <class T, std::size_t Extent, class U, class Reduce, class Transform>
+	U transform_reduce(span<T, Extent> s, U init, Reduce reduce, Transform transform)
+	{
+		return parallel::transform_reduce(policy{}, s, std::move(init), std::move(reduce), std::move(transform));
+	}
+
+	// Folds transform(a[i], b[i]) into init with reduce; b must be at least as long as a. Defaults to an inner product.
+	template <class T1, std::size_t Extent1, class T2, std::size_t Extent2, class U, class Reduce = std::plus<>, class Transform = std::multiplies<>>
+	U transform_reduce(const policy& pol, span<T1, Extent1> a, span<T2, Extent2> b, U init, Reduce reduce = Reduce{}, Transform transform = Transform{})
+	{
+		assert(b.size() >= a.size());
+		T1* lhs		 = a.data();
+		T2* rhs		 = b.data();
+		auto project = [&](std::size_t i) { return std::invoke(transform, lhs[i], rhs[i]); };
+		return internal::detail::parallel_reduce_blocks(pol, a.size(), std::move(init), reduce, project);
+	}
+
+	template <class T1, std::size_t Extent1, class T2, std::size_t Extent2, class U, class Reduce = std::plus<>, class Transform = std::multiplies<>>
+	U transform_reduce(span<T1, Extent1> a, span<T2, Extent2> b, U init, Reduce reduce = Reduce{}, Transform transform = Transform{})
+	{
+		return parallel::transform_reduce(policy{}, a, b, std::move(init), std::move(reduce), std::move(transform));
+	}
+
+	// out[i] = in[0] op ... op in[i]. out must hold at least in.size() elements; in and out may be the same range.
+	// Two passes: per-block totals in parallel, a short serial prefix over the totals, then each block rescans
+	// with its offset in parallel. op must be associative.
+	template <class T, std::size_t InExtent, class U, std::size_t OutExtent, class Op = std::plus<>>
+	void inclusive_scan(const policy& pol, span<T, InExtent> in, span<U, OutExtent> out, Op op = Op{})
+	{
+		assert(out.size() >= in.size());
+		const std::size_t n = in.size();
+		if (n == 0) { return; }
+
+		T* src = in.data();
+		U* dst = out.data();
+		const internal::detail::parallel_blocks blocks(pol, n);
+		std::vector<std::optional<U>> carry(blocks.count());
+
+		// Totals of every block but the last; the last one is never needed as an offset.
+		auto totals = [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t k = first; k < last; ++k)
+			{
+				const std::size_t b = blocks.begin(k);
+				const std::size_t e = blocks.end(k);
+				if (b == e || k + 1 == blocks.count()) { continue; }
+
+				U acc = src[b];
+				for (std::size_t i = b + 1; i < e; ++i) { acc = op(std::move(acc), src[i]); }
+				carry[k].emplace(std::move(acc));
+			}
+		};
+		internal::detail::for_chunks(pol, blocks.count(), 1, totals);
+
+		// carry[k] becomes the combined total of blocks [0, k), i.e. the offset of block k.
+		std::optional<U> running;
+		for (auto& c : carry)
+		{
+			std::optional<U> total = std::move(c);
+			c					   = running;
+			if (total) { running = running ? std::optional<U>(op(std::move(*running), std::move(*total))) : std::move(total); }
+		}
+
+		auto rescan = [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t k = first; k < last; ++k)
+			{
+				const std::size_t b = blocks.begin(k);
+				const std::size_t e = blocks.end(k);
+				if (b == e) { continue; }
+
+				U acc  = carry[k] ? op(*carry[k], src[b]) : U(src[b]);
+				dst[b] = acc;
+				for (std::size_t i = b + 1; i < e; ++i)
+				{
+					acc	   = op(std::move(acc), src[i]);
+					dst[i] = acc;
+				}
+			}
+		};
+		internal::detail::for_chunks(pol, blocks.count(), 1, rescan);
+	}
+
+	template <class T, std::size_t InExtent, class U, std::size_t OutExtent, class Op = std::plus<>>
+	void inclusive_scan(span<T, InExtent> in, span<U, OutExtent> out, Op op = Op{})
+	{
+		parallel::inclusive_scan(policy{}, in, out, std::move(op));
+	}
+
+	// Sorts s with comp (not stable). Blocks are sorted in parallel, then merged pairwise in rounds that ping-pong
+	// between s and one scratch buffer of s.size() elements. Every round is cut into pieces of equal output length
+	// whose inputs are found by binary search (co-ranking), so all workers take part in every round, the last one
+	// included. The stop token is checked between rounds; on cancellation s holds a permutation of its input that
+	// may be only partially sorted. If comp or a move of T throws, s is left valid but unspecified.
+	template <class T, std::size_t Extent, class Compare = std::less<>> void sort(const policy& pol, span<T, Extent> s, Compare comp = Compare{})
+	{
+		static_assert(!std::is_const_v<T>, "parallel::sort needs a mutable span");
+
+		T* data				= s.data();
+		const std::size_t n = s.size();
+		const internal::detail::parallel_blocks blocks(pol, n);
+
+		std::vector<std::size_t> bounds(blocks.count() + 1);
+		for (std::size_t k = 0; k < blocks.count(); ++k) { bounds[k] = blocks.begin(k); }
+		bounds[blocks.count()] = n;
+
+		auto sort_blocks = [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t k = first; k < last; ++k) { std::sort(data + bounds[k], data + bounds[k + 1], comp); }
+		};
+		internal::detail::for_chunks(pol, blocks.count(), 1, sort_blocks);
+		if (bounds.size() <= 2) { return; }
+
+		// A round always runs to the end, so each buffer holds either a whole round's output or none of it.
+		policy round_pol		= pol;
+		round_pol.token			= stop_token{};
+		const std::size_t grain = internal::detail::parallel_grain(pol);
+		const std::size_t piece = std::max(grain, n / (internal::detail::parallel_concurrency(pol) * 4) + 1);
+
+		internal::detail::merge_scratch<T> scratch(n);
+		T* src				= data;
+		T* dst				= scratch.data();
+		bool dst_is_raw		= true;
+		auto move_range		= [](T* from, T* to, std::size_t b, std::size_t e) { std::move(from + b, from + e, to + b); };
+		auto destroy_range	= [](T* p, std::size_t b, std::size_t e) { std::destroy(p + b, p + e); };
+		auto destroy_buffer = [&](T* p)
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				auto body = [&](std::size_t b, std::size_t e) { destroy_range(p, b, e); };
+				internal::detail::for_chunks(round_pol, n, grain, body);
+			}
+		};
+
+		struct merge_piece
+		{
+			std::size_t run; // index of the left run in bounds
+			std::size_t begin;
+			std::size_t end;
+		};
+		std::vector<merge_piece> pieces;
+		std::vector<std::size_t> splits; // elements of the left run before each piece
+
+		try
+		{
+			while (bounds.size() > 2)
+			{
+				if (pol.token.stop_requested())
+				{
+					if (src != data)
+					{
+						auto back = [&](std::size_t b, std::size_t e) { move_range(src, data, b, e); };
+						internal::detail::for_chunks(round_pol, n, grain, back);
+					}
+					throw operation_cancelled();
+				}
+
+				const std::size_t runs = bounds.size() - 1;
+				pieces.clear();
+				for (std::size_t k = 0; k < runs; k += 2)
+				{
+					const std::size_t last = bounds[std::min(k + 2, runs)];
+					for (std::size_t b = bounds[k]; b < last; b += piece) { pieces.push_back({ k, b, std::min(b + piece, last) }); }
+				}
+
+				// All split points are found before anything moves: a piece's binary search reads elements that the
+				// neighbouring pieces merge.
+				splits.resize(pieces.size());
+				auto find_splits = [&](std::size_t first, std::size_t last)
+				{
+					for (std::size_t p = first; p < last; ++p)
+					{
+						const merge_piece& m  = pieces[p];
+						const std::size_t a0  = bounds[m.run];
+						const std::size_t mid = bounds[std::min(m.run + 1, runs)];
+						const std::size_t b1  = bounds[std::min(m.run + 2, runs)];
+						splits[p] = internal::detail::merge_corank(m.begin - a0, src + a0, mid - a0, src + mid, b1 - mid, comp);
+					}
+				};
+				internal::detail::for_chunks(round_pol, pieces.size(), 1, find_splits);
+
+				std::vector<unsigned char> built(dst_is_raw ? pieces.size() : 0);
+				auto merge_pieces = [&](std::size_t first, std::size_t last)
+				{
+					for (std::size_t p = first; p < last; ++p)
+					{
+						const merge_piece& m  = pieces[p];
+						const std::size_t a0  = bounds[m.run];
+						const std::size_t mid = bounds[std::min(m.run + 1, runs)];
+						T* a				  = src + a0;
+						T* b				  = src + mid;
+
+						const bool last_of_run = p + 1 == pieces.size() || pieces[p + 1].run != m.run;
+						const std::size_t i0   = splits[p];
+						const std::size_t i1   = last_of_run ? mid - a0 : splits[p + 1];
+						const std::size_t j0   = m.begin - a0 - i0;
+						const std::size_t j1   = m.end - a0 - i1;
+						if (dst_is_raw)
+						{
+							internal::detail::merge_move<true>(a + i0, a + i1, b + j0, b + j1, dst + m.begin, comp);
+							built[p] = 1;
+						}
+						else { internal::detail::merge_move<false>(a + i0, a + i1, b + j0, b + j1, dst + m.begin, comp); }
+					}
+				};
+
+				try
+				{
+					internal::detail::for_chunks(round_pol, pieces.size(), 1, merge_pieces);
+				}
+				catch (...)
+				{
+					// the scratch buffer is only partly built; destroy the pieces that were
+					for (std::size_t p = 0; p < built.size(); ++p)
+					{
+						if (built[p] != 0) { destroy_range(dst, pieces[p].begin, pieces[p].end); }
+					}
+					dst_is_raw = false;
+					throw;
+				}
+
+				dst_is_raw = false;
+				std::swap(src, dst);
+
+				std::vector<std::size_t> merged;
+				merged.reserve(runs / 2 + 2);
+				for (std::size_t k = 0; k < runs; k += 2) { merged.push_back(bounds[k]); }
+				merged.push_back(n);
+				bounds.swap(merged);
+			}
+
+			if (src != data)
+			{
+				auto back = [&](std::size_t b, std::size_t e) { move_range(src, data, b, e); };
+				internal::detail::for_chunks(round_pol, n, grain, back);
+			}
+		}
+		catch (...)
+		{
+			// the first round either built the whole scratch buffer or cleaned up after itself
+			if (!dst_is_raw) { destroy_buffer(scratch.data()); }
+			throw;
+		}
+		destroy_buffer(scratch.data());
+	}
+
+	template <class T, std::size_t Extent, class Compare = std::less<>> void sort(span<T, Extent> s, Compare comp = Compare{})
+	{
+		parallel::sort(policy{}, s, std::move(comp));
+	}
+} // namespace parallel
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_ALGORITHM_PARALLEL_HPP
@@ -0,0 +1,79 @@
+#ifndef SNP_INCLUDE_SNAP_ATOMIC_ATOMIC_FETCH_MAX_HPP
+#define SNP_INCLUDE_SNAP_ATOMIC_ATOMIC_FETCH_MAX_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include <atomic>
+#include <functional> // std::less
+#include <type_traits>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	// Ordering to use for the plain load that starts a CAS loop (loads cannot carry release semantics).
+	constexpr std::memory_order rmw_load_order(std::memory_order order) noexcept
+	{
+		switch (order)
+		{
+		case std::memory_order_consume: [[fallthrough]];
+		case std::memory_order_acquire: [[fallthrough]];
+		case std::memory_order_acq_rel: return std::memory_order_acquire;
+
+		case std::memory_order_seq_cst: return std::memory_order_seq_cst;
+
+		case std::memory_order_relaxed: [[fallthrough]];
+		case std::memory_order_release: [[fallthrough]];
+		default: return std::memory_order_relaxed;
+		}
+	}
+
+	template <class T> struct is_fetch_max_type : std::bool_constant<(std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_pointer_v<T>>
+	{
+	};
+
+	template <class T, class Replace>
+	T atomic_fetch_update_if(std::atomic<T>* obj, T value, std::memory_order order, Replace replace) noexcept
+	{
+		const std::memory_order load_order = rmw_load_order(order);
+
+		T current = obj->load(load_order);
+		while (replace(current, value))
+		{
+			if (obj->compare_exchange_weak(current, value, order, load_order)) { break; }
+		}
+		return current;
+	}
+} // namespace internal::detail
+
+// C++26 atomic_fetch_max / atomic_fetch_min (P0493) for integral and pointer atomics.
+// Implemented as CAS loops that skip the store entirely when the current value already wins,
+// so a saturated maximum costs one load instead of a cache-line write.
+template <class T, std::enable_if_t<internal::detail::is_fetch_max_type<T>::value, int> = 0>
+T atomic_fetch_max_explicit(std::atomic<T>* obj, typename std::atomic<T>::value_type value, std::memory_order order) noexcept
+{
+	return internal::detail::atomic_fetch_update_if(obj, value, order, [](const T& cur, const T& v) { return std::less<T>{}(cur, v); });
+}
+
+template <class T, std::enable_if_t<internal::detail::is_fetch_max_type<T>::value, int> = 0>
+T atomic_fetch_min_explicit(std::atomic<T>* obj, typename std::atomic<T>::value_type value, std::memory_order order) noexcept
+{
+	return internal::detail::atomic_fetch_update_if(obj, value, order, [](const T& cur, const T& v) { return std::less<T>{}(v, cur); });
+}
+
+template <class T, std::enable_if_t<internal::detail::is_fetch_max_type<T>::value, int> = 0>
+T atomic_fetch_max(std::atomic<T>* obj, typename std::atomic<T>::value_type value) noexcept
+{
+	return SNAP_NAMESPACE::atomic_fetch_max_explicit(obj, value, std::memory_order_seq_cst);
+}
+
+template <class T, std::enable_if_t<internal::detail::is_fetch_max_type<T>::value, int> = 0>
+T atomic_fetch_min(std::atomic<T>* obj, typename std::atomic<T>::value_type value) noexcept
+{
+	return SNAP_NAMESPACE::atomic_fetch_min_explicit(obj, value, std::memory_order_seq_cst);
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_ATOMIC_ATOMIC_FETCH_MAX_HPP
@@ -0,0 +1,152 @@
+#ifndef SNP_INCLUDE_SNAP_ATOMIC_SHARDED_COUNTER_HPP
+#define SNP_INCLUDE_SNAP_ATOMIC_SHARDED_COUNTER_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/atomic/atomic_fetch_max.hpp"
+#include "snap/bit/bit_ceil.hpp"
+#include "snap/internal/helpers/cache_line.hpp"
+#include "snap/internal/helpers/this_cpu.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+SNAP_BEGIN_NAMESPACE
+
+// Counter whose increments are striped across cache-line-padded slots chosen by the current CPU.
+// Writers on different cores touch different lines, so hot-path updates stay core-local.
+// load() sums every slot; it is exact once writers are quiescent and otherwise a consistent-enough snapshot
+// for metrics (each slot is read atomically, but the slots are not read at one instant).
+//
+// update_max()/update_min() keep a per-slot extremum instead of a sum and pair with load_max()/load_min().
+// Slots start at 0, which only suits sums; construct an extremum counter with the identity of its operation
+// (numeric_limits<T>::lowest() for max, numeric_limits<T>::max() for min). Do not mix additive and extremum updates
+// on the same counter.
+template <class T> class sharded_counter
+{
+	static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "sharded_counter requires an integral type");
+
+	struct alignas(internal::cache_line_size) slot
+	{
+		std::atomic<T> value{ 0 };
+	};
+
+public:
+	using value_type = T;
+
+	// One slot per hardware thread, rounded up to a power of two so slot selection is a mask.
+	sharded_counter() : sharded_counter(default_shard_count()) {}
+
+	explicit sharded_counter(std::size_t shard_count)
+		: mask_(SNAP_NAMESPACE::bit_ceil(shard_count == 0 ? std::size_t{ 1 } : shard_count) - 1), slots_(std::make_unique<slot[]>(mask_ + 1))
+	{
+	}
+
+	// Every slot starts at `initial`, e.g. sharded_counter<int>(n, std::numeric_limits<int>::max()) for update_min().
+	sharded_counter(std::size_t shard_count, T initial) : sharded_counter(shard_count) { reset(initial); }
+
+	sharded_counter(const sharded_counter&)			   = delete;
+	sharded_counter& operator=(const sharded_counter&) = delete;
+	sharded_counter(sharded_counter&&) noexcept		   = default;
+	sharded_counter& operator=(sharded_counter&&)	   = default;
+	~sharded_counter()								   = default;
+
+	void add(T delta, std::memory_order order = std::memory_order_relaxed) noexcept { local_slot().value.fetch_add(delta, order); }
+	void sub(T delta, std::memory_order order = std::memory_order_relaxed) noexcept { local_slot().value.fetch_sub(delta, order); }
+
+	sharded_counter& operator++() noexcept
+	{
+		add(T{ 1 });
+		return *this;
+	}
+
+	sharded_counter& operator--() noexcept
+	{
+		sub(T{ 1 });
+		return *this;
+	}
+
+	sharded_counter& operator+=(T delta) noexcept
+	{
+		add(delta);
+		return *this;
+	}
+
+	sharded_counter& operator-=(T delta) noexcept
+	{
+		sub(delta);
+		return *this;
+	}
+
+	[[nodiscard]] T load(std::memory_order order = std::memory_order_relaxed) const noexcept
+	{
+		T sum = 0;
+		for (std::size_t i = 0; i <= mask_; ++i) { sum = static_cast<T>(sum + slots_[i].value.load(order)); }
+		return sum;
+	}
+
+	// Returns the previous value of the slot that was updated, like atomic::fetch_max. Slots that never saw an update
+	// still hold their starting value, so the counter must start at numeric_limits<T>::lowest() (see the constructor
+	// and reset()) for load_max() to be right; likewise numeric_limits<T>::max() for update_min()/load_min().
+	T update_max(T value, std::memory_order order = std::memory_order_relaxed) noexcept
+	{
+		return SNAP_NAMESPACE::atomic_fetch_max_explicit(&local_slot().value, value, order);
+	}
+
+	T update_min(T value, std::memory_order order = std::memory_order_relaxed) noexcept
+	{
+		return SNAP_NAMESPACE::atomic_fetch_min_explicit(&local_slot().value, value, order);
+	}
+
+	[[nodiscard]] T load_max(std::memory_order order = std::memory_order_relaxed) const noexcept
+	{
+		T best = std::numeric_limits<T>::lowest();
+		for (std::size_t i = 0; i <= mask_; ++i)
+		{
+			const T v = slots_[i].value.load(order);
+			if (best < v) { best = v; }
+		}
+		return best;
+	}
+
+	[[nodiscard]] T load_min(std::memory_order order = std::memory_order_relaxed) const noexcept
+	{
+		T best = std::numeric_limits<T>::max();
+		for (std::size_t i = 0; i <= mask_; ++i)
+		{
+			const T v = slots_[i].value.load(order);
+			if (v < best) { best = v; }
+		}
+		return best;
+	}
+
+	// Sets every slot to `value` (0 for sums, the identity of the extremum otherwise).
+	// Not atomic with respect to concurrent updates.
+	void reset(T value = 0, std::memory_order order = std::memory_order_relaxed) noexcept
+	{
+		for (std::size_t i = 0; i <= mask_; ++i) { slots_[i].value.store(value, order); }
+	}
+
+	[[nodiscard]] std::size_t shard_count() const noexcept { return mask_ + 1; }
+
+	[[nodiscard]] static std::size_t default_shard_count() noexcept
+	{
+		const unsigned hw = std::thread::hardware_concurrency();
+		return SNAP_NAMESPACE::bit_ceil(static_cast<std::size_t>(hw == 0 ? 1u : hw));
+	}
+
+private:
+	slot& local_slot() noexcept { return slots_[static_cast<std::size_t>(internal::detail::this_cpu_hint()) & mask_]; }
+
+	std::size_t mask_;
+	std::unique_ptr<slot[]> slots_;
+};
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_ATOMIC_SHARDED_COUNTER_HPP
@@ -0,0 +1,18 @@
+// snap/execution.hpp
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/execution/core.hpp"
+#include "snap/execution/just.hpp"
+#include "snap/execution/let_value.hpp"
+#include "snap/execution/pool_scheduler.hpp"
+#include "snap/execution/run_loop.hpp"
+#include "snap/execution/sync_wait.hpp"
+#include "snap/execution/then.hpp"
+#include "snap/execution/transfer.hpp"
+#include "snap/execution/when_all.hpp"
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_HPP
@@ -0,0 +1,184 @@
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_CORE_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_CORE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/meta/detector.hpp"
+#include "snap/meta/type_list.hpp"
+#include "snap/stop_token/inplace_stop_token.hpp"
+#include "snap/stop_token/stop_callback.hpp"
+#include "snap/stop_token/stop_source.hpp"
+#include "snap/type_traits/remove_cvref.hpp"
+
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+// A C++17 subset of the std::execution sender/receiver model.
+//
+// The protocol is member-function based rather than tag_invoke based:
+//   - a receiver has `set_value(Vs...) && noexcept`, `set_error(E) && noexcept`, `set_stopped() && noexcept`
+//     and optionally `get_env() const noexcept`;
+//   - a sender has `connect(Receiver) &&` (and `const&` when copyable), a `value_types` type_list naming its
+//     single value completion, and a `static constexpr bool sends_stopped`;
+//   - an operation state has `start() & noexcept` and is neither copyable nor movable.
+// The error channel always carries std::exception_ptr. Operation states are built in place through guaranteed
+// copy elision and nest by value, so a connected pipeline is one object with no allocation and no type erasure.
+namespace execution
+{
+	// Token of an environment that never asks for stop.
+	struct never_stop_token
+	{
+		[[nodiscard]] static constexpr bool stop_requested() noexcept { return false; }
+		[[nodiscard]] static constexpr bool stop_possible() noexcept { return false; }
+	};
+
+	// Maps a stop token type to its callback type.
+	template <class Token, class Callback> struct stop_callback_for;
+
+	template <class Callback> struct stop_callback_for<never_stop_token, Callback>
+	{
+		struct type
+		{
+			template <class C> explicit type(never_stop_token, C&&) noexcept {}
+		};
+	};
+
+	template <class Callback> struct stop_callback_for<stop_token, Callback>
+	{
+		using type = stop_callback<Callback>;
+	};
+
+	template <class Callback> struct stop_callback_for<inplace_stop_token, Callback>
+	{
+		using type = inplace_stop_callback<Callback>;
+	};
+
+	template <class Token, class Callback> using stop_callback_for_t = typename stop_callback_for<Token, Callback>::type;
+
+	struct empty_env
+	{
+	};
+
+	// Environment exposing a stop token to the operations below it.
+	template <class Token> struct stop_token_env
+	{
+		Token token;
+
+		[[nodiscard]] Token get_stop_token() const noexcept { return token; }
+	};
+
+	namespace detail
+	{
+		template <class T> using member_get_env_t		 = decltype(std::declval<const T&>().get_env());
+		template <class T> using member_get_stop_token_t = decltype(std::declval<const T&>().get_stop_token());
+		template <class T> using member_get_scheduler_t	 = decltype(std::declval<const T&>().get_scheduler());
+	} // namespace detail
+
+	template <class Receiver> decltype(auto) get_env(const Receiver& rcvr) noexcept
+	{
+		if constexpr (is_detected_v<detail::member_get_env_t, Receiver>) { return rcvr.get_env(); }
+		else { return empty_env{}; }
+	}
+
+	template <class Env> auto get_stop_token(const Env& env) noexcept
+	{
+		if constexpr (is_detected_v<detail::member_get_stop_token_t, Env>) { return env.get_stop_token(); }
+		else { return never_stop_token{}; }
+	}
+
+	template <class Receiver> using env_of_t		= remove_cvref_t<decltype(execution::get_env(std::declval<const Receiver&>()))>;
+	template <class Env> using stop_token_of_t		= decltype(execution::get_stop_token(std::declval<const Env&>()));
+	template <class Receiver> using receiver_token_t = stop_token_of_t<env_of_t<Receiver>>;
+
+	template <class Receiver, class... Vs> void set_value(Receiver&& rcvr, Vs&&... vs) noexcept
+	{
+		std::forward<Receiver>(rcvr).set_value(std::forward<Vs>(vs)...);
+	}
+
+	template <class Receiver, class E> void set_error(Receiver&& rcvr, E&& e) noexcept
+	{
+		std::forward<Receiver>(rcvr).set_error(std::forward<E>(e));
+	}
+
+	template <class Receiver> void set_stopped(Receiver&& rcvr) noexcept
+	{
+		std::forward<Receiver>(rcvr).set_stopped();
+	}
+
+	template <class Sender, class Receiver> auto connect(Sender&& sndr, Receiver&& rcvr) -> decltype(std::forward<Sender>(sndr).connect(std::forward<Receiver>(rcvr)))
+	{
+		return std::forward<Sender>(sndr).connect(std::forward<Receiver>(rcvr));
+	}
+
+	template <class OperationState> void start(OperationState& op) noexcept
+	{
+		op.start();
+	}
+
+	template <class Scheduler> auto schedule(const Scheduler& sched) -> decltype(sched.schedule())
+	{
+		return sched.schedule();
+	}
+
+	template <class Sender, class Receiver> using connect_result_t = decltype(execution::connect(std::declval<Sender>(), std::declval<Receiver>()));
+	template <class Scheduler> using schedule_result_t			   = decltype(execution::schedule(std::declval<const Scheduler&>()));
+
+	// Values of the sender's value completion, as a type_list.
+	template <class Sender> using value_types_of_t			  = typename remove_cvref_t<Sender>::value_types;
+	template <class Sender> inline constexpr bool sends_stopped_v = remove_cvref_t<Sender>::sends_stopped;
+
+	// Pipeable adaptor closures: `sndr | then(f)` is `then(sndr, f)`.
+	template <class Derived> struct sender_adaptor_closure
+	{
+	};
+
+	template <class Sender, class Closure, std::enable_if_t<std::is_base_of_v<sender_adaptor_closure<remove_cvref_t<Closure>>, remove_cvref_t<Closure>>, int> = 0>
+	decltype(auto) operator|(Sender&& sndr, Closure&& closure)
+	{
+		return std::forward<Closure>(closure)(std::forward<Sender>(sndr));
+	}
+
+	namespace detail
+	{
+		template <class List> using decayed_tuple_t = typelist::to_tuple_t<typelist::transform_t<List, std::decay_t>>;
+
+		template <class E> std::exception_ptr as_exception_ptr(E&& e) noexcept
+		{
+			if constexpr (std::is_same_v<remove_cvref_t<E>, std::exception_ptr>) { return std::forward<E>(e); }
+			else { return std::make_exception_ptr(std::forward<E>(e)); }
+		}
+
+		// Holds an operation state constructed from a callable's prvalue result, so optional<> and aggregates of
+		// immovable operation states can be built in place.
+		struct from_fn_t
+		{
+		};
+		inline constexpr from_fn_t from_fn{};
+
+		template <class Op> struct op_box
+		{
+			template <class Fn> op_box(from_fn_t, Fn&& fn) : op(std::forward<Fn>(fn)()) {}
+
+			op_box(const op_box&)			 = delete;
+			op_box& operator=(const op_box&) = delete;
+
+			Op op;
+		};
+
+		// Forwards a stop request from one source to another (e.g. the parent's token to a child source).
+		struct forward_stop
+		{
+			inplace_stop_source* target;
+
+			void operator()() const noexcept { target->request_stop(); }
+		};
+	} // namespace detail
+} // namespace execution
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_CORE_HPP
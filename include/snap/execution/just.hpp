@@ -0,0 +1,77 @@
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_JUST_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_JUST_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/execution/core.hpp"
+
+#include <exception>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace execution
+{
+	namespace detail
+	{
+		template <class Receiver, class... Vs> class just_op
+		{
+		public:
+			template <class Tuple> just_op(Tuple&& values, Receiver rcvr) : values_(std::forward<Tuple>(values)), rcvr_(std::move(rcvr)) {}
+
+			just_op(const just_op&)			   = delete;
+			just_op& operator=(const just_op&) = delete;
+
+			void start() & noexcept
+			{
+				try
+				{
+					std::apply([this](Vs&... vs) { execution::set_value(std::move(rcvr_), std::move(vs)...); }, values_);
+				}
+				catch (...)
+				{
+					execution::set_error(std::move(rcvr_), std::current_exception());
+				}
+			}
+
+		private:
+			std::tuple<Vs...> values_;
+			Receiver rcvr_;
+		};
+	} // namespace detail
+
+	// Completes synchronously with the stored values.
+	template <class... Vs> class just_sender
+	{
+	public:
+		using value_types						= type_list<Vs...>;
+		static constexpr bool sends_stopped = false;
+
+		template <class... Us> explicit just_sender(std::in_place_t, Us&&... us) : values_(std::forward<Us>(us)...) {}
+
+		template <class Receiver> detail::just_op<Receiver, Vs...> connect(Receiver rcvr) &&
+		{
+			return detail::just_op<Receiver, Vs...>(std::move(values_), std::move(rcvr));
+		}
+
+		template <class Receiver> detail::just_op<Receiver, Vs...> connect(Receiver rcvr) const&
+		{
+			return detail::just_op<Receiver, Vs...>(values_, std::move(rcvr));
+		}
+
+	private:
+		std::tuple<Vs...> values_;
+	};
+
+	template <class... Vs> just_sender<std::decay_t<Vs>...> just(Vs&&... vs)
+	{
+		return just_sender<std::decay_t<Vs>...>(std::in_place, std::forward<Vs>(vs)...);
+	}
+} // namespace execution
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_JUST_HPP
@@ -0,0 +1,132 @@
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_LET_VALUE_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_LET_VALUE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/execution/core.hpp"
+
+#include <exception>
+#include <functional> // std::invoke
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace execution
+{
+	namespace detail
+	{
+		template <class F, class List> struct let_value_next;
+
+		template <class F, class... Vs> struct let_value_next<F, type_list<Vs...>>
+		{
+			using type = remove_cvref_t<std::invoke_result_t<F&, std::decay_t<Vs>&...>>;
+		};
+
+		template <class F, class List> using let_value_next_t = typename let_value_next<F, List>::type;
+
+		// Runs the child, keeps its values alive in the operation state, then connects and starts the sender
+		// returned by f(values&...) in place.
+		template <class Sender, class Receiver, class F> class let_value_op
+		{
+			using values_t = decayed_tuple_t<value_types_of_t<Sender>>;
+			using next_t   = let_value_next_t<F, value_types_of_t<Sender>>;
+
+			struct receiver
+			{
+				let_value_op* op;
+
+				template <class... Vs> void set_value(Vs&&... vs) && noexcept { op->on_value(std::forward<Vs>(vs)...); }
+
+				template <class E> void set_error(E&& e) && noexcept { execution::set_error(std::move(op->rcvr_), std::forward<E>(e)); }
+
+				void set_stopped() && noexcept { execution::set_stopped(std::move(op->rcvr_)); }
+
+				[[nodiscard]] decltype(auto) get_env() const noexcept { return execution::get_env(op->rcvr_); }
+			};
+
+		public:
+			let_value_op(Sender&& sndr, Receiver rcvr, F fn)
+				: rcvr_(std::move(rcvr)), fn_(std::move(fn)), first_(execution::connect(std::forward<Sender>(sndr), receiver{ this }))
+			{
+			}
+
+			let_value_op(const let_value_op&)			 = delete;
+			let_value_op& operator=(const let_value_op&) = delete;
+
+			void start() & noexcept { execution::start(first_); }
+
+		private:
+			template <class... Vs> void on_value(Vs&&... vs) noexcept
+			{
+				try
+				{
+					values_.emplace(std::forward<Vs>(vs)...);
+					next_.emplace(from_fn,
+								  [this] { return execution::connect(std::apply([this](auto&... v) { return std::invoke(fn_, v...); }, *values_), std::move(rcvr_)); });
+				}
+				catch (...)
+				{
+					execution::set_error(std::move(rcvr_), std::current_exception());
+					return;
+				}
+				execution::start(next_->op);
+			}
+
+			Receiver rcvr_;
+			F fn_;
+			connect_result_t<Sender, receiver> first_;
+			std::optional<values_t> values_;
+			std::optional<op_box<connect_result_t<next_t, Receiver>>> next_;
+		};
+	} // namespace detail
+
+	// Completes like the sender returned by f(values&...). The child's values stay alive until that sender
+	// completes, so f may hand out references to them.
+	template <class Sender, class F> class let_value_sender
+	{
+		using next_t = detail::let_value_next_t<F, value_types_of_t<Sender>>;
+
+	public:
+		using value_types						= value_types_of_t<next_t>;
+		static constexpr bool sends_stopped = sends_stopped_v<Sender> || sends_stopped_v<next_t>;
+
+		let_value_sender(Sender sndr, F fn) : sndr_(std::move(sndr)), fn_(std::move(fn)) {}
+
+		template <class Receiver> detail::let_value_op<Sender, Receiver, F> connect(Receiver rcvr) &&
+		{
+			return { std::move(sndr_), std::move(rcvr), std::move(fn_) };
+		}
+
+	private:
+		Sender sndr_;
+		F fn_;
+	};
+
+	template <class F> struct let_value_closure : sender_adaptor_closure<let_value_closure<F>>
+	{
+		F fn;
+
+		template <class Sender> let_value_sender<remove_cvref_t<Sender>, F> operator()(Sender&& sndr) &&
+		{
+			return { std::forward<Sender>(sndr), std::move(fn) };
+		}
+	};
+
+	template <class Sender, class F> let_value_sender<remove_cvref_t<Sender>, std::decay_t<F>> let_value(Sender&& sndr, F&& fn)
+	{
+		return { std::forward<Sender>(sndr), std::forward<F>(fn) };
+	}
+
+	template <class F> let_value_closure<std::decay_t<F>> let_value(F&& fn)
+	{
+		return { {}, std::forward<F>(fn) };
+	}
+} // namespace execution
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_LET_VALUE_HPP
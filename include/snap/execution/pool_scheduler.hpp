@@ -0,0 +1,89 @@
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_POOL_SCHEDULER_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_POOL_SCHEDULER_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/execution/core.hpp"
+#include "snap/thread/thread_pool.hpp"
+
+#include <exception>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace execution
+{
+	namespace detail
+	{
+		// The operation state is itself the pool's task node, so scheduling onto the pool does not allocate.
+		template <class Receiver> class pool_schedule_op : internal::pool_task
+		{
+		public:
+			pool_schedule_op(thread_pool* pool, Receiver rcvr) : internal::pool_task(&pool_schedule_op::run_impl, &pool_schedule_op::destroy_impl), pool_(pool), rcvr_(std::move(rcvr))
+			{
+			}
+
+			pool_schedule_op(const pool_schedule_op&)			 = delete;
+			pool_schedule_op& operator=(const pool_schedule_op&) = delete;
+
+			void start() & noexcept
+			{
+				try
+				{
+					internal::pool_access::enqueue(*pool_, this);
+				}
+				catch (...)
+				{
+					execution::set_error(std::move(rcvr_), std::current_exception());
+				}
+			}
+
+		private:
+			static void run_impl(internal::pool_task* base, const stop_token&) noexcept
+			{
+				auto* self = static_cast<pool_schedule_op*>(base);
+				if (execution::get_stop_token(execution::get_env(self->rcvr_)).stop_requested()) { execution::set_stopped(std::move(self->rcvr_)); }
+				else { execution::set_value(std::move(self->rcvr_)); }
+			}
+
+			static void destroy_impl(internal::pool_task*) noexcept {}
+
+			thread_pool* pool_;
+			Receiver rcvr_;
+		};
+	} // namespace detail
+
+	// Scheduler that completes on a worker of a thread_pool.
+	class pool_scheduler
+	{
+		class schedule_sender
+		{
+		public:
+			using value_types						= type_list<>;
+			static constexpr bool sends_stopped = true;
+
+			explicit schedule_sender(thread_pool* pool) noexcept : pool_(pool) {}
+
+			template <class Receiver> detail::pool_schedule_op<Receiver> connect(Receiver rcvr) const { return { pool_, std::move(rcvr) }; }
+
+		private:
+			thread_pool* pool_;
+		};
+
+	public:
+		explicit pool_scheduler(thread_pool& pool) noexcept : pool_(&pool) {}
+
+		[[nodiscard]] schedule_sender schedule() const noexcept { return schedule_sender(pool_); }
+
+		friend bool operator==(const pool_scheduler& lhs, const pool_scheduler& rhs) noexcept { return lhs.pool_ == rhs.pool_; }
+		friend bool operator!=(const pool_scheduler& lhs, const pool_scheduler& rhs) noexcept { return lhs.pool_ != rhs.pool_; }
+
+	private:
+		thread_pool* pool_;
+	};
+} // namespace execution
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_POOL_SCHEDULER_HPP
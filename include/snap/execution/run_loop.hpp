@@ -0,0 +1,137 @@
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_RUN_LOOP_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_RUN_LOOP_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/execution/core.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace execution
+{
+	// FIFO of work driven by whichever thread calls run(). Scheduled operations queue themselves intrusively, so
+	// scheduling onto a run_loop never allocates.
+	class run_loop
+	{
+		struct task
+		{
+			using execute_fn = void (*)(task*) noexcept;
+
+			explicit task(execute_fn fn) noexcept : execute(fn) {}
+
+			task* next = nullptr;
+			execute_fn execute;
+		};
+
+		template <class Receiver> class schedule_op : task
+		{
+		public:
+			schedule_op(run_loop* loop, Receiver rcvr) : task(&schedule_op::execute_impl), loop_(loop), rcvr_(std::move(rcvr)) {}
+
+			schedule_op(const schedule_op&)			   = delete;
+			schedule_op& operator=(const schedule_op&) = delete;
+
+			void start() & noexcept { loop_->push_back(this); }
+
+		private:
+			static void execute_impl(task* base) noexcept
+			{
+				auto* self = static_cast<schedule_op*>(base);
+				if (execution::get_stop_token(execution::get_env(self->rcvr_)).stop_requested()) { execution::set_stopped(std::move(self->rcvr_)); }
+				else { execution::set_value(std::move(self->rcvr_)); }
+			}
+
+			run_loop* loop_;
+			Receiver rcvr_;
+		};
+
+		class schedule_sender
+		{
+		public:
+			using value_types						= type_list<>;
+			static constexpr bool sends_stopped = true;
+
+			explicit schedule_sender(run_loop* loop) noexcept : loop_(loop) {}
+
+			template <class Receiver> schedule_op<Receiver> connect(Receiver rcvr) const { return { loop_, std::move(rcvr) }; }
+
+		private:
+			run_loop* loop_;
+		};
+
+	public:
+		class scheduler
+		{
+		public:
+			explicit scheduler(run_loop* loop) noexcept : loop_(loop) {}
+
+			[[nodiscard]] schedule_sender schedule() const noexcept { return schedule_sender(loop_); }
+
+			friend bool operator==(const scheduler& lhs, const scheduler& rhs) noexcept { return lhs.loop_ == rhs.loop_; }
+			friend bool operator!=(const scheduler& lhs, const scheduler& rhs) noexcept { return lhs.loop_ != rhs.loop_; }
+
+		private:
+			run_loop* loop_;
+		};
+
+		run_loop() noexcept = default;
+
+		run_loop(const run_loop&)			 = delete;
+		run_loop& operator=(const run_loop&) = delete;
+
+		[[nodiscard]] scheduler get_scheduler() noexcept { return scheduler(this); }
+
+		// Runs queued work until finish() has been called and the queue is empty.
+		void run() noexcept
+		{
+			while (task* t = pop_front()) { t->execute(t); }
+		}
+
+		// Makes run() return once the queue drains. Work scheduled afterwards still runs if run() has not returned.
+		void finish() noexcept
+		{
+			const std::lock_guard<std::mutex> lock(mutex_);
+			finishing_ = true;
+			cv_.notify_all();
+		}
+
+	private:
+		void push_back(task* t) noexcept
+		{
+			const std::lock_guard<std::mutex> lock(mutex_);
+			if (tail_ != nullptr) { tail_->next = t; }
+			else { head_ = t; }
+			tail_ = t;
+			cv_.notify_one();
+		}
+
+		task* pop_front() noexcept
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cv_.wait(lock, [this] { return head_ != nullptr || finishing_; });
+			task* t = head_;
+			if (t != nullptr)
+			{
+				head_ = t->next;
+				if (head_ == nullptr) { tail_ = nullptr; }
+				t->next = nullptr;
+			}
+			return t;
+		}
+
+		std::mutex mutex_;
+		std::condition_variable cv_;
+		task* head_		= nullptr;
+		task* tail_		= nullptr;
+		bool finishing_ = false;
+	};
+} // namespace execution
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_RUN_LOOP_HPP
@@ -0,0 +1,83 @@
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_SYNC_WAIT_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_SYNC_WAIT_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/execution/core.hpp"
+#include "snap/execution/run_loop.hpp"
+
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace execution
+{
+	namespace detail
+	{
+		template <class Values> struct sync_wait_state
+		{
+			run_loop loop;
+			std::optional<Values> values;
+			std::exception_ptr error;
+		};
+
+		struct sync_wait_env
+		{
+			run_loop* loop;
+
+			[[nodiscard]] run_loop::scheduler get_scheduler() const noexcept { return loop->get_scheduler(); }
+		};
+
+		template <class Values> struct sync_wait_receiver
+		{
+			sync_wait_state<Values>* state;
+
+			template <class... Vs> void set_value(Vs&&... vs) && noexcept
+			{
+				try
+				{
+					state->values.emplace(std::forward<Vs>(vs)...);
+				}
+				catch (...)
+				{
+					state->error = std::current_exception();
+				}
+				state->loop.finish();
+			}
+
+			template <class E> void set_error(E&& e) && noexcept
+			{
+				state->error = as_exception_ptr(std::forward<E>(e));
+				state->loop.finish();
+			}
+
+			void set_stopped() && noexcept { state->loop.finish(); }
+
+			[[nodiscard]] sync_wait_env get_env() const noexcept { return { &state->loop }; }
+		};
+	} // namespace detail
+
+	// Runs `sndr` to completion on the calling thread, which drives a run_loop meanwhile (the loop's scheduler is
+	// available to children through get_scheduler() on the environment). Returns the values, std::nullopt if the
+	// sender stopped, and rethrows its error.
+	template <class Sender> std::optional<detail::decayed_tuple_t<value_types_of_t<Sender>>> sync_wait(Sender&& sndr)
+	{
+		using values_t = detail::decayed_tuple_t<value_types_of_t<Sender>>;
+
+		detail::sync_wait_state<values_t> state;
+		auto op = execution::connect(std::forward<Sender>(sndr), detail::sync_wait_receiver<values_t>{ &state });
+		execution::start(op);
+		state.loop.run();
+
+		if (state.error) { std::rethrow_exception(state.error); }
+		return std::move(state.values);
+	}
+} // namespace execution
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_SYNC_WAIT_HPP
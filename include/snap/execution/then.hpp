@@ -0,0 +1,111 @@
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_THEN_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_THEN_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/execution/core.hpp"
+
+#include <exception>
+#include <functional> // std::invoke
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace execution
+{
+	namespace detail
+	{
+		template <class F, class List> struct then_result;
+
+		template <class F, class... Vs> struct then_result<F, type_list<Vs...>>
+		{
+			using result = std::invoke_result_t<F, Vs...>;
+			using type	 = std::conditional_t<std::is_void_v<result>, type_list<>, type_list<std::decay_t<result>>>;
+		};
+
+		template <class Receiver, class F> struct then_receiver
+		{
+			Receiver rcvr;
+			F fn;
+
+			template <class... Vs> void set_value(Vs&&... vs) && noexcept
+			{
+				try
+				{
+					if constexpr (std::is_void_v<std::invoke_result_t<F, Vs...>>)
+					{
+						std::invoke(std::move(fn), std::forward<Vs>(vs)...);
+						execution::set_value(std::move(rcvr));
+					}
+					else { execution::set_value(std::move(rcvr), std::invoke(std::move(fn), std::forward<Vs>(vs)...)); }
+				}
+				catch (...)
+				{
+					execution::set_error(std::move(rcvr), std::current_exception());
+				}
+			}
+
+			template <class E> void set_error(E&& e) && noexcept { execution::set_error(std::move(rcvr), std::forward<E>(e)); }
+
+			void set_stopped() && noexcept { execution::set_stopped(std::move(rcvr)); }
+
+			[[nodiscard]] decltype(auto) get_env() const noexcept { return execution::get_env(rcvr); }
+		};
+	} // namespace detail
+
+	// Completes with f(values...) of the child, or with f's exception as an error.
+	// Connecting forwards straight to the child, so `then` adds no operation state of its own.
+	template <class Sender, class F> class then_sender
+	{
+	public:
+		using value_types						= typename detail::then_result<F, value_types_of_t<Sender>>::type;
+		static constexpr bool sends_stopped = sends_stopped_v<Sender>;
+
+		then_sender(Sender sndr, F fn) : sndr_(std::move(sndr)), fn_(std::move(fn)) {}
+
+		template <class Receiver> auto connect(Receiver rcvr) &&
+		{
+			return execution::connect(std::move(sndr_), detail::then_receiver<Receiver, F>{ std::move(rcvr), std::move(fn_) });
+		}
+
+		template <class Receiver> auto connect(Receiver rcvr) const&
+		{
+			return execution::connect(sndr_, detail::then_receiver<Receiver, F>{ std::move(rcvr), fn_ });
+		}
+
+	private:
+		Sender sndr_;
+		F fn_;
+	};
+
+	template <class F> struct then_closure : sender_adaptor_closure<then_closure<F>>
+	{
+		F fn;
+
+		template <class Sender> then_sender<remove_cvref_t<Sender>, F> operator()(Sender&& sndr) &&
+		{
+			return { std::forward<Sender>(sndr), std::move(fn) };
+		}
+
+		template <class Sender> then_sender<remove_cvref_t<Sender>, F> operator()(Sender&& sndr) const&
+		{
+			return { std::forward<Sender>(sndr), fn };
+		}
+	};
+
+	template <class Sender, class F> then_sender<remove_cvref_t<Sender>, std::decay_t<F>> then(Sender&& sndr, F&& fn)
+	{
+		return { std::forward<Sender>(sndr), std::forward<F>(fn) };
+	}
+
+	template <class F> then_closure<std::decay_t<F>> then(F&& fn)
+	{
+		return { {}, std::forward<F>(fn) };
+	}
+} // namespace execution
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_THEN_HPP
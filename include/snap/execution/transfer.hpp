@@ -0,0 +1,129 @@
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_TRANSFER_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_TRANSFER_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/execution/core.hpp"
+
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace execution
+{
+	namespace detail
+	{
+		// Both operation states are connected up front; the schedule operation is started once the child has
+		// produced its values, and delivers them from the scheduler's execution context.
+		template <class Sender, class Scheduler, class Receiver> class transfer_op
+		{
+			using values_t = decayed_tuple_t<value_types_of_t<Sender>>;
+
+			struct receiver_base
+			{
+				transfer_op* op;
+
+				template <class E> void set_error(E&& e) && noexcept { execution::set_error(std::move(op->rcvr_), std::forward<E>(e)); }
+
+				void set_stopped() && noexcept { execution::set_stopped(std::move(op->rcvr_)); }
+
+				[[nodiscard]] decltype(auto) get_env() const noexcept { return execution::get_env(op->rcvr_); }
+			};
+
+			struct value_receiver : receiver_base
+			{
+				template <class... Vs> void set_value(Vs&&... vs) && noexcept
+				{
+					transfer_op* self = this->op;
+					try
+					{
+						self->values_.emplace(std::forward<Vs>(vs)...);
+					}
+					catch (...)
+					{
+						execution::set_error(std::move(self->rcvr_), std::current_exception());
+						return;
+					}
+					execution::start(self->hop_);
+				}
+			};
+
+			struct hop_receiver : receiver_base
+			{
+				void set_value() && noexcept
+				{
+					transfer_op* self = this->op;
+					std::apply([self](auto&... v) { execution::set_value(std::move(self->rcvr_), std::move(v)...); }, *self->values_);
+				}
+			};
+
+		public:
+			transfer_op(Sender&& sndr, const Scheduler& sched, Receiver rcvr)
+				: rcvr_(std::move(rcvr)),
+				  first_(execution::connect(std::forward<Sender>(sndr), value_receiver{ { this } })),
+				  hop_(execution::connect(execution::schedule(sched), hop_receiver{ { this } }))
+			{
+			}
+
+			transfer_op(const transfer_op&)			   = delete;
+			transfer_op& operator=(const transfer_op&) = delete;
+
+			void start() & noexcept { execution::start(first_); }
+
+		private:
+			Receiver rcvr_;
+			std::optional<values_t> values_;
+			connect_result_t<Sender, value_receiver> first_;
+			connect_result_t<schedule_result_t<Scheduler>, hop_receiver> hop_;
+		};
+	} // namespace detail
+
+	// Completes with the child's values on `sched`'s execution context. Errors and stops from the child are
+	// forwarded where they happen without a hop.
+	template <class Sender, class Scheduler> class transfer_sender
+	{
+	public:
+		using value_types						= value_types_of_t<Sender>;
+		static constexpr bool sends_stopped = sends_stopped_v<Sender> || sends_stopped_v<schedule_result_t<Scheduler>>;
+
+		transfer_sender(Sender sndr, Scheduler sched) : sndr_(std::move(sndr)), sched_(std::move(sched)) {}
+
+		template <class Receiver> detail::transfer_op<Sender, Scheduler, Receiver> connect(Receiver rcvr) &&
+		{
+			return { std::move(sndr_), sched_, std::move(rcvr) };
+		}
+
+	private:
+		Sender sndr_;
+		Scheduler sched_;
+	};
+
+	template <class Scheduler> struct transfer_closure : sender_adaptor_closure<transfer_closure<Scheduler>>
+	{
+		Scheduler sched;
+
+		template <class Sender> transfer_sender<remove_cvref_t<Sender>, Scheduler> operator()(Sender&& sndr) const
+		{
+			return { std::forward<Sender>(sndr), sched };
+		}
+	};
+
+	template <class Sender, class Scheduler> transfer_sender<remove_cvref_t<Sender>, remove_cvref_t<Scheduler>> transfer(Sender&& sndr, Scheduler&& sched)
+	{
+		return { std::forward<Sender>(sndr), std::forward<Scheduler>(sched) };
+	}
+
+	template <class Scheduler> transfer_closure<remove_cvref_t<Scheduler>> transfer(Scheduler&& sched)
+	{
+		return { {}, std::forward<Scheduler>(sched) };
+	}
+} // namespace execution
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_TRANSFER_HPP
@@ -0,0 +1,198 @@
+#ifndef SNP_INCLUDE_SNAP_EXECUTION_WHEN_ALL_HPP
+#define SNP_INCLUDE_SNAP_EXECUTION_WHEN_ALL_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/execution/core.hpp"
+#include "snap/stop_token/inplace_stop_token.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace execution
+{
+	namespace detail
+	{
+		template <std::size_t I, class Op> struct when_all_child : op_box<Op>
+		{
+			using op_box<Op>::op_box;
+		};
+
+		template <class Indices, class... Ops> struct when_all_children;
+
+		template <std::size_t... Is, class... Ops> struct when_all_children<std::index_sequence<Is...>, Ops...> : when_all_child<Is, Ops>...
+		{
+			template <class... Fns> explicit when_all_children(Fns&&... fns) : when_all_child<Is, Ops>(from_fn, std::forward<Fns>(fns))... {}
+
+			void start_all() noexcept { (execution::start(static_cast<when_all_child<Is, Ops>&>(*this).op), ...); }
+		};
+
+		template <class Receiver, class... Senders> class when_all_op
+		{
+			using indices = std::index_sequence_for<Senders...>;
+
+			enum : int
+			{
+				running,
+				failed,
+				stopped
+			};
+
+			using parent_token_t = receiver_token_t<Receiver>;
+			using on_stop_t		 = stop_callback_for_t<parent_token_t, forward_stop>;
+
+			template <std::size_t I> struct receiver
+			{
+				when_all_op* op;
+
+				template <class... Vs> void set_value(Vs&&... vs) && noexcept { op->template on_value<I>(std::forward<Vs>(vs)...); }
+
+				template <class E> void set_error(E&& e) && noexcept { op->on_error(std::forward<E>(e)); }
+
+				void set_stopped() && noexcept { op->on_stopped(); }
+
+				[[nodiscard]] stop_token_env<inplace_stop_token> get_env() const noexcept { return { op->stop_source_.get_token() }; }
+			};
+
+			template <class Is> struct children_for;
+
+			template <std::size_t... Is> struct children_for<std::index_sequence<Is...>>
+			{
+				using type = when_all_children<indices, connect_result_t<Senders, receiver<Is>>...>;
+			};
+
+		public:
+			when_all_op(std::tuple<Senders...>&& senders, Receiver rcvr) : when_all_op(std::move(senders), std::move(rcvr), indices{}) {}
+
+			when_all_op(const when_all_op&)			   = delete;
+			when_all_op& operator=(const when_all_op&) = delete;
+
+			void start() & noexcept
+			{
+				const parent_token_t token = execution::get_stop_token(execution::get_env(rcvr_));
+				if (token.stop_requested())
+				{
+					execution::set_stopped(std::move(rcvr_));
+					return;
+				}
+				if constexpr (sizeof...(Senders) == 0) { execution::set_value(std::move(rcvr_)); }
+				else
+				{
+					on_stop_.emplace(token, forward_stop{ &stop_source_ });
+					children_.start_all();
+				}
+			}
+
+		private:
+			template <std::size_t... Is>
+			when_all_op(std::tuple<Senders...>&& senders, Receiver rcvr, std::index_sequence<Is...>)
+				: rcvr_(std::move(rcvr)), children_([&] { return execution::connect(std::get<Is>(std::move(senders)), receiver<Is>{ this }); }...)
+			{
+			}
+
+			template <std::size_t I, class... Vs> void on_value(Vs&&... vs) noexcept
+			{
+				try
+				{
+					std::get<I>(values_).emplace(std::forward<Vs>(vs)...);
+				}
+				catch (...)
+				{
+					on_error(std::current_exception());
+					return;
+				}
+				arrive();
+			}
+
+			template <class E> void on_error(E&& e) noexcept
+			{
+				int expected = running;
+				if (state_.compare_exchange_strong(expected, failed, std::memory_order_acq_rel))
+				{
+					error_ = as_exception_ptr(std::forward<E>(e));
+					stop_source_.request_stop();
+				}
+				arrive();
+			}
+
+			void on_stopped() noexcept
+			{
+				int expected = running;
+				if (state_.compare_exchange_strong(expected, stopped, std::memory_order_acq_rel)) { stop_source_.request_stop(); }
+				arrive();
+			}
+
+			void arrive() noexcept
+			{
+				if (remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1) { return; }
+
+				on_stop_.reset();
+				switch (state_.load(std::memory_order_relaxed))
+				{
+				case failed: execution::set_error(std::move(rcvr_), std::move(error_)); break;
+				case stopped: execution::set_stopped(std::move(rcvr_)); break;
+				default: complete_with_values(); break;
+				}
+			}
+
+			void complete_with_values() noexcept
+			{
+				try
+				{
+					auto all = std::apply([](auto&... v) { return std::tuple_cat(std::move(*v)...); }, values_);
+					std::apply([this](auto&... v) { execution::set_value(std::move(rcvr_), std::move(v)...); }, all);
+				}
+				catch (...)
+				{
+					execution::set_error(std::move(rcvr_), std::current_exception());
+				}
+			}
+
+			Receiver rcvr_;
+			inplace_stop_source stop_source_;
+			std::optional<on_stop_t> on_stop_;
+			std::tuple<std::optional<decayed_tuple_t<value_types_of_t<Senders>>>...> values_;
+			std::exception_ptr error_;
+			std::atomic<int> state_{ running };
+			std::atomic<std::size_t> remaining_{ sizeof...(Senders) };
+			typename children_for<indices>::type children_;
+		};
+	} // namespace detail
+
+	// Starts every child and completes with all of their values concatenated, in argument order. The first error
+	// or stop asks the remaining children to stop through an inplace_stop_token in their environment, and a stop
+	// request on the receiver's token is forwarded the same way.
+	template <class... Senders> class when_all_sender
+	{
+	public:
+		using value_types						= typelist::concat_t<type_list<>, value_types_of_t<Senders>...>;
+		static constexpr bool sends_stopped = true;
+
+		template <class... Ss> explicit when_all_sender(std::in_place_t, Ss&&... sndrs) : senders_(std::forward<Ss>(sndrs)...) {}
+
+		template <class Receiver> detail::when_all_op<Receiver, Senders...> connect(Receiver rcvr) &&
+		{
+			return { std::move(senders_), std::move(rcvr) };
+		}
+
+	private:
+		std::tuple<Senders...> senders_;
+	};
+
+	template <class... Senders> when_all_sender<remove_cvref_t<Senders>...> when_all(Senders&&... sndrs)
+	{
+		return when_all_sender<remove_cvref_t<Senders>...>(std::in_place, std::forward<Senders>(sndrs)...);
+	}
+} // namespace execution
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_EXECUTION_WHEN_ALL_HPP
@@ -0,0 +1,803 @@
+#ifndef SNP_INCLUDE_SNAP_FLAT_MAP_HPP
+#define SNP_INCLUDE_SNAP_FLAT_MAP_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/flat_search.hpp"
+#include "snap/internal/helpers/flat_tree.hpp"
+#include "snap/internal/pp/no_unique_address.hpp"
+
+#include <algorithm> // std::equal, std::lexicographical_compare, std::is_sorted, std::stable_sort
+#include <cassert>
+#include <cstddef>
+#include <functional> // std::less
+#include <initializer_list>
+#include <iterator>
+#include <memory> // std::addressof
+#include <numeric> // std::iota
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	// Random access iterator over a key container and a mapped container in lockstep. Dereferencing yields a pair of
+	// references, so it is a proxy iterator like std::flat_map's.
+	template <class KeyIt, class MappedIt> class flat_map_iterator
+	{
+		template <class, class> friend class flat_map_iterator;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using difference_type	= std::ptrdiff_t;
+		using value_type		= std::pair<typename std::iterator_traits<KeyIt>::value_type, typename std::iterator_traits<MappedIt>::value_type>;
+		using reference			= std::pair<typename std::iterator_traits<KeyIt>::reference, typename std::iterator_traits<MappedIt>::reference>;
+
+		struct pointer
+		{
+			reference ref;
+			reference* operator->() noexcept { return std::addressof(ref); }
+		};
+
+		flat_map_iterator() = default;
+		flat_map_iterator(KeyIt key, MappedIt mapped) : m_key(key), m_mapped(mapped) {}
+
+		template <class OtherMapped, class = std::enable_if_t<!std::is_same_v<OtherMapped, MappedIt> && std::is_convertible_v<OtherMapped, MappedIt>>>
+		flat_map_iterator(const flat_map_iterator<KeyIt, OtherMapped>& other) : m_key(other.m_key), m_mapped(other.m_mapped)
+		{
+		}
+
+		reference operator*() const { return reference(*m_key, *m_mapped); }
+		pointer operator->() const { return pointer{ **this }; }
+		reference operator[](difference_type n) const { return *(*this + n); }
+
+		flat_map_iterator& operator++()
+		{
+			++m_key;
+			++m_mapped;
+			return *this;
+		}
+		flat_map_iterator operator++(int)
+		{
+			flat_map_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+		flat_map_iterator& operator--()
+		{
+			--m_key;
+			--m_mapped;
+			return *this;
+		}
+		flat_map_iterator operator--(int)
+		{
+			flat_map_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+		flat_map_iterator& operator+=(difference_type n)
+		{
+			m_key += n;
+			m_mapped += n;
+			return *this;
+		}
+		flat_map_iterator& operator-=(difference_type n) { return *this += -n; }
+
+		friend flat_map_iterator operator+(flat_map_iterator it, difference_type n) { return it += n; }
+		friend flat_map_iterator operator+(difference_type n, flat_map_iterator it) { return it += n; }
+		friend flat_map_iterator operator-(flat_map_iterator it, difference_type n) { return it -= n; }
+		friend difference_type operator-(const flat_map_iterator& a, const flat_map_iterator& b) { return a.m_key - b.m_key; }
+
+		friend bool operator==(const flat_map_iterator& a, const flat_map_iterator& b) { return a.m_key == b.m_key; }
+		friend bool operator!=(const flat_map_iterator& a, const flat_map_iterator& b) { return a.m_key != b.m_key; }
+		friend bool operator<(const flat_map_iterator& a, const flat_map_iterator& b) { return a.m_key < b.m_key; }
+		friend bool operator>(const flat_map_iterator& a, const flat_map_iterator& b) { return b < a; }
+		friend bool operator<=(const flat_map_iterator& a, const flat_map_iterator& b) { return !(b < a); }
+		friend bool operator>=(const flat_map_iterator& a, const flat_map_iterator& b) { return !(a < b); }
+
+	private:
+		KeyIt m_key{};
+		MappedIt m_mapped{};
+	};
+
+	// flat_map and flat_multimap: sorted keys and their mapped values in two parallel containers.
+	template <class Key, class T, class Compare, class KeyContainer, class MappedContainer, class Search, bool Multi> class flat_map_impl
+	{
+		template <class K>
+		using enable_if_transparent_t = std::enable_if_t<is_detected_v<is_transparent_t, Compare> && !std::is_convertible_v<K, Key>, int>;
+
+	public:
+		using key_type				 = Key;
+		using mapped_type			 = T;
+		using value_type			 = std::pair<key_type, mapped_type>;
+		using key_compare			 = Compare;
+		using reference				 = std::pair<const key_type&, mapped_type&>;
+		using const_reference		 = std::pair<const key_type&, const mapped_type&>;
+		using size_type				 = std::size_t;
+		using difference_type		 = std::ptrdiff_t;
+		using iterator				 = flat_map_iterator<typename KeyContainer::const_iterator, typename MappedContainer::iterator>;
+		using const_iterator		 = flat_map_iterator<typename KeyContainer::const_iterator, typename MappedContainer::const_iterator>;
+		using reverse_iterator		 = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using key_container_type	 = KeyContainer;
+		using mapped_container_type	 = MappedContainer;
+		using search_policy			 = Search;
+
+		// sorted_unique_t for flat_map, sorted_equivalent_t for flat_multimap
+		using sorted_tag = std::conditional_t<Multi, sorted_equivalent_t, sorted_unique_t>;
+
+		static_assert(std::is_same_v<key_type, typename KeyContainer::value_type>, "KeyContainer::value_type must be Key");
+		static_assert(std::is_same_v<mapped_type, typename MappedContainer::value_type>, "MappedContainer::value_type must be T");
+
+		class value_compare
+		{
+		public:
+			bool operator()(const_reference x, const_reference y) const { return m_comp(x.first, y.first); }
+
+		private:
+			friend class flat_map_impl;
+			explicit value_compare(const key_compare& comp) : m_comp(comp) {}
+
+			key_compare m_comp;
+		};
+
+		struct containers
+		{
+			key_container_type keys;
+			mapped_container_type values;
+		};
+
+		// constructors
+
+		flat_map_impl() = default;
+
+		explicit flat_map_impl(const key_compare& comp) : m_comp(comp) {}
+
+		// Sorts the elements and drops duplicate keys (flat_map) in one pass.
+		flat_map_impl(key_container_type keys, mapped_container_type values, const key_compare& comp = key_compare()) : m_comp(comp)
+		{
+			assert(keys.size() == values.size() && "keys and values must have the same size");
+			merge_in_(containers{ std::move(keys), std::move(values) }, false);
+		}
+
+		// Adopts containers that are already sorted (and free of duplicate keys for flat_map) without looking at them.
+		flat_map_impl(sorted_tag, key_container_type keys, mapped_container_type values, const key_compare& comp = key_compare())
+			: m_c{ std::move(keys), std::move(values) }, m_comp(comp)
+		{
+			assert(m_c.keys.size() == m_c.values.size() && "keys and values must have the same size");
+			rebuild_index_();
+		}
+
+		template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		flat_map_impl(InputIt first, InputIt last, const key_compare& comp = key_compare()) : m_comp(comp)
+		{
+			insert(first, last);
+		}
+
+		template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		flat_map_impl(sorted_tag tag, InputIt first, InputIt last, const key_compare& comp = key_compare()) : m_comp(comp)
+		{
+			insert(tag, first, last);
+		}
+
+		flat_map_impl(std::initializer_list<value_type> il, const key_compare& comp = key_compare()) : flat_map_impl(il.begin(), il.end(), comp) {}
+
+		flat_map_impl(sorted_tag tag, std::initializer_list<value_type> il, const key_compare& comp = key_compare())
+			: flat_map_impl(tag, il.begin(), il.end(), comp)
+		{
+		}
+
+		flat_map_impl& operator=(std::initializer_list<value_type> il)
+		{
+			clear();
+			insert(il);
+			return *this;
+		}
+
+		// iterators
+		iterator begin() noexcept { return iterator(m_c.keys.cbegin(), m_c.values.begin()); }
+		const_iterator begin() const noexcept { return const_iterator(m_c.keys.cbegin(), m_c.values.cbegin()); }
+		iterator end() noexcept { return iterator(m_c.keys.cend(), m_c.values.end()); }
+		const_iterator end() const noexcept { return const_iterator(m_c.keys.cend(), m_c.values.cend()); }
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_iterator cbegin() const noexcept { return begin(); }
+		const_iterator cend() const noexcept { return end(); }
+		const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		const_reverse_iterator crend() const noexcept { return rend(); }
+
+		// capacity
+		[[nodiscard]] bool empty() const noexcept { return m_c.keys.empty(); }
+		size_type size() const noexcept { return static_cast<size_type>(m_c.keys.size()); }
+		size_type max_size() const noexcept
+		{
+			return std::min<size_type>(static_cast<size_type>(m_c.keys.max_size()), static_cast<size_type>(m_c.values.max_size()));
+		}
+
+		// element access (flat_map only)
+		template <bool M = Multi, class = std::enable_if_t<!M>> mapped_type& operator[](const key_type& key) { return try_emplace(key).first->second; }
+		template <bool M = Multi, class = std::enable_if_t<!M>> mapped_type& operator[](key_type&& key)
+		{
+			return try_emplace(std::move(key)).first->second;
+		}
+
+		template <bool M = Multi, class = std::enable_if_t<!M>> mapped_type& at(const key_type& key) { return at_(key); }
+		template <bool M = Multi, class = std::enable_if_t<!M>> const mapped_type& at(const key_type& key) const { return at_(key); }
+		template <class K, bool M = Multi, class = std::enable_if_t<!M>, enable_if_transparent_t<K> = 0> mapped_type& at(const K& key)
+		{
+			return at_(key);
+		}
+		template <class K, bool M = Multi, class = std::enable_if_t<!M>, enable_if_transparent_t<K> = 0> const mapped_type& at(const K& key) const
+		{
+			return at_(key);
+		}
+
+		// modifiers
+
+		// flat_map returns pair<iterator, bool>; flat_multimap returns the iterator and inserts after equivalent keys.
+		template <class... Args> auto emplace(Args&&... args) -> std::conditional_t<Multi, iterator, std::pair<iterator, bool>>
+		{
+			value_type value(std::forward<Args>(args)...);
+			if constexpr (Multi) { return insert_at_(upper_index_(value.first), std::move(value.first), std::move(value.second)); }
+			else
+			{
+				const size_type i = lower_index_(value.first);
+				if (i != size() && !m_comp(value.first, key_at_(i))) { return { iter_at_(i), false }; }
+				return { insert_at_(i, std::move(value.first), std::move(value.second)), true };
+			}
+		}
+
+		// The hint is used when the new element belongs right before it; otherwise this is a plain emplace.
+		template <class... Args> iterator emplace_hint(const_iterator hint, Args&&... args)
+		{
+			value_type value(std::forward<Args>(args)...);
+			const auto i		 = static_cast<size_type>(hint - cbegin());
+			const bool after_prev = i == 0 || (Multi ? !m_comp(value.first, key_at_(i - 1)) : m_comp(key_at_(i - 1), value.first));
+			const bool before_hint = i == size() || (Multi ? !m_comp(key_at_(i), value.first) : m_comp(value.first, key_at_(i)));
+			if (after_prev && before_hint) { return insert_at_(i, std::move(value.first), std::move(value.second)); }
+			if constexpr (Multi) { return emplace(std::move(value)); }
+			else { return emplace(std::move(value)).first; }
+		}
+
+		auto insert(const value_type& value) { return emplace(value); }
+		auto insert(value_type&& value) { return emplace(std::move(value)); }
+		iterator insert(const_iterator hint, const value_type& value) { return emplace_hint(hint, value); }
+		iterator insert(const_iterator hint, value_type&& value) { return emplace_hint(hint, std::move(value)); }
+
+		template <class P, class = std::enable_if_t<std::is_constructible_v<value_type, P> && !std::is_same_v<std::decay_t<P>, value_type>>>
+		auto insert(P&& value)
+		{
+			return emplace(std::forward<P>(value));
+		}
+
+		template <class P, class = std::enable_if_t<std::is_constructible_v<value_type, P> && !std::is_same_v<std::decay_t<P>, value_type>>>
+		iterator insert(const_iterator hint, P&& value)
+		{
+			return emplace_hint(hint, std::forward<P>(value));
+		}
+
+		// Bulk insert: the new elements are collected, sorted once and merged with the existing ones in a single pass.
+		template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>> void insert(InputIt first, InputIt last)
+		{
+			insert_range_(first, last, false);
+		}
+
+		// Bulk insert of elements already sorted (and unique for flat_map); skips the sort.
+		template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>> void insert(sorted_tag, InputIt first, InputIt last)
+		{
+			insert_range_(first, last, true);
+		}
+
+		void insert(std::initializer_list<value_type> il) { insert(il.begin(), il.end()); }
+		void insert(sorted_tag tag, std::initializer_list<value_type> il) { insert(tag, il.begin(), il.end()); }
+
+		template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))> void insert_range(R&& rg)
+		{
+			insert_range_(std::begin(rg), std::end(rg), false);
+		}
+
+		// flat_map only: construct the mapped value from args if key is absent.
+		template <class... Args, bool M = Multi, class = std::enable_if_t<!M>> std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+		{
+			return try_emplace_(key, std::forward<Args>(args)...);
+		}
+
+		template <class... Args, bool M = Multi, class = std::enable_if_t<!M>> std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+		{
+			return try_emplace_(std::move(key), std::forward<Args>(args)...);
+		}
+
+		template <class... Args, bool M = Multi, class = std::enable_if_t<!M>> iterator try_emplace(const_iterator, const key_type& key, Args&&... args)
+		{
+			return try_emplace_(key, std::forward<Args>(args)...).first;
+		}
+
+		template <class... Args, bool M = Multi, class = std::enable_if_t<!M>> iterator try_emplace(const_iterator, key_type&& key, Args&&... args)
+		{
+			return try_emplace_(std::move(key), std::forward<Args>(args)...).first;
+		}
+
+		template <class M, bool Mu = Multi, class = std::enable_if_t<!Mu>> std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+		{
+			return insert_or_assign_(key, std::forward<M>(obj));
+		}
+
+		template <class M, bool Mu = Multi, class = std::enable_if_t<!Mu>> std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+		{
+			return insert_or_assign_(std::move(key), std::forward<M>(obj));
+		}
+
+		// Moves the containers out and leaves the map empty.
+		containers extract() &&
+		{
+			containers out = std::move(m_c);
+			clear();
+			return out;
+		}
+
+		// Takes over containers that are already sorted (and unique for flat_map).
+		void replace(key_container_type&& keys, mapped_container_type&& values)
+		{
+			assert(keys.size() == values.size() && "keys and values must have the same size");
+			m_c.keys   = std::move(keys);
+			m_c.values = std::move(values);
+			rebuild_index_();
+		}
+
+		iterator erase(iterator pos) { return erase_n_(static_cast<size_type>(pos - begin()), 1); }
+		iterator erase(const_iterator pos) { return erase_n_(static_cast<size_type>(pos - cbegin()), 1); }
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			return erase_n_(static_cast<size_type>(first - cbegin()), static_cast<size_type>(last - first));
+		}
+
+		size_type erase(const key_type& key) { return erase_key_(key); }
+
+		template <class K,
+				  enable_if_transparent_t<K> = 0,
+				  class					   = std::enable_if_t<!std::is_convertible_v<K&&, iterator> && !std::is_convertible_v<K&&, const_iterator>>>
+		size_type erase(K&& key)
+		{
+			return erase_key_(key);
+		}
+
+		void swap(flat_map_impl& other) noexcept
+		{
+			using std::swap;
+			swap(m_c.keys, other.m_c.keys);
+			swap(m_c.values, other.m_c.values);
+			swap(m_comp, other.m_comp);
+			swap(m_index, other.m_index);
+		}
+
+		void clear() noexcept
+		{
+			m_c.keys.clear();
+			m_c.values.clear();
+			rebuild_index_();
+		}
+
+		// observers
+		key_compare key_comp() const { return m_comp; }
+		value_compare value_comp() const { return value_compare(m_comp); }
+		const key_container_type& keys() const noexcept { return m_c.keys; }
+		const mapped_container_type& values() const noexcept { return m_c.values; }
+
+		// lookup
+		iterator find(const key_type& key) { return iter_at_(find_index_(key)); }
+		const_iterator find(const key_type& key) const { return citer_at_(find_index_(key)); }
+		template <class K, enable_if_transparent_t<K> = 0> iterator find(const K& key) { return iter_at_(find_index_(key)); }
+		template <class K, enable_if_transparent_t<K> = 0> const_iterator find(const K& key) const { return citer_at_(find_index_(key)); }
+
+		size_type count(const key_type& key) const { return count_(key); }
+		template <class K, enable_if_transparent_t<K> = 0> size_type count(const K& key) const { return count_(key); }
+
+		bool contains(const key_type& key) const { return find_index_(key) != size(); }
+		template <class K, enable_if_transparent_t<K> = 0> bool contains(const K& key) const { return find_index_(key) != size(); }
+
+		iterator lower_bound(const key_type& key) { return iter_at_(lower_index_(key)); }
+		const_iterator lower_bound(const key_type& key) const { return citer_at_(lower_index_(key)); }
+		template <class K, enable_if_transparent_t<K> = 0> iterator lower_bound(const K& key) { return iter_at_(lower_index_(key)); }
+		template <class K, enable_if_transparent_t<K> = 0> const_iterator lower_bound(const K& key) const { return citer_at_(lower_index_(key)); }
+
+		iterator upper_bound(const key_type& key) { return iter_at_(upper_index_(key)); }
+		const_iterator upper_bound(const key_type& key) const { return citer_at_(upper_index_(key)); }
+		template <class K, enable_if_transparent_t<K> = 0> iterator upper_bound(const K& key) { return iter_at_(upper_index_(key)); }
+		template <class K, enable_if_transparent_t<K> = 0> const_iterator upper_bound(const K& key) const { return citer_at_(upper_index_(key)); }
+
+		std::pair<iterator, iterator> equal_range(const key_type& key) { return equal_range_(*this, key); }
+		std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return equal_range_(*this, key); }
+		template <class K, enable_if_transparent_t<K> = 0> std::pair<iterator, iterator> equal_range(const K& key) { return equal_range_(*this, key); }
+		template <class K, enable_if_transparent_t<K> = 0> std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+		{
+			return equal_range_(*this, key);
+		}
+
+		// comparisons
+		friend bool operator==(const flat_map_impl& a, const flat_map_impl& b)
+		{
+			return a.size() == b.size() && std::equal(a.m_c.keys.begin(), a.m_c.keys.end(), b.m_c.keys.begin()) &&
+				   std::equal(a.m_c.values.begin(), a.m_c.values.end(), b.m_c.values.begin());
+		}
+		friend bool operator!=(const flat_map_impl& a, const flat_map_impl& b) { return !(a == b); }
+		friend bool operator<(const flat_map_impl& a, const flat_map_impl& b)
+		{
+			return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+		}
+		friend bool operator>(const flat_map_impl& a, const flat_map_impl& b) { return b < a; }
+		friend bool operator<=(const flat_map_impl& a, const flat_map_impl& b) { return !(b < a); }
+		friend bool operator>=(const flat_map_impl& a, const flat_map_impl& b) { return !(a < b); }
+
+		friend void swap(flat_map_impl& a, flat_map_impl& b) noexcept { a.swap(b); }
+
+	private:
+		template <class C> static decltype(auto) at_(C& c, size_type i) { return c.begin()[static_cast<difference_type>(i)]; }
+
+		const key_type& key_at_(size_type i) const { return at_(m_c.keys, i); }
+		iterator iter_at_(size_type i) { return begin() + static_cast<difference_type>(i); }
+		const_iterator citer_at_(size_type i) const { return begin() + static_cast<difference_type>(i); }
+
+		void rebuild_index_() noexcept { m_index.rebuild(m_c.keys); }
+
+		template <class K> size_type lower_index_(const K& key) const
+		{
+			return m_index.partition_point(m_c.keys, [&](const auto& k) { return static_cast<bool>(m_comp(k, key)); });
+		}
+
+		template <class K> size_type upper_index_(const K& key) const
+		{
+			return m_index.partition_point(m_c.keys, [&](const auto& k) { return !m_comp(key, k); });
+		}
+
+		// size() if absent
+		template <class K> size_type find_index_(const K& key) const
+		{
+			const size_type i = lower_index_(key);
+			return i != size() && !m_comp(key, key_at_(i)) ? i : size();
+		}
+
+		template <class K> size_type count_(const K& key) const
+		{
+			if constexpr (Multi) { return upper_index_(key) - lower_index_(key); }
+			else { return find_index_(key) != size() ? 1 : 0; }
+		}
+
+		template <class Self, class K> static auto equal_range_(Self& self, const K& key)
+		{
+			const size_type first = self.lower_index_(key);
+			size_type last		  = first;
+			if constexpr (Multi) { last = self.upper_index_(key); }
+			else if (first != self.size() && !self.m_comp(key, self.key_at_(first))) { last = first + 1; }
+			return std::make_pair(self.begin() + static_cast<difference_type>(first), self.begin() + static_cast<difference_type>(last));
+		}
+
+		template <class K> decltype(auto) at_(const K& key) const
+		{
+			const size_type i = find_index_(key);
+			if (i == size()) throw std::out_of_range("snap::flat_map::at: key not found");
+			return at_(m_c.values, i);
+		}
+
+		template <class K> mapped_type& at_(const K& key)
+		{
+			const size_type i = find_index_(key);
+			if (i == size()) throw std::out_of_range("snap::flat_map::at: key not found");
+			return at_(m_c.values, i);
+		}
+
+		// Inserts a key and its mapped value at index i; if the mapped value throws, the key is removed again.
+		template <class K, class... Args> iterator insert_at_(size_type i, K&& key, Args&&... args)
+		{
+			const auto key_pos = m_c.keys.emplace(m_c.keys.begin() + static_cast<difference_type>(i), std::forward<K>(key));
+			try
+			{
+				m_c.values.emplace(m_c.values.begin() + static_cast<difference_type>(i), std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				m_c.keys.erase(key_pos);
+				throw;
+			}
+			rebuild_index_();
+			return iter_at_(i);
+		}
+
+		template <class K, class... Args> std::pair<iterator, bool> try_emplace_(K&& key, Args&&... args)
+		{
+			const size_type i = lower_index_(key);
+			if (i != size() && !m_comp(key, key_at_(i))) { return { iter_at_(i), false }; }
+			return { insert_at_(i, std::forward<K>(key), std::forward<Args>(args)...), true };
+		}
+
+		template <class K, class M> std::pair<iterator, bool> insert_or_assign_(K&& key, M&& obj)
+		{
+			const size_type i = lower_index_(key);
+			if (i != size() && !m_comp(key, key_at_(i)))
+			{
+				at_(m_c.values, i) = std::forward<M>(obj);
+				return { iter_at_(i), false };
+			}
+			return { insert_at_(i, std::forward<K>(key), std::forward<M>(obj)), true };
+		}
+
+		iterator erase_n_(size_type i, size_type n)
+		{
+			const auto first = static_cast<difference_type>(i);
+			const auto last	 = static_cast<difference_type>(i + n);
+			m_c.keys.erase(m_c.keys.begin() + first, m_c.keys.begin() + last);
+			m_c.values.erase(m_c.values.begin() + first, m_c.values.begin() + last);
+			rebuild_index_();
+			return iter_at_(i);
+		}
+
+		template <class K> size_type erase_key_(const K& key)
+		{
+			const size_type first = lower_index_(key);
+			const size_type last  = Multi ? upper_index_(key) : (first != size() && !m_comp(key, key_at_(first)) ? first + 1 : first);
+			if (first != last) erase_n_(first, last - first);
+			return last - first;
+		}
+
+		template <class InputIt> void insert_range_(InputIt first, InputIt last, bool sorted)
+		{
+			containers fresh;
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+			{
+				const auto n = static_cast<size_type>(std::distance(first, last));
+				reserve_if_possible(fresh.keys, n);
+				reserve_if_possible(fresh.values, n);
+			}
+			for (; first != last; ++first)
+			{
+				auto&& element = *first;
+				fresh.keys.emplace_back(std::forward<decltype(element)>(element).first);
+				fresh.values.emplace_back(std::forward<decltype(element)>(element).second);
+			}
+			merge_in_(std::move(fresh), sorted);
+		}
+
+		// Orders fresh by key, keeping equivalent keys in input order. Does nothing for input that is already sorted.
+		void sort_(containers& fresh) const
+		{
+			const auto n = static_cast<size_type>(fresh.keys.size());
+			if (std::is_sorted(fresh.keys.begin(), fresh.keys.end(), m_comp)) return;
+
+			std::vector<size_type> order(n);
+			std::iota(order.begin(), order.end(), size_type{ 0 });
+			std::stable_sort(order.begin(), order.end(), [&](size_type a, size_type b) { return m_comp(at_(fresh.keys, a), at_(fresh.keys, b)); });
+
+			containers sorted;
+			reserve_if_possible(sorted.keys, n);
+			reserve_if_possible(sorted.values, n);
+			for (const size_type i : order)
+			{
+				sorted.keys.emplace_back(std::move(at_(fresh.keys, i)));
+				sorted.values.emplace_back(std::move(at_(fresh.values, i)));
+			}
+			fresh = std::move(sorted);
+		}
+
+		// Merges fresh into the map. If anything throws the map is left empty, as with std::flat_map.
+		void merge_in_(containers&& fresh, bool sorted)
+		{
+			try
+			{
+				if (!sorted) sort_(fresh);
+				const auto n = static_cast<size_type>(fresh.keys.size());
+				if (n == 0) return;
+
+				// fresh is free of duplicates and belongs after every existing key: append it
+				if ((sorted || Multi) && (empty() || m_comp(key_at_(size() - 1), at_(fresh.keys, 0))))
+				{
+					if (empty()) { m_c = std::move(fresh); }
+					else
+					{
+						reserve_if_possible(m_c.keys, size() + n);
+						reserve_if_possible(m_c.values, size() + n);
+						for (size_type i = 0; i < n; ++i)
+						{
+							m_c.keys.emplace_back(std::move(at_(fresh.keys, i)));
+							m_c.values.emplace_back(std::move(at_(fresh.values, i)));
+						}
+					}
+				}
+				else
+				{
+					containers out;
+					reserve_if_possible(out.keys, size() + n);
+					reserve_if_possible(out.values, size() + n);
+					merge_sorted_runs<!Multi>(
+						size(),
+						n,
+						[&](size_type i) -> const key_type& { return key_at_(i); },
+						[&](size_type j) -> const key_type& { return at_(fresh.keys, j); },
+						m_comp,
+						[&](size_type i) {
+							out.keys.emplace_back(std::move(at_(m_c.keys, i)));
+							out.values.emplace_back(std::move(at_(m_c.values, i)));
+						},
+						[&](size_type j) {
+							out.keys.emplace_back(std::move(at_(fresh.keys, j)));
+							out.values.emplace_back(std::move(at_(fresh.values, j)));
+						});
+					m_c = std::move(out);
+				}
+			}
+			catch (...)
+			{
+				clear();
+				throw;
+			}
+			rebuild_index_();
+		}
+
+		containers m_c;
+		SNAP_NO_UNIQUE_ADDRESS_ATTR key_compare m_comp;
+		SNAP_NO_UNIQUE_ADDRESS_ATTR typename Search::template index<Key> m_index;
+	};
+} // namespace internal::detail
+
+// A sorted associative container with unique keys, stored as a sorted key container and a parallel mapped
+// container (C++23 std::flat_map). Lookups touch only the contiguous keys; Search selects how they are probed
+// (default_search or eytzinger_search). Any random access sequence container works as storage. With
+// snap::inplace_vector storage and default_search, lookups and single-element inserts do not allocate; bulk
+// inserts of unsorted input and eytzinger_search's index still do.
+//
+// Bulk inserts (ranges, initializer lists, the container constructors) sort the new elements once and merge them
+// in a single pass. If an insert throws the map may be left empty.
+template <class Key,
+		  class T,
+		  class Compare			= std::less<Key>,
+		  class KeyContainer	= std::vector<Key>,
+		  class MappedContainer = std::vector<T>,
+		  class Search			= default_search>
+class flat_map : public internal::detail::flat_map_impl<Key, T, Compare, KeyContainer, MappedContainer, Search, false>
+{
+	using base = internal::detail::flat_map_impl<Key, T, Compare, KeyContainer, MappedContainer, Search, false>;
+
+public:
+	using base::base;
+
+	flat_map() = default;
+
+	// Declared here rather than inherited so that class template argument deduction sees an initializer-list
+	// constructor for braced initialization.
+	flat_map(std::initializer_list<typename base::value_type> il, const Compare& comp = Compare()) : base(il, comp) {}
+
+	flat_map& operator=(std::initializer_list<typename base::value_type> il)
+	{
+		base::operator=(il);
+		return *this;
+	}
+
+	friend void swap(flat_map& a, flat_map& b) noexcept { a.swap(b); }
+};
+
+// flat_map that allows equivalent keys; they keep their insertion order.
+template <class Key,
+		  class T,
+		  class Compare			= std::less<Key>,
+		  class KeyContainer	= std::vector<Key>,
+		  class MappedContainer = std::vector<T>,
+		  class Search			= default_search>
+class flat_multimap : public internal::detail::flat_map_impl<Key, T, Compare, KeyContainer, MappedContainer, Search, true>
+{
+	using base = internal::detail::flat_map_impl<Key, T, Compare, KeyContainer, MappedContainer, Search, true>;
+
+public:
+	using base::base;
+
+	flat_multimap() = default;
+
+	// Declared here rather than inherited so that class template argument deduction sees an initializer-list
+	// constructor for braced initialization.
+	flat_multimap(std::initializer_list<typename base::value_type> il, const Compare& comp = Compare()) : base(il, comp) {}
+
+	flat_multimap& operator=(std::initializer_list<typename base::value_type> il)
+	{
+		base::operator=(il);
+		return *this;
+	}
+
+	friend void swap(flat_multimap& a, flat_multimap& b) noexcept { a.swap(b); }
+};
+
+// Deduction guides, as for std::flat_map and std::flat_multimap.
+template <class KeyContainer,
+		  class MappedContainer,
+		  class Compare = std::less<typename KeyContainer::value_type>,
+		  class			= std::enable_if_t<!internal::detail::is_iterator_v<KeyContainer>>>
+flat_map(KeyContainer, MappedContainer, Compare = Compare())
+	-> flat_map<typename KeyContainer::value_type, typename MappedContainer::value_type, Compare, KeyContainer, MappedContainer>;
+
+template <class KeyContainer, class MappedContainer, class Compare = std::less<typename KeyContainer::value_type>>
+flat_map(sorted_unique_t, KeyContainer, MappedContainer, Compare = Compare())
+	-> flat_map<typename KeyContainer::value_type, typename MappedContainer::value_type, Compare, KeyContainer, MappedContainer>;
+
+template <class InputIt, class Compare = std::less<internal::detail::iter_key_t<InputIt>>, class = std::enable_if_t<internal::detail::is_iterator_v<InputIt>>>
+flat_map(InputIt, InputIt, Compare = Compare()) -> flat_map<internal::detail::iter_key_t<InputIt>, internal::detail::iter_mapped_t<InputIt>, Compare>;
+
+template <class InputIt, class Compare = std::less<internal::detail::iter_key_t<InputIt>>, class = std::enable_if_t<internal::detail::is_iterator_v<InputIt>>>
+flat_map(sorted_unique_t, InputIt, InputIt, Compare = Compare())
+	-> flat_map<internal::detail::iter_key_t<InputIt>, internal::detail::iter_mapped_t<InputIt>, Compare>;
+
+template <class Key, class T, class Compare = std::less<Key>>
+flat_map(std::initializer_list<std::pair<Key, T>>, Compare = Compare()) -> flat_map<Key, T, Compare>;
+
+template <class Key, class T, class Compare = std::less<Key>>
+flat_map(sorted_unique_t, std::initializer_list<std::pair<Key, T>>, Compare = Compare()) -> flat_map<Key, T, Compare>;
+
+template <class KeyContainer,
+		  class MappedContainer,
+		  class Compare = std::less<typename KeyContainer::value_type>,
+		  class			= std::enable_if_t<!internal::detail::is_iterator_v<KeyContainer>>>
+flat_multimap(KeyContainer, MappedContainer, Compare = Compare())
+	-> flat_multimap<typename KeyContainer::value_type, typename MappedContainer::value_type, Compare, KeyContainer, MappedContainer>;
+
+template <class KeyContainer, class MappedContainer, class Compare = std::less<typename KeyContainer::value_type>>
+flat_multimap(sorted_equivalent_t, KeyContainer, MappedContainer, Compare = Compare())
+	-> flat_multimap<typename KeyContainer::value_type, typename MappedContainer::value_type, Compare, KeyContainer, MappedContainer>;
+
+template <class InputIt, class Compare = std::less<internal::detail::iter_key_t<InputIt>>, class = std::enable_if_t<internal::detail::is_iterator_v<InputIt>>>
+flat_multimap(InputIt, InputIt, Compare = Compare()) -> flat_multimap<internal::detail::iter_key_t<InputIt>, internal::detail::iter_mapped_t<InputIt>, Compare>;
+
+template <class InputIt, class Compare = std::less<internal::detail::iter_key_t<InputIt>>, class = std::enable_if_t<internal::detail::is_iterator_v<InputIt>>>
+flat_multimap(sorted_equivalent_t, InputIt, InputIt, Compare = Compare())
+	-> flat_multimap<internal::detail::iter_key_t<InputIt>, internal::detail::iter_mapped_t<InputIt>, Compare>;
+
+template <class Key, class T, class Compare = std::less<Key>>
+flat_multimap(std::initializer_list<std::pair<Key, T>>, Compare = Compare()) -> flat_multimap<Key, T, Compare>;
+
+template <class Key, class T, class Compare = std::less<Key>>
+flat_multimap(sorted_equivalent_t, std::initializer_list<std::pair<Key, T>>, Compare = Compare()) -> flat_multimap<Key, T, Compare>;
+
+namespace internal::detail
+{
+	template <class Map, class Pred> std::size_t flat_map_erase_if(Map& c, Pred pred)
+	{
+		auto extracted = std::move(c).extract();
+		auto key	   = extracted.keys.begin();
+		auto value	   = extracted.values.begin();
+		auto out_key   = key;
+		auto out_value = value;
+		for (; key != extracted.keys.end(); ++key, ++value)
+		{
+			if (pred(typename Map::const_reference(*key, *value))) continue;
+			if (out_key != key)
+			{
+				*out_key   = std::move(*key);
+				*out_value = std::move(*value);
+			}
+			++out_key;
+			++out_value;
+		}
+		const std::size_t erased = static_cast<std::size_t>(extracted.keys.end() - out_key);
+		extracted.keys.erase(out_key, extracted.keys.end());
+		extracted.values.erase(out_value, extracted.values.end());
+		c.replace(std::move(extracted.keys), std::move(extracted.values));
+		return erased;
+	}
+} // namespace internal::detail
+
+// Erases every element for which pred(const_reference) holds; returns how many were erased.
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer, class Search, class Pred>
+std::size_t erase_if(flat_map<Key, T, Compare, KeyContainer, MappedContainer, Search>& c, Pred pred)
+{
+	return internal::detail::flat_map_erase_if(c, pred);
+}
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer, class Search, class Pred>
+std::size_t erase_if(flat_multimap<Key, T, Compare, KeyContainer, MappedContainer, Search>& c, Pred pred)
+{
+	return internal::detail::flat_map_erase_if(c, pred);
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_FLAT_MAP_HPP
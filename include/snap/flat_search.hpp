@@ -0,0 +1,124 @@
+#ifndef SNP_INCLUDE_SNAP_FLAT_SEARCH_HPP
+#define SNP_INCLUDE_SNAP_FLAT_SEARCH_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/bit/countr.hpp"
+#include "snap/internal/helpers/flat_tree.hpp"
+#include "snap/internal/pp/has_builtin.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+SNAP_BEGIN_NAMESPACE
+
+// Tags for constructors and inserts whose input is already sorted (and, for sorted_unique, free of duplicates).
+struct sorted_unique_t
+{
+	explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
+struct sorted_equivalent_t
+{
+	explicit sorted_equivalent_t() = default;
+};
+
+inline constexpr sorted_equivalent_t sorted_equivalent{};
+
+// Search policies for the flat containers. A policy provides `index<Key>`, which the container keeps next to its keys
+// and rebuilds after every change to them. partition_point(keys, before) returns the index of the first key for
+// which before(key) is false.
+
+// Branchless binary search. Scalar keys fall back to a linear count when there are at most LinearThreshold of
+// them, which beats the binary search's dependent loads on small maps.
+template <std::size_t LinearThreshold = 16> struct branchless_search
+{
+	template <class Key> struct index
+	{
+		template <class KeyContainer> void rebuild(const KeyContainer&) noexcept {}
+
+		template <class KeyContainer, class Before> std::size_t partition_point(const KeyContainer& keys, Before before) const
+		{
+			const auto n = static_cast<std::size_t>(keys.size());
+			if constexpr (std::is_scalar_v<Key> && LinearThreshold != 0)
+			{
+				if (n <= LinearThreshold) return internal::detail::linear_partition_point(keys.begin(), n, before);
+			}
+			return internal::detail::branchless_partition_point(keys.begin(), n, before);
+		}
+	};
+};
+
+using default_search = branchless_search<>;
+
+// Searches a copy of the keys stored in Eytzinger (breadth first) order, where the next probe always sits next to
+// the current one and can be prefetched. The copy costs O(size()) memory and is rebuilt on every modification, so
+// this suits tables that are built once and then queried often. If the copy cannot be allocated, lookups fall
+// back to branchless_search.
+struct eytzinger_search
+{
+	template <class Key> class index
+	{
+	public:
+		template <class KeyContainer> void rebuild(const KeyContainer& keys) noexcept
+		{
+			m_keys.clear();
+			m_rank.clear();
+			const auto n = static_cast<std::size_t>(keys.size());
+			try
+			{
+				m_rank.resize(n);
+				std::size_t next = 0;
+				fill_(1, n, next);
+				m_keys.reserve(n);
+				for (std::size_t k = 0; k < n; ++k) m_keys.push_back(keys.begin()[static_cast<std::ptrdiff_t>(m_rank[k])]);
+			}
+			catch (...)
+			{
+				m_keys.clear();
+				m_rank.clear();
+			}
+		}
+
+		template <class KeyContainer, class Before> std::size_t partition_point(const KeyContainer& keys, Before before) const
+		{
+			const auto n = static_cast<std::size_t>(keys.size());
+			if (m_keys.size() != n) { return internal::detail::branchless_partition_point(keys.begin(), n, before); }
+
+			// 1-based node numbering: the children of k are 2k and 2k + 1
+			std::size_t k = 1;
+			while (k <= n)
+			{
+#if SNAP_HAS_BUILTIN(__builtin_prefetch)
+				// the great-great-grandchildren of k share a cache line for small keys
+				if (16 * k <= n) __builtin_prefetch(m_keys.data() + 16 * k - 1);
+#endif
+				k = 2 * k + static_cast<std::size_t>(before(m_keys[k - 1]));
+			}
+			// the answer is the last node where the search went left: drop the trailing right turns and that left one
+			k >>= countr_one(k) + 1;
+			return k == 0 ? n : m_rank[k - 1];
+		}
+
+	private:
+		// in-order walk of the implicit tree assigns the sorted positions
+		void fill_(std::size_t k, std::size_t n, std::size_t& next) noexcept
+		{
+			if (k > n) return;
+			fill_(2 * k, n, next);
+			m_rank[k - 1] = next++;
+			fill_(2 * k + 1, n, next);
+		}
+
+		std::vector<Key> m_keys;		  // keys in Eytzinger order
+		std::vector<std::size_t> m_rank; // sorted position of m_keys[i]
+	};
+};
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_FLAT_SEARCH_HPP
@@ -0,0 +1,489 @@
+#ifndef SNP_INCLUDE_SNAP_FLAT_SET_HPP
+#define SNP_INCLUDE_SNAP_FLAT_SET_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/flat_search.hpp"
+#include "snap/internal/helpers/flat_tree.hpp"
+#include "snap/internal/pp/no_unique_address.hpp"
+
+#include <algorithm> // std::equal, std::lexicographical_compare, std::is_sorted, std::stable_sort
+#include <cstddef>
+#include <functional> // std::less
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	// flat_set and flat_multiset: sorted keys in one container.
+	template <class Key, class Compare, class KeyContainer, class Search, bool Multi> class flat_set_impl
+	{
+		template <class K>
+		using enable_if_transparent_t = std::enable_if_t<is_detected_v<is_transparent_t, Compare> && !std::is_convertible_v<K, Key>, int>;
+
+	public:
+		using key_type				 = Key;
+		using value_type			 = Key;
+		using key_compare			 = Compare;
+		using value_compare			 = Compare;
+		using reference				 = value_type&;
+		using const_reference		 = const value_type&;
+		using size_type				 = std::size_t;
+		using difference_type		 = std::ptrdiff_t;
+		using iterator				 = typename KeyContainer::const_iterator;
+		using const_iterator		 = typename KeyContainer::const_iterator;
+		using reverse_iterator		 = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using container_type		 = KeyContainer;
+		using search_policy			 = Search;
+
+		// sorted_unique_t for flat_set, sorted_equivalent_t for flat_multiset
+		using sorted_tag = std::conditional_t<Multi, sorted_equivalent_t, sorted_unique_t>;
+
+		static_assert(std::is_same_v<key_type, typename KeyContainer::value_type>, "KeyContainer::value_type must be Key");
+
+		// constructors
+
+		flat_set_impl() = default;
+
+		explicit flat_set_impl(const key_compare& comp) : m_comp(comp) {}
+
+		// Sorts the keys and drops duplicates (flat_set) in one pass.
+		explicit flat_set_impl(container_type keys, const key_compare& comp = key_compare()) : m_comp(comp) { merge_in_(std::move(keys), false); }
+
+		// Adopts a container that is already sorted (and free of duplicates for flat_set) without looking at it.
+		flat_set_impl(sorted_tag, container_type keys, const key_compare& comp = key_compare()) : m_keys(std::move(keys)), m_comp(comp)
+		{
+			rebuild_index_();
+		}
+
+		template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		flat_set_impl(InputIt first, InputIt last, const key_compare& comp = key_compare()) : m_comp(comp)
+		{
+			insert(first, last);
+		}
+
+		template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		flat_set_impl(sorted_tag tag, InputIt first, InputIt last, const key_compare& comp = key_compare()) : m_comp(comp)
+		{
+			insert(tag, first, last);
+		}
+
+		flat_set_impl(std::initializer_list<value_type> il, const key_compare& comp = key_compare()) : flat_set_impl(il.begin(), il.end(), comp) {}
+
+		flat_set_impl(sorted_tag tag, std::initializer_list<value_type> il, const key_compare& comp = key_compare())
+			: flat_set_impl(tag, il.begin(), il.end(), comp)
+		{
+		}
+
+		flat_set_impl& operator=(std::initializer_list<value_type> il)
+		{
+			clear();
+			insert(il);
+			return *this;
+		}
+
+		// iterators
+		iterator begin() const noexcept { return m_keys.cbegin(); }
+		iterator end() const noexcept { return m_keys.cend(); }
+		reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+		reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+		const_iterator cbegin() const noexcept { return begin(); }
+		const_iterator cend() const noexcept { return end(); }
+		const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		const_reverse_iterator crend() const noexcept { return rend(); }
+
+		// capacity
+		[[nodiscard]] bool empty() const noexcept { return m_keys.empty(); }
+		size_type size() const noexcept { return static_cast<size_type>(m_keys.size()); }
+		size_type max_size() const noexcept { return static_cast<size_type>(m_keys.max_size()); }
+
+		// modifiers
+
+		// flat_set returns pair<iterator, bool>; flat_multiset returns the iterator and inserts after equivalent keys.
+		template <class... Args> auto emplace(Args&&... args) -> std::conditional_t<Multi, iterator, std::pair<iterator, bool>>
+		{
+			return insert_(value_type(std::forward<Args>(args)...));
+		}
+
+		// The hint is used when the new key belongs right before it; otherwise this is a plain emplace.
+		template <class... Args> iterator emplace_hint(const_iterator hint, Args&&... args)
+		{
+			value_type key(std::forward<Args>(args)...);
+			const auto i		  = static_cast<size_type>(hint - cbegin());
+			const bool after_prev  = i == 0 || (Multi ? !m_comp(key, key_at_(i - 1)) : m_comp(key_at_(i - 1), key));
+			const bool before_hint = i == size() || (Multi ? !m_comp(key_at_(i), key) : m_comp(key, key_at_(i)));
+			if (after_prev && before_hint) { return insert_at_(i, std::move(key)); }
+			if constexpr (Multi) { return insert_(std::move(key)); }
+			else { return insert_(std::move(key)).first; }
+		}
+
+		auto insert(const value_type& key) { return insert_(key); }
+		auto insert(value_type&& key) { return insert_(std::move(key)); }
+		template <class K, enable_if_transparent_t<K> = 0, bool M = Multi, class = std::enable_if_t<!M>> std::pair<iterator, bool> insert(K&& key)
+		{
+			return insert_(std::forward<K>(key));
+		}
+
+		iterator insert(const_iterator hint, const value_type& key) { return emplace_hint(hint, key); }
+		iterator insert(const_iterator hint, value_type&& key) { return emplace_hint(hint, std::move(key)); }
+
+		// Bulk insert: the new keys are collected, sorted once and merged with the existing ones in a single pass.
+		template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>> void insert(InputIt first, InputIt last)
+		{
+			insert_range_(first, last, false);
+		}
+
+		// Bulk insert of keys already sorted (and unique for flat_set); skips the sort.
+		template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>> void insert(sorted_tag, InputIt first, InputIt last)
+		{
+			insert_range_(first, last, true);
+		}
+
+		void insert(std::initializer_list<value_type> il) { insert(il.begin(), il.end()); }
+		void insert(sorted_tag tag, std::initializer_list<value_type> il) { insert(tag, il.begin(), il.end()); }
+
+		template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))> void insert_range(R&& rg)
+		{
+			insert_range_(std::begin(rg), std::end(rg), false);
+		}
+
+		// Moves the container out and leaves the set empty.
+		container_type extract() &&
+		{
+			container_type out = std::move(m_keys);
+			clear();
+			return out;
+		}
+
+		// Takes over a container that is already sorted (and unique for flat_set).
+		void replace(container_type&& keys)
+		{
+			m_keys = std::move(keys);
+			rebuild_index_();
+		}
+
+		iterator erase(const_iterator pos) { return erase_n_(static_cast<size_type>(pos - cbegin()), 1); }
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			return erase_n_(static_cast<size_type>(first - cbegin()), static_cast<size_type>(last - first));
+		}
+
+		size_type erase(const key_type& key) { return erase_key_(key); }
+
+		template <class K, enable_if_transparent_t<K> = 0, class = std::enable_if_t<!std::is_convertible_v<K&&, const_iterator>>> size_type erase(K&& key)
+		{
+			return erase_key_(key);
+		}
+
+		void swap(flat_set_impl& other) noexcept
+		{
+			using std::swap;
+			swap(m_keys, other.m_keys);
+			swap(m_comp, other.m_comp);
+			swap(m_index, other.m_index);
+		}
+
+		void clear() noexcept
+		{
+			m_keys.clear();
+			rebuild_index_();
+		}
+
+		// observers
+		key_compare key_comp() const { return m_comp; }
+		value_compare value_comp() const { return m_comp; }
+		const container_type& keys() const noexcept { return m_keys; }
+
+		// lookup
+		iterator find(const key_type& key) const { return iter_at_(find_index_(key)); }
+		template <class K, enable_if_transparent_t<K> = 0> iterator find(const K& key) const { return iter_at_(find_index_(key)); }
+
+		size_type count(const key_type& key) const { return count_(key); }
+		template <class K, enable_if_transparent_t<K> = 0> size_type count(const K& key) const { return count_(key); }
+
+		bool contains(const key_type& key) const { return find_index_(key) != size(); }
+		template <class K, enable_if_transparent_t<K> = 0> bool contains(const K& key) const { return find_index_(key) != size(); }
+
+		iterator lower_bound(const key_type& key) const { return iter_at_(lower_index_(key)); }
+		template <class K, enable_if_transparent_t<K> = 0> iterator lower_bound(const K& key) const { return iter_at_(lower_index_(key)); }
+
+		iterator upper_bound(const key_type& key) const { return iter_at_(upper_index_(key)); }
+		template <class K, enable_if_transparent_t<K> = 0> iterator upper_bound(const K& key) const { return iter_at_(upper_index_(key)); }
+
+		std::pair<iterator, iterator> equal_range(const key_type& key) const { return equal_range_(key); }
+		template <class K, enable_if_transparent_t<K> = 0> std::pair<iterator, iterator> equal_range(const K& key) const { return equal_range_(key); }
+
+		// comparisons
+		friend bool operator==(const flat_set_impl& a, const flat_set_impl& b)
+		{
+			return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+		}
+		friend bool operator!=(const flat_set_impl& a, const flat_set_impl& b) { return !(a == b); }
+		friend bool operator<(const flat_set_impl& a, const flat_set_impl& b)
+		{
+			return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+		}
+		friend bool operator>(const flat_set_impl& a, const flat_set_impl& b) { return b < a; }
+		friend bool operator<=(const flat_set_impl& a, const flat_set_impl& b) { return !(b < a); }
+		friend bool operator>=(const flat_set_impl& a, const flat_set_impl& b) { return !(a < b); }
+
+		friend void swap(flat_set_impl& a, flat_set_impl& b) noexcept { a.swap(b); }
+
+	private:
+		template <class C> static decltype(auto) at_(C& c, size_type i) { return c.begin()[static_cast<difference_type>(i)]; }
+
+		const key_type& key_at_(size_type i) const { return at_(m_keys, i); }
+		iterator iter_at_(size_type i) const { return begin() + static_cast<difference_type>(i); }
+
+		void rebuild_index_() noexcept { m_index.rebuild(m_keys); }
+
+		template <class K> size_type lower_index_(const K& key) const
+		{
+			return m_index.partition_point(m_keys, [&](const auto& k) { return static_cast<bool>(m_comp(k, key)); });
+		}
+
+		template <class K> size_type upper_index_(const K& key) const
+		{
+			return m_index.partition_point(m_keys, [&](const auto& k) { return !m_comp(key, k); });
+		}
+
+		// size() if absent
+		template <class K> size_type find_index_(const K& key) const
+		{
+			const size_type i = lower_index_(key);
+			return i != size() && !m_comp(key, key_at_(i)) ? i : size();
+		}
+
+		template <class K> size_type count_(const K& key) const
+		{
+			if constexpr (Multi) { return upper_index_(key) - lower_index_(key); }
+			else { return find_index_(key) != size() ? 1 : 0; }
+		}
+
+		template <class K> std::pair<iterator, iterator> equal_range_(const K& key) const
+		{
+			const size_type first = lower_index_(key);
+			size_type last		  = first;
+			if constexpr (Multi) { last = upper_index_(key); }
+			else if (first != size() && !m_comp(key, key_at_(first))) { last = first + 1; }
+			return { iter_at_(first), iter_at_(last) };
+		}
+
+		template <class K> auto insert_(K&& key) -> std::conditional_t<Multi, iterator, std::pair<iterator, bool>>
+		{
+			if constexpr (Multi) { return insert_at_(upper_index_(key), std::forward<K>(key)); }
+			else
+			{
+				const size_type i = lower_index_(key);
+				if (i != size() && !m_comp(key, key_at_(i))) { return { iter_at_(i), false }; }
+				return { insert_at_(i, std::forward<K>(key)), true };
+			}
+		}
+
+		template <class K> iterator insert_at_(size_type i, K&& key)
+		{
+			m_keys.emplace(m_keys.begin() + static_cast<difference_type>(i), std::forward<K>(key));
+			rebuild_index_();
+			return iter_at_(i);
+		}
+
+		iterator erase_n_(size_type i, size_type n)
+		{
+			const auto first = m_keys.begin() + static_cast<difference_type>(i);
+			m_keys.erase(first, first + static_cast<difference_type>(n));
+			rebuild_index_();
+			return iter_at_(i);
+		}
+
+		template <class K> size_type erase_key_(const K& key)
+		{
+			const size_type first = lower_index_(key);
+			const size_type last  = Multi ? upper_index_(key) : (first != size() && !m_comp(key, key_at_(first)) ? first + 1 : first);
+			if (first != last) erase_n_(first, last - first);
+			return last - first;
+		}
+
+		template <class InputIt> void insert_range_(InputIt first, InputIt last, bool sorted)
+		{
+			container_type fresh;
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+			{
+				reserve_if_possible(fresh, static_cast<size_type>(std::distance(first, last)));
+			}
+			for (; first != last; ++first) fresh.emplace_back(*first);
+			merge_in_(std::move(fresh), sorted);
+		}
+
+		// Merges fresh into the set. If anything throws the set is left empty, as with std::flat_set.
+		void merge_in_(container_type&& fresh, bool sorted)
+		{
+			try
+			{
+				if (!sorted && !std::is_sorted(fresh.begin(), fresh.end(), m_comp)) { std::stable_sort(fresh.begin(), fresh.end(), m_comp); }
+				const auto n = static_cast<size_type>(fresh.size());
+				if (n == 0) return;
+
+				// fresh is free of duplicates and belongs after every existing key: append it
+				if ((sorted || Multi) && (empty() || m_comp(key_at_(size() - 1), at_(fresh, 0))))
+				{
+					if (empty()) { m_keys = std::move(fresh); }
+					else
+					{
+						reserve_if_possible(m_keys, size() + n);
+						for (size_type i = 0; i < n; ++i) m_keys.emplace_back(std::move(at_(fresh, i)));
+					}
+				}
+				else
+				{
+					container_type out;
+					reserve_if_possible(out, size() + n);
+					merge_sorted_runs<!Multi>(
+						size(),
+						n,
+						[&](size_type i) -> const key_type& { return key_at_(i); },
+						[&](size_type j) -> const key_type& { return at_(fresh, j); },
+						m_comp,
+						[&](size_type i) { out.emplace_back(std::move(at_(m_keys, i))); },
+						[&](size_type j) { out.emplace_back(std::move(at_(fresh, j))); });
+					m_keys = std::move(out);
+				}
+			}
+			catch (...)
+			{
+				clear();
+				throw;
+			}
+			rebuild_index_();
+		}
+
+		container_type m_keys;
+		SNAP_NO_UNIQUE_ADDRESS_ATTR key_compare m_comp;
+		SNAP_NO_UNIQUE_ADDRESS_ATTR typename Search::template index<Key> m_index;
+	};
+} // namespace internal::detail
+
+// A sorted set stored in one contiguous container (C++23 std::flat_set). Search selects how lookups probe the keys
+// (default_search or eytzinger_search). With snap::inplace_vector as the container and default_search, lookups and
+// single-key inserts do not allocate; bulk inserts of unsorted input and eytzinger_search's index still do.
+//
+// Bulk inserts sort the new keys once and merge them in a single pass. If an insert throws the set may be left empty.
+template <class Key, class Compare = std::less<Key>, class KeyContainer = std::vector<Key>, class Search = default_search>
+class flat_set : public internal::detail::flat_set_impl<Key, Compare, KeyContainer, Search, false>
+{
+	using base = internal::detail::flat_set_impl<Key, Compare, KeyContainer, Search, false>;
+
+public:
+	using base::base;
+
+	flat_set() = default;
+
+	// Declared here rather than inherited so that class template argument deduction sees an initializer-list
+	// constructor for braced initialization.
+	flat_set(std::initializer_list<Key> il, const Compare& comp = Compare()) : base(il, comp) {}
+
+	flat_set& operator=(std::initializer_list<Key> il)
+	{
+		base::operator=(il);
+		return *this;
+	}
+
+	friend void swap(flat_set& a, flat_set& b) noexcept { a.swap(b); }
+};
+
+// flat_set that allows equivalent keys; they keep their insertion order.
+template <class Key, class Compare = std::less<Key>, class KeyContainer = std::vector<Key>, class Search = default_search>
+class flat_multiset : public internal::detail::flat_set_impl<Key, Compare, KeyContainer, Search, true>
+{
+	using base = internal::detail::flat_set_impl<Key, Compare, KeyContainer, Search, true>;
+
+public:
+	using base::base;
+
+	flat_multiset() = default;
+
+	// Declared here rather than inherited so that class template argument deduction sees an initializer-list
+	// constructor for braced initialization.
+	flat_multiset(std::initializer_list<Key> il, const Compare& comp = Compare()) : base(il, comp) {}
+
+	flat_multiset& operator=(std::initializer_list<Key> il)
+	{
+		base::operator=(il);
+		return *this;
+	}
+
+	friend void swap(flat_multiset& a, flat_multiset& b) noexcept { a.swap(b); }
+};
+
+// Deduction guides, as for std::flat_set and std::flat_multiset.
+template <class KeyContainer,
+		  class Compare = std::less<typename KeyContainer::value_type>,
+		  class			= std::enable_if_t<!internal::detail::is_iterator_v<KeyContainer>>>
+flat_set(KeyContainer, Compare = Compare()) -> flat_set<typename KeyContainer::value_type, Compare, KeyContainer>;
+
+template <class KeyContainer, class Compare = std::less<typename KeyContainer::value_type>>
+flat_set(sorted_unique_t, KeyContainer, Compare = Compare()) -> flat_set<typename KeyContainer::value_type, Compare, KeyContainer>;
+
+template <class InputIt, class Compare = std::less<internal::detail::iter_value_t<InputIt>>, class = std::enable_if_t<internal::detail::is_iterator_v<InputIt>>>
+flat_set(InputIt, InputIt, Compare = Compare()) -> flat_set<internal::detail::iter_value_t<InputIt>, Compare>;
+
+template <class InputIt, class Compare = std::less<internal::detail::iter_value_t<InputIt>>, class = std::enable_if_t<internal::detail::is_iterator_v<InputIt>>>
+flat_set(sorted_unique_t, InputIt, InputIt, Compare = Compare()) -> flat_set<internal::detail::iter_value_t<InputIt>, Compare>;
+
+template <class Key, class Compare = std::less<Key>> flat_set(std::initializer_list<Key>, Compare = Compare()) -> flat_set<Key, Compare>;
+
+template <class Key, class Compare = std::less<Key>> flat_set(sorted_unique_t, std::initializer_list<Key>, Compare = Compare()) -> flat_set<Key, Compare>;
+
+template <class KeyContainer,
+		  class Compare = std::less<typename KeyContainer::value_type>,
+		  class			= std::enable_if_t<!internal::detail::is_iterator_v<KeyContainer>>>
+flat_multiset(KeyContainer, Compare = Compare()) -> flat_multiset<typename KeyContainer::value_type, Compare, KeyContainer>;
+
+template <class KeyContainer, class Compare = std::less<typename KeyContainer::value_type>>
+flat_multiset(sorted_equivalent_t, KeyContainer, Compare = Compare()) -> flat_multiset<typename KeyContainer::value_type, Compare, KeyContainer>;
+
+template <class InputIt, class Compare = std::less<internal::detail::iter_value_t<InputIt>>, class = std::enable_if_t<internal::detail::is_iterator_v<InputIt>>>
+flat_multiset(InputIt, InputIt, Compare = Compare()) -> flat_multiset<internal::detail::iter_value_t<InputIt>, Compare>;
+
+template <class InputIt, class Compare = std::less<internal::detail::iter_value_t<InputIt>>, class = std::enable_if_t<internal::detail::is_iterator_v<InputIt>>>
+flat_multiset(sorted_equivalent_t, InputIt, InputIt, Compare = Compare()) -> flat_multiset<internal::detail::iter_value_t<InputIt>, Compare>;
+
+template <class Key, class Compare = std::less<Key>> flat_multiset(std::initializer_list<Key>, Compare = Compare()) -> flat_multiset<Key, Compare>;
+
+template <class Key, class Compare = std::less<Key>> flat_multiset(sorted_equivalent_t, std::initializer_list<Key>, Compare = Compare()) -> flat_multiset<Key, Compare>;
+
+namespace internal::detail
+{
+	template <class Set, class Pred> std::size_t flat_set_erase_if(Set& c, Pred pred)
+	{
+		auto keys			= std::move(c).extract();
+		const auto old_size = keys.size();
+		keys.erase(std::remove_if(keys.begin(), keys.end(), pred), keys.end());
+		const auto erased = static_cast<std::size_t>(old_size - keys.size());
+		c.replace(std::move(keys));
+		return erased;
+	}
+} // namespace internal::detail
+
+// Erases every key for which pred holds; returns how many were erased.
+template <class Key, class Compare, class KeyContainer, class Search, class Pred>
+std::size_t erase_if(flat_set<Key, Compare, KeyContainer, Search>& c, Pred pred)
+{
+	return internal::detail::flat_set_erase_if(c, pred);
+}
+
+template <class Key, class Compare, class KeyContainer, class Search, class Pred>
+std::size_t erase_if(flat_multiset<Key, Compare, KeyContainer, Search>& c, Pred pred)
+{
+	return internal::detail::flat_set_erase_if(c, pred);
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_FLAT_SET_HPP
@@ -0,0 +1,706 @@
+#ifndef SNP_INCLUDE_SNAP_HIVE_HPP
+#define SNP_INCLUDE_SNAP_HIVE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/raw_storage.hpp"
+#include "snap/internal/pp/no_unique_address.hpp"
+
+#include <algorithm> // std::fill_n, std::equal
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory> // std::allocator, std::allocator_traits
+#include <new>	  // placement new, std::launder
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+// Minimum and maximum number of elements per hive block.
+struct hive_limits
+{
+	std::size_t min;
+	std::size_t max;
+
+	constexpr hive_limits(std::size_t minimum, std::size_t maximum) noexcept : min(minimum), max(maximum) {}
+};
+
+// An unordered container of elements with stable addresses, after C++26's std::hive.
+//
+// Elements live in a doubly linked list of blocks. Each block has a skipfield: one counter per slot that is zero for
+// a live element, and holds the length of the run of erased slots at the first and last slot of that run (the
+// low-complexity jump-counting pattern). Iteration jumps over a whole run in one step. The first slot of each run
+// also holds the links of a per-block free list of runs, and the blocks that have runs are linked together, so
+// insertion reuses an erased slot in O(1) before it appends to the last block. Erasure is O(1) as well. A block whose
+// last element is erased is kept for reuse until trim_capacity().
+//
+// Insertion and erasure never move other elements: pointers, references and iterators to them stay valid until the
+// element is erased. Insertion order is not preserved.
+template <class T, class Alloc = std::allocator<T>> class hive
+{
+	using alloc_traits = std::allocator_traits<Alloc>;
+
+	static_assert(std::is_same_v<typename alloc_traits::value_type, T>, "Alloc::value_type must be T");
+
+	using skip_type = std::uint16_t;
+
+	static constexpr skip_type no_slot = std::numeric_limits<skip_type>::max();
+
+	// links of a run of erased slots, stored in the run's first slot
+	struct free_links
+	{
+		skip_type prev;
+		skip_type next;
+	};
+
+	using slot = internal::raw_storage<(sizeof(T) > sizeof(free_links) ? sizeof(T) : sizeof(free_links)),
+									   (alignof(T) > alignof(free_links) ? alignof(T) : alignof(free_links))>;
+
+	struct group
+	{
+		slot* slots;
+		skip_type* skip; // capacity + 1 counters; the one past high is always zero
+		group* prev;
+		group* next;
+		group* prev_free; // links of the groups that have erased slots
+		group* next_free;
+		std::size_t capacity;
+		std::size_t high; // slots [0, high) hold elements or erased runs
+		std::size_t size;
+		skip_type free_head;
+
+		T* element(std::size_t i) const noexcept { return std::launder(reinterpret_cast<T*>(slots[i].data())); }
+		free_links* links(std::size_t i) const noexcept { return std::launder(reinterpret_cast<free_links*>(slots[i].data())); }
+	};
+
+	using slot_alloc   = typename alloc_traits::template rebind_alloc<slot>;
+	using slot_traits  = typename alloc_traits::template rebind_traits<slot>;
+	using group_alloc  = typename alloc_traits::template rebind_alloc<group>;
+	using group_traits = typename alloc_traits::template rebind_traits<group>;
+
+	template <bool Const> class basic_iterator
+	{
+		friend class hive;
+
+		basic_iterator(group* g, std::size_t index) noexcept : m_group(g), m_index(index) {}
+
+		group* m_group		= nullptr;
+		std::size_t m_index = 0;
+
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type		= T;
+		using difference_type	= std::ptrdiff_t;
+		using pointer			= std::conditional_t<Const, const T*, T*>;
+		using reference			= std::conditional_t<Const, const T&, T&>;
+
+		basic_iterator() noexcept = default;
+
+		template <bool C = Const, class = std::enable_if_t<C>> basic_iterator(const basic_iterator<false>& other) noexcept
+			: m_group(other.m_group), m_index(other.m_index)
+		{
+		}
+
+		reference operator*() const noexcept { return *m_group->element(m_index); }
+		pointer operator->() const noexcept { return m_group->element(m_index); }
+
+		basic_iterator& operator++() noexcept
+		{
+			++m_index;
+			m_index += m_group->skip[m_index];
+			if (m_index == m_group->high && m_group->next != nullptr)
+			{
+				m_group = m_group->next;
+				m_index = m_group->skip[0];
+			}
+			return *this;
+		}
+
+		basic_iterator operator++(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		basic_iterator& operator--() noexcept
+		{
+			for (;;)
+			{
+				if (m_index != 0)
+				{
+					// the slot before a live one is live, or ends a run whose length it holds
+					const std::size_t prev = m_index - 1;
+					const std::size_t run  = m_group->skip[prev];
+					if (run <= prev)
+					{
+						m_index = prev - run;
+						return *this;
+					}
+				}
+				m_group = m_group->prev;
+				m_index = m_group->high;
+			}
+		}
+
+		basic_iterator operator--(int) noexcept
+		{
+			basic_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return a.m_group == b.m_group && a.m_index == b.m_index;
+		}
+		friend bool operator!=(const basic_iterator& a, const basic_iterator& b) noexcept { return !(a == b); }
+	};
+
+public:
+	// member types
+	using value_type			 = T;
+	using allocator_type		 = Alloc;
+	using size_type				 = std::size_t;
+	using difference_type		 = std::ptrdiff_t;
+	using reference				 = value_type&;
+	using const_reference		 = const value_type&;
+	using pointer				 = value_type*;
+	using const_pointer			 = const value_type*;
+	using iterator				 = basic_iterator<false>;
+	using const_iterator		 = basic_iterator<true>;
+	using reverse_iterator		 = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	// constructors
+	hive() noexcept(std::is_nothrow_default_constructible_v<Alloc>) : hive(Alloc()) {}
+
+	explicit hive(const Alloc& alloc) noexcept : m_alloc(alloc) {}
+
+	explicit hive(hive_limits limits, const Alloc& alloc = Alloc()) : hive(alloc) { set_limits_(limits); }
+
+	explicit hive(size_type count, const Alloc& alloc = Alloc()) : hive(alloc)
+	{
+		reserve(count);
+		for (; count != 0; --count) emplace();
+	}
+
+	hive(size_type count, const T& value, const Alloc& alloc = Alloc()) : hive(alloc) { insert(count, value); }
+
+	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+	hive(InputIt first, InputIt last, const Alloc& alloc = Alloc()) : hive(alloc)
+	{
+		insert(first, last);
+	}
+
+	hive(std::initializer_list<T> il, const Alloc& alloc = Alloc()) : hive(alloc) { insert(il.begin(), il.end()); }
+
+	hive(const hive& other) : hive(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+	{
+		m_min_block = other.m_min_block;
+		m_max_block = other.m_max_block;
+		insert(other.begin(), other.end());
+	}
+
+	hive(hive&& other) noexcept : m_alloc(std::move(other.m_alloc)) { take_(other); }
+
+	~hive()
+	{
+		clear();
+		trim_capacity();
+	}
+
+	// assignment
+	hive& operator=(const hive& rhs)
+	{
+		if (this == &rhs) return *this;
+		clear();
+		if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+		{
+			if (m_alloc != rhs.m_alloc) trim_capacity();
+			m_alloc = rhs.m_alloc;
+		}
+		insert(rhs.begin(), rhs.end());
+		return *this;
+	}
+
+	hive& operator=(hive&& rhs) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+	{
+		if (this == &rhs) return *this;
+		clear();
+		if (alloc_traits::propagate_on_container_move_assignment::value || m_alloc == rhs.m_alloc)
+		{
+			trim_capacity();
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value) { m_alloc = std::move(rhs.m_alloc); }
+			take_(rhs);
+		}
+		else
+		{
+			// unequal allocators that do not propagate: the blocks cannot change hands
+			insert(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+			rhs.clear();
+		}
+		return *this;
+	}
+
+	hive& operator=(std::initializer_list<T> il)
+	{
+		assign(il.begin(), il.end());
+		return *this;
+	}
+
+	void assign(size_type count, const T& value)
+	{
+		clear();
+		insert(count, value);
+	}
+
+	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>> void assign(InputIt first, InputIt last)
+	{
+		clear();
+		insert(first, last);
+	}
+
+	void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
+
+	[[nodiscard]] allocator_type get_allocator() const noexcept { return m_alloc; }
+
+	// iterators
+	iterator begin() noexcept { return m_front != nullptr ? iterator(m_front, m_front->skip[0]) : iterator(); }
+	const_iterator begin() const noexcept { return const_cast<hive*>(this)->begin(); }
+	const_iterator cbegin() const noexcept { return begin(); }
+	iterator end() noexcept { return m_back != nullptr ? iterator(m_back, m_back->high) : iterator(); }
+	const_iterator end() const noexcept { return const_cast<hive*>(this)->end(); }
+	const_iterator cend() const noexcept { return end(); }
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+	reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+	// Iterator to the element p points at, or end() if p does not point into this hive. O(number of blocks).
+	iterator get_iterator(const_pointer p) noexcept
+	{
+		const auto* bytes = reinterpret_cast<const std::byte*>(p);
+		for (group* g = m_front; g != nullptr; g = g->next)
+		{
+			const auto* first = reinterpret_cast<const std::byte*>(g->slots);
+			if (bytes < first || bytes >= first + g->high * sizeof(slot)) continue;
+			const auto index = static_cast<size_type>(bytes - first) / sizeof(slot);
+			return g->skip[index] == 0 ? iterator(g, index) : end();
+		}
+		return end();
+	}
+	const_iterator get_iterator(const_pointer p) const noexcept { return const_cast<hive*>(this)->get_iterator(p); }
+
+	// size & capacity
+	[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+	size_type size() const noexcept { return m_size; }
+	size_type capacity() const noexcept { return m_capacity; }
+	size_type max_size() const noexcept
+	{
+		const size_type by_alloc = alloc_traits::max_size(m_alloc);
+		const size_type by_diff	 = static_cast<size_type>(std::numeric_limits<difference_type>::max()) / sizeof(slot);
+		return by_alloc < by_diff ? by_alloc : by_diff;
+	}
+
+	hive_limits block_capacity_limits() const noexcept { return { m_min_block, m_max_block }; }
+	static constexpr hive_limits block_capacity_hard_limits() noexcept { return { 1, no_slot }; }
+
+	// Adds unused blocks until capacity() >= new_cap.
+	void reserve(size_type new_cap)
+	{
+		if (new_cap > max_size()) throw std::length_error("hive::reserve");
+		while (m_capacity < new_cap)
+		{
+			group* g = allocate_group_(clamp_block_(new_cap - m_capacity));
+			g->next	 = m_unused;
+			m_unused = g;
+		}
+	}
+
+	// Releases the blocks that hold no elements.
+	void trim_capacity() noexcept
+	{
+		while (m_unused != nullptr)
+		{
+			group* g = m_unused;
+			m_unused = g->next;
+			deallocate_group_(g);
+		}
+	}
+
+	// modifiers
+	void clear() noexcept
+	{
+		while (m_front != nullptr)
+		{
+			group* g = m_front;
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				for (size_type i = g->skip[0]; i < g->high; ++i, i += g->skip[i]) g->element(i)->~T();
+			}
+			m_front = g->next;
+			reset_group_(g);
+		}
+		m_back		  = nullptr;
+		m_free_groups = nullptr;
+		m_size		  = 0;
+	}
+
+	template <class... Args> iterator emplace(Args&&... args)
+	{
+		if (m_free_groups != nullptr) return emplace_in_run_(std::forward<Args>(args)...);
+		if (m_back == nullptr || m_back->high == m_back->capacity) add_back_group_();
+		group* g = m_back;
+		::new (static_cast<void*>(g->slots[g->high].data())) T(std::forward<Args>(args)...);
+		++g->size;
+		++m_size;
+		return iterator(g, g->high++);
+	}
+
+	template <class... Args> iterator emplace_hint(const_iterator /*hint*/, Args&&... args) { return emplace(std::forward<Args>(args)...); }
+
+	iterator insert(const T& value) { return emplace(value); }
+	iterator insert(T&& value) { return emplace(std::move(value)); }
+	iterator insert(const_iterator hint, const T& value) { return emplace_hint(hint, value); }
+	iterator insert(const_iterator hint, T&& value) { return emplace_hint(hint, std::move(value)); }
+
+	void insert(size_type count, const T& value)
+	{
+		reserve(m_size + count);
+		for (; count != 0; --count) emplace(value);
+	}
+
+	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>> void insert(InputIt first, InputIt last)
+	{
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+		{
+			reserve(m_size + static_cast<size_type>(std::distance(first, last)));
+		}
+		for (; first != last; ++first) emplace(*first);
+	}
+
+	void insert(std::initializer_list<T> il) { insert(il.begin(), il.end()); }
+
+	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))>
+	void insert_range(R&& rg)
+	{
+		insert(std::begin(rg), std::end(rg));
+	}
+
+	// Returns the iterator following pos.
+	iterator erase(const_iterator pos) noexcept
+	{
+		group* g			  = pos.m_group;
+		const size_type i	  = pos.m_index;
+		skip_type* const skip = g->skip;
+		g->element(i)->~T();
+		--m_size;
+
+		if (--g->size == 0)
+		{
+			group* next = g->next;
+			retire_group_(g);
+			return next != nullptr ? iterator(next, next->skip[0]) : end();
+		}
+
+		const bool left	 = i != 0 && skip[i - 1] != 0;
+		const bool right = i + 1 != g->high && skip[i + 1] != 0;
+		size_type start	 = i;
+		size_type run	 = 1;
+		if (left)
+		{
+			start = i - skip[i - 1];
+			run	  = size_type{ skip[i - 1] } + 1;
+		}
+		skip[i] = 1; // nonzero even when it ends up inside the run, which get_iterator relies on
+		if (right)
+		{
+			run += skip[i + 1];
+			if (left) { unlink_run_(g, *g->links(i + 1)); }
+			else { move_run_head_(g, i + 1, i); }
+		}
+		else if (!left) { push_run_(g, i); }
+		skip[start]			  = static_cast<skip_type>(run);
+		skip[start + run - 1] = static_cast<skip_type>(run);
+
+		const size_type next = start + run;
+		if (next == g->high && g->next != nullptr) return iterator(g->next, g->next->skip[0]);
+		return iterator(g, next);
+	}
+
+	iterator erase(const_iterator first, const_iterator last) noexcept
+	{
+		// erasing the last element of the back block moves end()
+		if (last == cend())
+		{
+			while (first != cend()) first = erase(first);
+			return end();
+		}
+		while (first != last) first = erase(first);
+		return iterator(last.m_group, last.m_index);
+	}
+
+	void swap(hive& other) noexcept
+	{
+		using std::swap;
+		if constexpr (alloc_traits::propagate_on_container_swap::value) { swap(m_alloc, other.m_alloc); }
+		swap(m_front, other.m_front);
+		swap(m_back, other.m_back);
+		swap(m_free_groups, other.m_free_groups);
+		swap(m_unused, other.m_unused);
+		swap(m_size, other.m_size);
+		swap(m_capacity, other.m_capacity);
+		swap(m_min_block, other.m_min_block);
+		swap(m_max_block, other.m_max_block);
+	}
+
+	// Moves the blocks holding other's elements into *this, in O(number of blocks). No element is copied or moved, so
+	// pointers to other's elements now point into *this. Precondition: get_allocator() == other.get_allocator().
+	void splice(hive& other) noexcept
+	{
+		if (this == &other || other.m_front == nullptr) return;
+		if (m_back != nullptr)
+		{
+			m_back->next		= other.m_front;
+			other.m_front->prev = m_back;
+		}
+		else { m_front = other.m_front; }
+		m_back = other.m_back;
+
+		while (other.m_free_groups != nullptr)
+		{
+			group* g = other.m_free_groups;
+			other.unlink_free_group_(g);
+			link_free_group_(g);
+		}
+		// other keeps its unused blocks
+		size_type moved = 0;
+		for (group* g = other.m_front; g != nullptr; g = g->next) moved += g->capacity;
+		m_size += std::exchange(other.m_size, 0);
+		m_capacity += moved;
+		other.m_capacity -= moved;
+		other.m_front = nullptr;
+		other.m_back  = nullptr;
+	}
+	void splice(hive&& other) noexcept { splice(other); }
+
+	friend bool operator==(const hive& a, const hive& b)
+	{
+		if (a.size() != b.size()) return false;
+		return std::equal(a.begin(), a.end(), b.begin());
+	}
+	friend bool operator!=(const hive& a, const hive& b) { return !(a == b); }
+
+	friend void swap(hive& a, hive& b) noexcept { a.swap(b); }
+
+private:
+	static size_type skip_slots_(size_type capacity) noexcept { return ((capacity + 1) * sizeof(skip_type) + sizeof(slot) - 1) / sizeof(slot); }
+
+	void set_limits_(hive_limits limits)
+	{
+		constexpr hive_limits hard = block_capacity_hard_limits();
+		if (limits.min > limits.max || limits.min < hard.min || limits.max > hard.max) throw std::length_error("hive: invalid block limits");
+		m_min_block = limits.min;
+		m_max_block = limits.max;
+	}
+
+	size_type clamp_block_(size_type n) const noexcept { return n < m_min_block ? m_min_block : (n > m_max_block ? m_max_block : n); }
+
+	group* allocate_group_(size_type capacity)
+	{
+		group_alloc ga(m_alloc);
+		group* g = group_traits::allocate(ga, 1);
+		slot* slots;
+		try
+		{
+			slot_alloc sa(m_alloc);
+			slots = slot_traits::allocate(sa, capacity + skip_slots_(capacity));
+		}
+		catch (...)
+		{
+			group_traits::deallocate(ga, g, 1);
+			throw;
+		}
+		auto* skip = reinterpret_cast<skip_type*>(slots + capacity);
+		for (size_type i = 0; i <= capacity; ++i) ::new (static_cast<void*>(skip + i)) skip_type(0);
+		::new (static_cast<void*>(g)) group{ slots, skip, nullptr, nullptr, nullptr, nullptr, capacity, 0, 0, no_slot };
+		m_capacity += capacity;
+		return g;
+	}
+
+	void deallocate_group_(group* g) noexcept
+	{
+		m_capacity -= g->capacity;
+		slot_alloc sa(m_alloc);
+		slot_traits::deallocate(sa, g->slots, g->capacity + skip_slots_(g->capacity));
+		group_alloc ga(m_alloc);
+		group_traits::deallocate(ga, g, 1);
+	}
+
+	// Links an unused block, or a new one sized to double the hive, after the back block.
+	void add_back_group_()
+	{
+		group* g;
+		if (m_unused != nullptr)
+		{
+			g		 = m_unused;
+			m_unused = g->next;
+		}
+		else { g = allocate_group_(clamp_block_(m_size)); }
+		g->prev = m_back;
+		g->next = nullptr;
+		if (m_back != nullptr) { m_back->next = g; }
+		else { m_front = g; }
+		m_back = g;
+	}
+
+	// Empties a block that holds no elements and moves it to the unused list.
+	void reset_group_(group* g) noexcept
+	{
+		std::fill_n(g->skip, g->high, skip_type{ 0 });
+		g->high		 = 0;
+		g->size		 = 0;
+		g->free_head = no_slot;
+		g->prev_free = nullptr;
+		g->next_free = nullptr;
+		g->prev		 = nullptr;
+		g->next		 = m_unused;
+		m_unused	 = g;
+	}
+
+	void retire_group_(group* g) noexcept
+	{
+		if (g->free_head != no_slot) unlink_free_group_(g);
+		if (g->prev != nullptr) { g->prev->next = g->next; }
+		else { m_front = g->next; }
+		if (g->next != nullptr) { g->next->prev = g->prev; }
+		else { m_back = g->prev; }
+		reset_group_(g);
+	}
+
+	void link_free_group_(group* g) noexcept
+	{
+		g->prev_free = nullptr;
+		g->next_free = m_free_groups;
+		if (m_free_groups != nullptr) m_free_groups->prev_free = g;
+		m_free_groups = g;
+	}
+
+	void unlink_free_group_(group* g) noexcept
+	{
+		if (g->prev_free != nullptr) { g->prev_free->next_free = g->next_free; }
+		else { m_free_groups = g->next_free; }
+		if (g->next_free != nullptr) g->next_free->prev_free = g->prev_free;
+	}
+
+	// Adds the run starting at index to the block's free list.
+	void push_run_(group* g, size_type index) noexcept
+	{
+		if (g->free_head == no_slot) { link_free_group_(g); }
+		else { g->links(g->free_head)->prev = static_cast<skip_type>(index); }
+		::new (static_cast<void*>(g->slots[index].data())) free_links{ no_slot, g->free_head };
+		g->free_head = static_cast<skip_type>(index);
+	}
+
+	void unlink_run_(group* g, free_links links) noexcept
+	{
+		if (links.prev != no_slot) { g->links(links.prev)->next = links.next; }
+		else { g->free_head = links.next; }
+		if (links.next != no_slot) g->links(links.next)->prev = links.prev;
+		if (g->free_head == no_slot) unlink_free_group_(g);
+	}
+
+	// Moves the free-list entry of the run starting at from so that the run starts at to.
+	void move_run_head_(group* g, size_type from, size_type to) noexcept
+	{
+		const free_links links = *g->links(from);
+		::new (static_cast<void*>(g->slots[to].data())) free_links(links);
+		if (links.prev != no_slot) { g->links(links.prev)->next = static_cast<skip_type>(to); }
+		else { g->free_head = static_cast<skip_type>(to); }
+		if (links.next != no_slot) g->links(links.next)->prev = static_cast<skip_type>(to);
+	}
+
+	// Constructs the element in the first slot of the first run of the first block with erased slots.
+	template <class... Args> iterator emplace_in_run_(Args&&... args)
+	{
+		group* g			   = m_free_groups;
+		const size_type index  = g->free_head;
+		const size_type run	   = g->skip[index];
+		const free_links links = *g->links(index);
+		try
+		{
+			::new (static_cast<void*>(g->slots[index].data())) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			::new (static_cast<void*>(g->slots[index].data())) free_links(links);
+			throw;
+		}
+		g->skip[index] = 0;
+		if (run == 1) { unlink_run_(g, links); }
+		else
+		{
+			// the run now starts one slot later
+			::new (static_cast<void*>(g->slots[index + 1].data())) free_links(links);
+			if (links.prev != no_slot) { g->links(links.prev)->next = static_cast<skip_type>(index + 1); }
+			else { g->free_head = static_cast<skip_type>(index + 1); }
+			if (links.next != no_slot) g->links(links.next)->prev = static_cast<skip_type>(index + 1);
+			g->skip[index + 1]		 = static_cast<skip_type>(run - 1);
+			g->skip[index + run - 1] = static_cast<skip_type>(run - 1);
+		}
+		++g->size;
+		++m_size;
+		return iterator(g, index);
+	}
+
+	void take_(hive& other) noexcept
+	{
+		m_front		  = std::exchange(other.m_front, nullptr);
+		m_back		  = std::exchange(other.m_back, nullptr);
+		m_free_groups = std::exchange(other.m_free_groups, nullptr);
+		m_unused	  = std::exchange(other.m_unused, nullptr);
+		m_size		  = std::exchange(other.m_size, 0);
+		m_capacity	  = std::exchange(other.m_capacity, 0);
+		m_min_block	  = other.m_min_block;
+		m_max_block	  = other.m_max_block;
+	}
+
+	group* m_front		  = nullptr;
+	group* m_back		  = nullptr;
+	group* m_free_groups  = nullptr; // blocks with erased slots
+	group* m_unused		  = nullptr; // blocks without elements, singly linked through next
+	size_type m_size	  = 0;
+	size_type m_capacity  = 0;
+	size_type m_min_block = 8;
+	size_type m_max_block = 8192;
+	SNAP_NO_UNIQUE_ADDRESS_ATTR Alloc m_alloc;
+};
+
+// non-member erase / erase_if
+template <class T, class Alloc, class Pred> typename hive<T, Alloc>::size_type erase_if(hive<T, Alloc>& c, Pred pred)
+{
+	const auto old_size = c.size();
+	for (auto it = c.begin(); it != c.end();)
+	{
+		if (pred(*it)) { it = c.erase(it); }
+		else { ++it; }
+	}
+	return old_size - c.size();
+}
+
+template <class T, class Alloc, class U> typename hive<T, Alloc>::size_type erase(hive<T, Alloc>& c, const U& value)
+{
+	return erase_if(c, [&](const T& element) { return element == value; });
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_HIVE_HPP
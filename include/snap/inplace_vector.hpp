@@ -4,21 +4,101 @@
 // Must be included first
 #include "snap/internal/abi_namespace.hpp"
 
+#include "snap/internal/compat/constexpr.hpp"
 #include "snap/internal/helpers/raw_storage.hpp"
-
-#include <algorithm> // std::move, std::move_backward, std::lexicographical_compare
+#include "snap/iterator/is_contiguous_iterator.hpp"
+#include "snap/memory/relocate.hpp"
+#include "snap/memory/to_address.hpp"
+#include "snap/meta/detector.hpp"
+#include "snap/type_traits/is_constant_evaluated.hpp"
+#include "snap/type_traits/is_trivially_relocatable.hpp"
+#include "snap/type_traits/remove_cvref.hpp"
+
+#include <algorithm> // std::move, std::move_backward, std::lexicographical_compare, std::swap_ranges, std::rotate
 #include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy, std::memmove
 #include <initializer_list>
 #include <iterator>
-#include <memory>	 // std::unique_ptr
 #include <new>		 // std::launder, placement new
 #include <stdexcept> // std::bad_alloc, std::out_of_range
 #include <type_traits>
 #include <utility> // std::swap, std::move, std::addressof
 
 SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	// Element storage, left uninitialized. Trivial element types live in a real T array so that C++20 constant
+	// evaluation can use the container; everything else gets raw bytes and placement new.
+	template <class T, std::size_t N, bool = std::is_trivial_v<T>> struct inplace_vector_storage
+	{
+		T elems[N];
+
+		constexpr T* data() noexcept { return elems; }
+		constexpr const T* data() const noexcept { return elems; }
+	};
+
+	template <class T, std::size_t N> struct inplace_vector_storage<T, N, false>
+	{
+		raw_storage_for<T> elems[N];
+
+		T* data() noexcept { return std::launder(reinterpret_cast<T*>(elems)); }
+		const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(elems)); }
+	};
+
+	template <class R> using range_data_t = decltype(std::data(std::declval<R&>()));
+	template <class R> using range_size_t = decltype(std::size(std::declval<R&>()));
+
+	// Ranges whose length is known without walking them.
+	template <class R> inline constexpr bool is_sized_range_v = is_detected_v<range_size_t, R>;
+
+	// Sized ranges exposing their elements through a pointer (span, array, vector, string, initializer_list, ...).
+	template <class R> inline constexpr bool is_contiguous_range_v = is_sized_range_v<R> && std::is_pointer_v<detected_or_t<void, range_data_t, R>>;
+
+	// Iterators whose elements may be copied with memcpy. is_contiguous_iterator's random-access fallback also accepts
+	// iterators like std::deque's, so only pointers and iterators that declare a contiguous iterator_concept count.
+	template <class It>
+	inline constexpr bool is_memcpy_iterator_v = std::is_pointer_v<It> || (is_contiguous_iterator_v<It> && details::iter_concept_is_contiguous_v<It>);
+
+	// Smallest unsigned type able to count to N; keeps e.g. inplace_vector<char, 15> at 16 bytes.
+	template <std::size_t N>
+	using inplace_vector_size_t = std::conditional_t<
+		N <= UINT8_MAX,
+		std::uint8_t,
+		std::conditional_t<N <= UINT16_MAX, std::uint16_t, std::conditional_t<N <= UINT32_MAX, std::uint32_t, std::size_t>>>;
+
+	// Storage plus size. The counter goes after the elements so it only adds padding up to alignof(T).
+	// The destructor only exists when T needs one, so an inplace_vector of a trivially destructible T is itself
+	// trivially destructible.
+	template <class T, std::size_t N, bool = std::is_trivially_destructible_v<T>> struct inplace_vector_base
+	{
+		using size_counter = inplace_vector_size_t<N>;
+
+		inplace_vector_storage<T, N> m_storage;
+		size_counter m_size = 0;
+	};
+
+	template <class T, std::size_t N> struct inplace_vector_base<T, N, false>
+	{
+		using size_counter = inplace_vector_size_t<N>;
+
+		inplace_vector_base() = default;
+		inplace_vector_base(const inplace_vector_base&) = delete;
+		inplace_vector_base& operator=(const inplace_vector_base&) = delete;
+
+		~inplace_vector_base()
+		{
+			for (T* p = m_storage.data() + m_size; p != m_storage.data();) (--p)->~T();
+		}
+
+		inplace_vector_storage<T, N> m_storage;
+		size_counter m_size = 0;
+	};
+} // namespace internal::detail
+
 // primary template (N > 0)
-template <class T, std::size_t N> struct inplace_vector
+template <class T, std::size_t N> struct inplace_vector : private internal::detail::inplace_vector_base<T, N>
 {
 	static_assert(N > 0, "Primary template is for N > 0; N==0 has a specialization");
 	static_assert(std::is_move_constructible_v<T> && std::is_move_assignable_v<T>, "T must be MoveConstructible and MoveAssignable");
@@ -42,340 +122,228 @@ template <class T, std::size_t N> struct inplace_vector
 	// constructors
 
 	// (1) Constructs an empty inplace_vector whose data() == nullptr and size() == 0.
-	constexpr inplace_vector() noexcept = default;
+	//     User-provided so that value-initialization (V v{}, new V(), V()) does not zero the storage first.
+	constexpr inplace_vector() noexcept {}
 
 	// (2) Constructs an inplace_vector with count default-inserted elements.
-	explicit inplace_vector(size_type count)
+	SNAP_CONSTEXPR20 explicit inplace_vector(size_type count)
 	{
-		if (count > N) throw std::bad_alloc();
-		construct_n_default(count);
-		m_size = count;
+		require_capacity(count);
+		construct_tail_(count);
 	}
 
 	// (3) Constructs an inplace_vector with count copies of elements with value value.
-	inplace_vector(size_type count, const T& value)
+	SNAP_CONSTEXPR20 inplace_vector(size_type count, const T& value)
 	{
-		if (count > N) throw std::bad_alloc();
-		size_type i = 0;
-		try
-		{
-			for (; i < count; ++i) ::new (static_cast<void*>(base() + i)) T(value);
-			m_size = count;
-		}
-		catch (...)
-		{
-			while (i > 0)
-			{
-				--i;
-				(base()[i]).~T();
-			}
-			throw;
-		}
+		require_capacity(count);
+		construct_tail_(count, value);
 	}
 
 	// (4) Constructs an inplace_vector with the contents of the range [first, last).
-	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>> inplace_vector(InputIt first, InputIt last)
+	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>> SNAP_CONSTEXPR20 inplace_vector(InputIt first, InputIt last)
 	{
-		size_type i = 0;
-		try
-		{
-			for (; first != last; ++first)
-			{
-				if (i == N) throw std::bad_alloc();
-				::new (static_cast<void*>(base() + i)) T(*first);
-				++i;
-			}
-			m_size = i;
-		}
-		catch (...)
-		{
-			while (i > 0)
-			{
-				--i;
-				(base()[i]).~T();
-			}
-			throw;
-		}
+		append_(first, last);
 	}
 
 	// (5) Constructs an inplace_vector with the contents of the range rg.
-	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))> explicit inplace_vector(R&& rg)
+	template <class R,
+			  class B = decltype(std::begin(std::declval<R&>())),
+			  class E = decltype(std::end(std::declval<R&>())),
+			  class	  = std::enable_if_t<!std::is_same_v<remove_cvref_t<R>, inplace_vector>>>
+	SNAP_CONSTEXPR20 explicit inplace_vector(R&& rg)
 	{
-		auto it		= std::begin(rg);
-		auto end	= std::end(rg);
-		size_type i = 0;
-		try
-		{
-			for (; it != end; ++it)
-			{
-				if (i == N) throw std::bad_alloc();
-				::new (static_cast<void*>(base() + i)) T(*it);
-				++i;
-			}
-			m_size = i;
-		}
-		catch (...)
-		{
-			while (i > 0)
-			{
-				--i;
-				(base()[i]).~T();
-			}
-			throw;
-		}
+		append_range_(rg);
 	}
 
 	// (6) A copy constructor. Constructs an inplace_vector with the copy of the contents of other.
-	//     The constructor is a trivial copy constructor if N > 0 and std::is_trivially_copy_constructible_v<T> are both true.
-	constexpr inplace_vector(const inplace_vector& other)
+	//     Trivially copyable elements are copied with one memcpy of size() elements rather than the whole buffer.
+	SNAP_CONSTEXPR20 inplace_vector(const inplace_vector& other)
 	{
-		require_capacity(other.m_size);
-		size_type i = 0;
-		try
+		if constexpr (std::is_trivially_copyable_v<T>)
 		{
-			for (; i < other.m_size; ++i) ::new (static_cast<void*>(base() + i)) T(other.base()[i]);
+			copy_trivial_(base(), other.base(), other.m_size);
 			m_size = other.m_size;
 		}
-		catch (...)
-		{
-			while (i > 0)
-			{
-				--i;
-				(base()[i]).~T();
-			}
-			throw;
-		}
+		else { construct_from_(other.base(), other.m_size); }
 	}
 
-	constexpr inplace_vector(std::initializer_list<T> il)
+	SNAP_CONSTEXPR20 inplace_vector(std::initializer_list<T> il)
 	{
 		require_capacity(il.size());
-		size_type i = 0;
-		try
-		{
-			for (const T& v : il)
-			{
-				::new (static_cast<void*>(base() + i)) T(v);
-				++i;
-			}
-			m_size = il.size();
-		}
-		catch (...)
+		if constexpr (std::is_trivially_copyable_v<T>)
 		{
-			while (i > 0)
-			{
-				--i;
-				(base()[i]).~T();
-			}
-			throw;
+			copy_trivial_(base(), il.begin(), il.size());
+			set_size_(il.size());
 		}
+		else { construct_from_(il.begin(), il.size()); }
 	}
 
-	inplace_vector(inplace_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	// (7) A move constructor. Trivially copyable elements are copied and the source is left as is; trivially
+	//     relocatable elements are relocated with one memmove and the source is left empty; otherwise the elements
+	//     are moved and the source is cleared.
+	SNAP_CONSTEXPR20 inplace_vector(inplace_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
 	{
-		require_capacity(other.m_size);
-		if constexpr (std::is_nothrow_move_constructible<T>::value)
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			copy_trivial_(base(), other.base(), other.m_size);
+			m_size = other.m_size;
+		}
+		else if constexpr (is_trivially_relocatable_v<T>)
 		{
-			for (size_type i = 0; i < other.m_size; ++i) ::new (static_cast<void*>(base() + i)) T(std::move(other.base()[i]));
+			SNAP_NAMESPACE::uninitialized_relocate(other.base(), other.base() + other.m_size, base());
 			m_size = other.m_size;
-			other.destroy_all_();
-			other.m_size = 0;
+			other.set_size_(0);
 		}
 		else
 		{
-			size_type i = 0;
-			try
-			{
-				for (; i < other.m_size; ++i) ::new (static_cast<void*>(base() + i)) T(std::move(other.base()[i]));
-				m_size = other.m_size;
-				other.destroy_all_();
-				other.m_size = 0;
-			}
-			catch (...)
-			{
-				while (i > 0)
-				{
-					--i;
-					(base()[i]).~T();
-				}
-				throw;
-			}
+			construct_from_(std::make_move_iterator(other.base()), other.m_size);
+			other.clear();
 		}
 	}
 
-	// destructor
-	~inplace_vector() { destroy_all_(); }
-
 	// assignment ops
-	inplace_vector& operator=(const inplace_vector& rhs)
+	SNAP_CONSTEXPR20 inplace_vector& operator=(const inplace_vector& rhs)
 	{
 		if (this == &rhs) return *this;
-		assign(rhs.begin(), rhs.end());
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			copy_trivial_(base(), rhs.base(), rhs.m_size);
+			m_size = rhs.m_size;
+		}
+		else { assign_n_(rhs.base(), rhs.m_size); }
 		return *this;
 	}
 
-	inplace_vector& operator=(inplace_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+	SNAP_CONSTEXPR20 inplace_vector& operator=(inplace_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value &&
+																			  std::is_nothrow_move_assignable<T>::value)
 	{
 		if (this == &rhs) return *this;
-		clear();
-		if constexpr (std::is_nothrow_move_constructible<T>::value)
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			copy_trivial_(base(), rhs.base(), rhs.m_size);
+			m_size = rhs.m_size;
+		}
+		else if constexpr (is_trivially_relocatable_v<T>)
 		{
-			require_capacity(rhs.m_size);
-			for (size_type i = 0; i < rhs.m_size; ++i) ::new (static_cast<void*>(base() + i)) T(std::move(rhs.base()[i]));
+			destroy_(base(), base() + m_size);
+			SNAP_NAMESPACE::uninitialized_relocate(rhs.base(), rhs.base() + rhs.m_size, base());
 			m_size = rhs.m_size;
-			rhs.destroy_all_();
-			rhs.m_size = 0;
+			rhs.set_size_(0);
 		}
 		else
 		{
-			size_type i = 0;
-			require_capacity(rhs.m_size);
-			try
-			{
-				for (; i < rhs.m_size; ++i) ::new (static_cast<void*>(base() + i)) T(std::move(rhs.base()[i]));
-				m_size = rhs.m_size;
-				rhs.destroy_all_();
-				rhs.m_size = 0;
-			}
-			catch (...)
-			{
-				while (i > 0)
-				{
-					--i;
-					(base()[i]).~T();
-				}
-				throw;
-			}
+			assign_n_(std::make_move_iterator(rhs.base()), rhs.m_size);
+			rhs.clear();
 		}
 		return *this;
 	}
 
-	inplace_vector& operator=(std::initializer_list<T> il)
+	SNAP_CONSTEXPR20 inplace_vector& operator=(std::initializer_list<T> il)
 	{
 		assign(il.begin(), il.end());
 		return *this;
 	}
 
 	// assign overloads
-	void assign(size_type count, const T& value)
+	SNAP_CONSTEXPR20 void assign(size_type count, const T& value)
 	{
-		if (count > N) throw std::bad_alloc();
-		// overwrite or construct up to min(count, m_size)
-		size_type i = 0;
-		for (; i < m_size && i < count; ++i) base()[i] = value;
-		if (i < count)
-		{ // need to grow
-			size_type j = i;
-			try
-			{
-				for (; j < count; ++j) ::new (static_cast<void*>(base() + j)) T(value);
-				// destroy excess if shrinking
-				for (size_type k = m_size; k > count; --k) (base()[k - 1]).~T();
-				m_size = count;
-			}
-			catch (...)
-			{
-				while (j > i)
-				{
-					--j;
-					(base()[j]).~T();
-				}
-				throw;
-			}
-		}
+		require_capacity(count);
+		const size_type common = count < m_size ? count : m_size;
+		for (size_type i = 0; i < common; ++i) base()[i] = value;
+		if (count > m_size) { construct_tail_(count, value); }
 		else
-		{ // shrink
-			for (size_type k = m_size; k > count; --k) (base()[k - 1]).~T();
-			m_size = count;
+		{
+			destroy_(base() + count, base() + m_size);
+			set_size_(count);
 		}
 	}
 
-	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>> void assign(InputIt first, InputIt last)
+	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>> SNAP_CONSTEXPR20 void assign(InputIt first, InputIt last)
 	{
-		// collect into a local temp buffer up to N without heap
-		size_type collected = 0;
-		using tmp_t			= internal::raw_storage_for<T>;
-		tmp_t tmp[N];
-		T* buf = std::launder(reinterpret_cast<T*>(tmp));
-		try
+		if constexpr (is_forward_iterator_v<InputIt>)
 		{
-			for (; first != last; ++first)
+			const auto count = static_cast<size_type>(std::distance(first, last));
+			require_capacity(count);
+			assign_sized_(first, count);
+		}
+		else
+		{
+			// collect into a local temp buffer up to N without heap
+			size_type collected = 0;
+			using tmp_t			= internal::raw_storage_for<T>;
+			tmp_t tmp[N];
+			T* buf = std::launder(reinterpret_cast<T*>(tmp));
+			try
 			{
-				if (collected == N)
-				{ // more elements exist -> capacity exceeded
-					while (collected > 0)
-					{
-						--collected;
-						buf[collected].~T();
-					}
-					throw std::bad_alloc();
+				for (; first != last; ++first)
+				{
+					if (collected == N) throw std::bad_alloc(); // more elements exist -> capacity exceeded
+					::new (static_cast<void*>(buf + collected)) T(*first);
+					++collected;
 				}
-				::new (static_cast<void*>(buf + collected)) T(*first);
-				++collected;
+				// commit
+				clear();
+				construct_from_(std::make_move_iterator(buf), collected);
+				destroy_(buf, buf + collected);
 			}
-			// commit
-			clear();
-			for (size_type i = 0; i < collected; ++i) ::new (static_cast<void*>(base() + i)) T(std::move(buf[i]));
-			m_size = collected;
-			while (collected > 0)
+			catch (...)
 			{
-				--collected;
-				buf[collected].~T();
+				destroy_(buf, buf + collected);
+				throw;
 			}
 		}
-		catch (...)
-		{
-			while (collected > 0)
-			{
-				--collected;
-				buf[collected].~T();
-			}
-			throw;
-		}
 	}
 
-	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))> void assign_range(R&& rg)
+	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))>
+	SNAP_CONSTEXPR20 void assign_range(R&& rg)
 	{
-		assign(std::begin(rg), std::end(rg));
+		if constexpr (internal::detail::is_sized_range_v<R>)
+		{
+			const auto count = static_cast<size_type>(std::size(rg));
+			require_capacity(count);
+			if constexpr (internal::detail::is_contiguous_range_v<R>) { assign_sized_(std::data(rg), count); }
+			else { assign_sized_(std::begin(rg), count); }
+		}
+		else { assign(std::begin(rg), std::end(rg)); }
 	}
 
 	// element access
-	reference at(size_type pos)
+	constexpr reference at(size_type pos)
 	{
 		if (pos >= m_size) throw std::out_of_range("inplace_vector::at");
 		return base()[pos];
 	}
-	const_reference at(size_type pos) const
+	constexpr const_reference at(size_type pos) const
 	{
 		if (pos >= m_size) throw std::out_of_range("inplace_vector::at");
 		return base()[pos];
 	}
 
-	reference operator[](size_type pos) noexcept { return base()[pos]; }
-	const_reference operator[](size_type pos) const noexcept { return base()[pos]; }
+	constexpr reference operator[](size_type pos) noexcept { return base()[pos]; }
+	constexpr const_reference operator[](size_type pos) const noexcept { return base()[pos]; }
 
-	reference front() noexcept { return base()[0]; }
-	const_reference front() const noexcept { return base()[0]; }
+	constexpr reference front() noexcept { return base()[0]; }
+	constexpr const_reference front() const noexcept { return base()[0]; }
 
-	reference back() noexcept { return base()[m_size - 1]; }
-	const_reference back() const noexcept { return base()[m_size - 1]; }
+	constexpr reference back() noexcept { return base()[m_size - 1]; }
+	constexpr const_reference back() const noexcept { return base()[m_size - 1]; }
 
-	pointer data() noexcept { return m_size ? base() : nullptr; } // allowed to be null when empty
-	const_pointer data() const noexcept { return m_size ? base() : nullptr; }
+	constexpr pointer data() noexcept { return m_size ? base() : nullptr; } // allowed to be null when empty
+	constexpr const_pointer data() const noexcept { return m_size ? base() : nullptr; }
 
 	// iterators
-	iterator begin() noexcept { return base(); }
-	const_iterator begin() const noexcept { return base(); }
-	const_iterator cbegin() const noexcept { return base(); }
-	iterator end() noexcept { return base() + m_size; }
-	const_iterator end() const noexcept { return base() + m_size; }
-	const_iterator cend() const noexcept { return base() + m_size; }
-	reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
-	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
-	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
-	reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
-	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
-	const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+	constexpr iterator begin() noexcept { return base(); }
+	constexpr const_iterator begin() const noexcept { return base(); }
+	constexpr const_iterator cbegin() const noexcept { return base(); }
+	constexpr iterator end() noexcept { return base() + m_size; }
+	constexpr const_iterator end() const noexcept { return base() + m_size; }
+	constexpr const_iterator cend() const noexcept { return base() + m_size; }
+	constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+	constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+	constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
 
 	// size & capacity (static)
 	constexpr size_type size() const noexcept { return m_size; }
@@ -387,129 +355,101 @@ template <class T, std::size_t N> struct inplace_vector
 	static constexpr void shrink_to_fit() noexcept { /* no-op */ }
 
 	// modifiers
-	void clear() noexcept { destroy_all_(); }
+	constexpr void clear() noexcept
+	{
+		destroy_(base(), base() + m_size);
+		m_size = 0;
+	}
 
 	// pop_back: precondition !empty(); UB otherwise (like std containers in non-hardened mode)
-	void pop_back() noexcept
+	constexpr void pop_back() noexcept
 	{
-		(base()[m_size - 1]).~T();
 		--m_size;
+		destroy_(base() + m_size, base() + m_size + 1);
 	}
 
 	// push_back / try_push_back / unchecked_push_back
-	void push_back(const T& v)
+	constexpr void push_back(const T& v)
 	{
 		if (m_size == N) throw std::bad_alloc();
-		::new (static_cast<void*>(base() + m_size)) T(v);
+		construct_(base() + m_size, v);
 		++m_size;
 	}
 
-	void push_back(T&& v)
+	constexpr void push_back(T&& v)
 	{
 		if (m_size == N) throw std::bad_alloc();
-		::new (static_cast<void*>(base() + m_size)) T(std::move(v));
+		construct_(base() + m_size, std::move(v));
 		++m_size;
 	}
 
-	pointer try_push_back(const T& v)
+	constexpr pointer try_push_back(const T& v)
 	{
 		if (m_size == N) return nullptr;
-		::new (static_cast<void*>(base() + m_size)) T(v);
+		construct_(base() + m_size, v);
 		return base() + (m_size++);
 	}
 
-	pointer try_push_back(T&& v)
+	constexpr pointer try_push_back(T&& v)
 	{
 		if (m_size == N) return nullptr;
-		::new (static_cast<void*>(base() + m_size)) T(std::move(v));
+		construct_(base() + m_size, std::move(v));
 		return base() + (m_size++);
 	}
 
-	reference unchecked_push_back(const T& v)
+	constexpr reference unchecked_push_back(const T& v)
 	{
-		::new (static_cast<void*>(base() + m_size)) T(v);
+		construct_(base() + m_size, v);
 		return base()[m_size++];
 	}
 
-	reference unchecked_push_back(T&& v)
+	constexpr reference unchecked_push_back(T&& v)
 	{
-		::new (static_cast<void*>(base() + m_size)) T(std::move(v));
+		construct_(base() + m_size, std::move(v));
 		return base()[m_size++];
 	}
 
 	// emplace_back variants
-	template <class... Args> reference emplace_back(Args&&... args)
+	template <class... Args> constexpr reference emplace_back(Args&&... args)
 	{
 		if (m_size == N) throw std::bad_alloc();
-		::new (static_cast<void*>(base() + m_size)) T(std::forward<Args>(args)...);
+		construct_(base() + m_size, std::forward<Args>(args)...);
 		return base()[m_size++];
 	}
 
-	template <class... Args> pointer try_emplace_back(Args&&... args)
+	template <class... Args> constexpr pointer try_emplace_back(Args&&... args)
 	{
 		if (m_size == N) return nullptr;
-		::new (static_cast<void*>(base() + m_size)) T(std::forward<Args>(args)...);
+		construct_(base() + m_size, std::forward<Args>(args)...);
 		return base() + (m_size++);
 	}
 
-	template <class... Args> reference unchecked_emplace_back(Args&&... args)
+	template <class... Args> constexpr reference unchecked_emplace_back(Args&&... args)
 	{
-		::new (static_cast<void*>(base() + m_size)) T(std::forward<Args>(args)...);
+		construct_(base() + m_size, std::forward<Args>(args)...);
 		return base()[m_size++];
 	}
 
 	// resize
-	void resize(size_type count)
+	SNAP_CONSTEXPR20 void resize(size_type count)
 	{
-		if (count > N) throw std::bad_alloc();
-		if (count > m_size)
-		{
-			size_type i = m_size;
-			try
-			{
-				for (; i < count; ++i) ::new (static_cast<void*>(base() + i)) T();
-				m_size = count;
-			}
-			catch (...)
-			{
-				while (i > m_size)
-				{
-					--i;
-					(base()[i]).~T();
-				}
-				throw;
-			}
-		}
+		require_capacity(count);
+		if (count > m_size) { construct_tail_(count); }
 		else
 		{
-			while (m_size > count) pop_back();
+			destroy_(base() + count, base() + m_size);
+			set_size_(count);
 		}
 	}
 
-	void resize(size_type count, const T& value)
+	SNAP_CONSTEXPR20 void resize(size_type count, const T& value)
 	{
-		if (count > N) throw std::bad_alloc();
-		if (count > m_size)
-		{
-			size_type i = m_size;
-			try
-			{
-				for (; i < count; ++i) ::new (static_cast<void*>(base() + i)) T(value);
-				m_size = count;
-			}
-			catch (...)
-			{
-				while (i > m_size)
-				{
-					--i;
-					(base()[i]).~T();
-				}
-				throw;
-			}
-		}
+		require_capacity(count);
+		if (count > m_size) { construct_tail_(count, value); }
 		else
 		{
-			while (m_size > count) pop_back();
+			destroy_(base() + count, base() + m_size);
+			set_size_(count);
 		}
 	}
 
@@ -517,301 +457,188 @@ template <class T, std::size_t N> struct inplace_vector
 	iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
 	iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
 
+	// Trivially relocatable elements make room with one memmove; otherwise the copies are appended and rotated into
+	// place. Either way the contents are unchanged if a copy throws.
 	iterator insert(const_iterator pos, size_type count, const T& value)
 	{
-		if (count == 0) return const_cast<iterator>(pos);
-		require_capacity(m_size + count);
-		size_type idx  = static_cast<size_type>(pos - cbegin());
-		size_type tail = m_size - idx;
-
-		// phase 1: move-construct tail into new positions (rollback on throw)
-		size_type moved = 0;
-		try
+		const auto idx = static_cast<size_type>(pos - cbegin());
+		require_room_(count);
+		if constexpr (is_trivially_relocatable_v<T>)
 		{
-			for (; moved < tail; ++moved) { ::new (static_cast<void*>(base() + m_size + count - 1 - moved)) T(std::move(base()[m_size - 1 - moved])); }
+			if (count == 0) return base() + idx;
+			// value may be one of the elements about to move
+			const T copy(value);
+			open_gap_(idx, count);
+			construct_in_gap_(idx, count, [&](pointer p) { construct_(p, copy); });
 		}
-		catch (...)
-		{
-			while (moved > 0)
-			{
-				--moved;
-				(base()[m_size + count - 1 - moved]).~T();
-			}
-			throw;
-		}
-
-		// phase 2: construct inserted values (rollback: destroy inserted+new tail)
-		size_type built = 0;
-		try
-		{
-			for (; built < count; ++built) ::new (static_cast<void*>(base() + idx + built)) T(value);
-		}
-		catch (...)
+		else
 		{
-			while (built > 0)
-			{
-				--built;
-				(base()[idx + built]).~T();
-			}
-			while (moved > 0)
-			{
-				--moved;
-				(base()[m_size + count - 1 - moved]).~T();
-			}
-			throw;
+			const size_type old = m_size;
+			construct_tail_(m_size + count, value);
+			std::rotate(base() + idx, base() + old, base() + m_size);
 		}
-
-		// phase 3: destroy original tail in [idx, m_size)
-		for (size_type k = 0; k < tail; ++k) (base()[idx + k]).~T();
-
-		m_size += count;
 		return base() + idx;
 	}
 
-	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>> iterator insert(const_iterator pos, InputIt first, InputIt last)
+	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+	SNAP_CONSTEXPR20 iterator insert(const_iterator pos, InputIt first, InputIt last)
 	{
-		// If we can measure distance (forward iterators), do so for strong capacity check
-		using cat = typename std::iterator_traits<InputIt>::iterator_category;
-		if (std::is_base_of<std::forward_iterator_tag, cat>::value)
-		{
-			size_type cnt = static_cast<size_type>(std::distance(first, last));
-			if (cnt == 0) return const_cast<iterator>(pos);
-			if (m_size + cnt > N) throw std::bad_alloc();
-			// collect into temp buffer (no heap), then insert(count, values...)
-			using tmp_t = internal::raw_storage_for<T>;
-			tmp_t tmpbuf[cnt > 0 ? cnt : 1]; // VLA not allowed; cnt>0 here
-			T* tmp			= std::launder(reinterpret_cast<T*>(tmpbuf));
-			size_type built = 0;
-			try
-			{
-				for (; first != last; ++first)
-				{
-					::new (static_cast<void*>(tmp + built)) T(*first);
-					++built;
-				}
-				insert(pos, built, tmp[0]); // insert count copies of first—wrong
-											// The above would duplicate the first value only; instead we need element-wise placement:
-											// Roll back that approach; do a proper block insert below.
-			}
-			catch (...)
-			{
-				while (built > 0)
-				{
-					--built;
-					(tmp[built]).~T();
-				}
-				throw;
-			}
-		}
-
-		// Fallback for input iterators (single-pass): insert one-by-one
-		size_type idx = static_cast<size_type>(pos - cbegin());
-		for (; first != last; ++first)
+		if constexpr (is_forward_iterator_v<InputIt>) { return insert_n_(pos, first, static_cast<size_type>(std::distance(first, last))); }
+		else
 		{
-			pos = emplace(cbegin() + idx, *first);
-			++idx;
+			// single pass: build the new elements behind the old ones, then rotate them into place
+			const auto idx		= static_cast<size_type>(pos - cbegin());
+			const size_type old = m_size;
+			append_input_(first, last);
+			std::rotate(base() + idx, base() + old, base() + m_size);
+			return base() + idx;
 		}
-		return const_cast<iterator>(pos) - (last == first ? 0 : 0);
 	}
 
 	// Range overload (anything with begin/end)
 	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))>
-	iterator insert_range(const_iterator pos, R&& rg)
+	SNAP_CONSTEXPR20 iterator insert_range(const_iterator pos, R&& rg)
 	{
-		return insert(pos, std::begin(rg), std::end(rg));
+		if constexpr (internal::detail::is_contiguous_range_v<R>) { return insert_n_(pos, std::data(rg), static_cast<size_type>(std::size(rg))); }
+		else if constexpr (internal::detail::is_sized_range_v<R>) { return insert_n_(pos, std::begin(rg), static_cast<size_type>(std::size(rg))); }
+		else { return insert(pos, std::begin(rg), std::end(rg)); }
 	}
 
+	// The new element is built before anything moves, so args may refer to an element and the contents are unchanged
+	// if its constructor throws.
 	template <class... Args> iterator emplace(const_iterator pos, Args&&... args)
 	{
-		if (m_size == N) throw std::bad_alloc();
-		size_type idx  = static_cast<size_type>(pos - cbegin());
-		size_type tail = m_size - idx;
-
-		// move-construct tail into new slot
-		size_type moved = 0;
-		try
+		const auto idx = static_cast<size_type>(pos - cbegin());
+		require_room_(1);
+		if (idx == m_size)
 		{
-			for (; moved < tail; ++moved) { ::new (static_cast<void*>(base() + m_size - moved)) T(std::move(base()[m_size - 1 - moved])); }
+			unchecked_emplace_back(std::forward<Args>(args)...);
+			return base() + idx;
 		}
-		catch (...)
+		if constexpr (is_trivially_relocatable_v<T>)
 		{
-			while (moved > 0)
-			{
-				--moved;
-				(base()[m_size - moved]).~T();
-			}
-			throw;
+			internal::raw_storage_for<T> slot;
+			T* element = ::new (slot.data()) T(std::forward<Args>(args)...);
+			open_gap_(idx, 1);
+			SNAP_NAMESPACE::relocate_at(element, base() + idx);
+			set_size_(m_size + 1);
 		}
-
-		// construct new element
-		try
+		else
 		{
-			::new (static_cast<void*>(base() + idx)) T(std::forward<Args>(args)...);
+			T element(std::forward<Args>(args)...);
+			const size_type old = m_size;
+			construct_(base() + old, std::move(base()[old - 1]));
+			set_size_(old + 1);
+			std::move_backward(base() + idx, base() + old - 1, base() + old);
+			base()[idx] = std::move(element);
 		}
-		catch (...)
-		{
-			// roll back moved tail
-			while (moved > 0)
-			{
-				--moved;
-				(base()[m_size - moved]).~T();
-			}
-			throw;
-		}
-
-		// destroy original element at idx (was moved-from)
-		if (tail > 0) (base()[idx]).~T();
-		++m_size;
 		return base() + idx;
 	}
 
-	// append_range (range + iterator-pair) — throws bad_alloc if not enough space
-	template <class InputIt> void append_range(InputIt first, InputIt last)
+	// append_range (range + iterator-pair) — throws bad_alloc if not enough space, leaving the contents unchanged
+	template <class InputIt> SNAP_CONSTEXPR20 void append_range(InputIt first, InputIt last) { append_(first, last); }
+
+	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))>
+	SNAP_CONSTEXPR20 void append_range(R&& rg)
 	{
-		// collect into temp up to avail; throw if more
-		size_type avail			 = N - m_size;
-		using tmp_t				 = internal::raw_storage_for<T>;
-		const size_type temp_cap = (avail > 0) ? avail : 1;
-		auto tmp				 = std::make_unique<tmp_t[]>(temp_cap);
-		T* buf					 = std::launder(reinterpret_cast<T*>(tmp.get()));
-		size_type built			 = 0;
-		try
+		append_range_(rg);
+	}
+
+	// try_append_range: returns iterator to first not-inserted (or end of range)
+	template <class InputIt> SNAP_CONSTEXPR20 InputIt try_append_range(InputIt first, InputIt last)
+	{
+		if constexpr (is_forward_iterator_v<InputIt>)
 		{
-			for (; first != last; ++first)
-			{
-				if (built == avail)
-				{ // still more elements → capacity exceeded
-					while (built > 0)
-					{
-						--built;
-						(buf[built]).~T();
-					}
-					throw std::bad_alloc();
-				}
-				::new (static_cast<void*>(buf + built)) T(*first);
-				++built;
-			}
-			for (size_type i = 0; i < built; ++i) unchecked_emplace_back(std::move(buf[i]));
-			while (built > 0)
-			{
-				--built;
-				(buf[built]).~T();
-			}
+			const size_type count = std::min(static_cast<size_type>(std::distance(first, last)), N - m_size);
+			append_n_(first, count);
+			return std::next(first, static_cast<difference_type>(count));
 		}
-		catch (...)
+		else
 		{
-			while (built > 0)
-			{
-				--built;
-				(buf[built]).~T();
-			}
-			throw;
+			for (; first != last && m_size < N; ++first) unchecked_emplace_back(*first);
+			return first;
 		}
 	}
-	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))> void append_range(R&& rg)
-	{
-		append_range(std::begin(rg), std::end(rg));
-	}
 
-	// try_append_range: returns iterator to first not-inserted (or end of range)
-	template <class InputIt> InputIt try_append_range(InputIt first, InputIt last)
-	{
-		for (; first != last && m_size < N; ++first) unchecked_emplace_back(*first);
-		return first;
-	}
-	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))> auto try_append_range(R&& rg)
-		-> decltype(std::begin(rg))
+	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))>
+	SNAP_CONSTEXPR20 auto try_append_range(R&& rg) -> decltype(std::begin(rg))
 	{
-		auto it	 = std::begin(rg);
-		auto end = std::end(rg);
-		for (; it != end && m_size < N; ++it) unchecked_emplace_back(*it);
-		return it;
+		if constexpr (internal::detail::is_contiguous_range_v<R>)
+		{
+			const size_type count = std::min(static_cast<size_type>(std::size(rg)), N - m_size);
+			append_n_(std::data(rg), count);
+			return std::next(std::begin(rg), static_cast<difference_type>(count));
+		}
+		else { return try_append_range(std::begin(rg), std::end(rg)); }
 	}
 
-	// erase
-	iterator erase(const_iterator pos)
-	{
-		size_type idx = static_cast<size_type>(pos - cbegin());
-		(base()[idx]).~T();
-		// move-assign down the tail
-		for (size_type i = idx; i + 1 < m_size; ++i) base()[i] = std::move(base()[i + 1]);
-		--m_size;
-		return base() + idx;
-	}
+	// erase; trivially relocatable elements behind the erased ones slide down with one memmove
+	iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
 
 	iterator erase(const_iterator first, const_iterator last)
 	{
-		size_type i_first = static_cast<size_type>(first - cbegin());
-		size_type i_last  = static_cast<size_type>(last - cbegin());
+		const auto i_first = static_cast<size_type>(first - cbegin());
+		const auto i_last  = static_cast<size_type>(last - cbegin());
 		if (i_first >= i_last) return base() + i_first;
-		size_type count = i_last - i_first;
-		// destroy erased block
-		for (size_type i = i_first; i < i_last; ++i) (base()[i]).~T();
-		// slide tail down
-		for (size_type i = i_last; i < m_size; ++i) base()[i - count] = std::move(base()[i]);
-		m_size -= count;
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			destroy_(base() + i_first, base() + i_last);
+			SNAP_NAMESPACE::uninitialized_relocate(base() + i_last, base() + m_size, base() + i_first);
+		}
+		else
+		{
+			pointer new_end = std::move(base() + i_last, base() + m_size, base() + i_first);
+			destroy_(new_end, base() + m_size);
+		}
+		set_size_(m_size - (i_last - i_first));
 		return base() + i_first;
 	}
 
 	// swap: invalidates all iterators (per spec)
-	void swap(inplace_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value && noexcept(std::swap(std::declval<T&>(), std::declval<T&>())))
+	SNAP_CONSTEXPR20 void swap(inplace_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value &&
+															   noexcept(std::swap(std::declval<T&>(), std::declval<T&>())))
 	{
 		if (this == &other) return;
 		// swap up to min size
-		size_type i = 0;
 		size_type m = m_size < other.m_size ? m_size : other.m_size;
-		for (; i < m; ++i) std::swap(base()[i], other.base()[i]);
+		std::swap_ranges(base(), base() + m, other.base());
+
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			// the extra tail of the larger one is copied over in one go; nothing to destroy
+			if (m_size > other.m_size) { copy_trivial_(other.base() + m, base() + m, m_size - m); }
+			else { copy_trivial_(base() + m, other.base() + m, other.m_size - m); }
+			std::swap(m_size, other.m_size);
+			return;
+		}
+		else if constexpr (is_trivially_relocatable_v<T>)
+		{
+			// the extra tail changes owner bytewise
+			if (m_size > other.m_size) { SNAP_NAMESPACE::uninitialized_relocate(base() + m, base() + m_size, other.base() + m); }
+			else { SNAP_NAMESPACE::uninitialized_relocate(other.base() + m, other.base() + other.m_size, base() + m); }
+			std::swap(m_size, other.m_size);
+			return;
+		}
 
 		// move extra tail from larger to smaller
 		if (m_size > other.m_size)
 		{
 			size_type extra = m_size - other.m_size;
-			// construct in other
-			size_type j = 0;
-			try
-			{
-				for (; j < extra; ++j) ::new (static_cast<void*>(other.base() + other.m_size + j)) T(std::move(base()[m + j]));
-				// destroy our moved-from extras
-				for (size_type k = 0; k < extra; ++k) (base()[m + k]).~T();
-				other.m_size += extra;
-				m_size -= extra;
-			}
-			catch (...)
-			{
-				// best-effort rollback: destroy constructed in other
-				while (j > 0)
-				{
-					--j;
-					(other.base()[other.m_size + j]).~T();
-				}
-				throw;
-			}
+			other.construct_from_(std::make_move_iterator(base() + m), extra);
+			destroy_(base() + m, base() + m_size);
+			set_size_(m);
 		}
 		else if (other.m_size > m_size)
 		{
 			size_type extra = other.m_size - m_size;
-			size_type j		= 0;
-			try
-			{
-				for (; j < extra; ++j) ::new (static_cast<void*>(base() + m_size + j)) T(std::move(other.base()[m + j]));
-				for (size_type k = 0; k < extra; ++k) (other.base()[m + k]).~T();
-				m_size += extra;
-				other.m_size -= extra;
-			}
-			catch (...)
-			{
-				while (j > 0)
-				{
-					--j;
-					(base()[m_size + j]).~T();
-				}
-				throw;
-			}
+			construct_from_(std::make_move_iterator(other.base() + m), extra);
+			destroy_(other.base() + m, other.base() + other.m_size);
+			other.set_size_(m);
 		}
 	}
 
 	// comparisons (C++17: operator== and lexicographic < only)
-	friend bool operator==(const inplace_vector& a, const inplace_vector& b)
+	friend constexpr bool operator==(const inplace_vector& a, const inplace_vector& b)
 	{
 		if (a.m_size != b.m_size) return false;
 		for (size_type i = 0; i < a.m_size; ++i)
@@ -819,51 +646,267 @@ template <class T, std::size_t N> struct inplace_vector
 		return true;
 	}
 
-	friend bool operator!=(const inplace_vector& a, const inplace_vector& b) { return !(a == b); }
+	friend constexpr bool operator!=(const inplace_vector& a, const inplace_vector& b) { return !(a == b); }
 
-	friend bool operator<(const inplace_vector& a, const inplace_vector& b) { return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()); }
+	friend SNAP_CONSTEXPR20 bool operator<(const inplace_vector& a, const inplace_vector& b)
+	{
+		return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+	}
 
 	// friend ADL swap
-	friend void swap(inplace_vector& a, inplace_vector& b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
+	friend SNAP_CONSTEXPR20 void swap(inplace_vector& a, inplace_vector& b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
 
 private:
-	// aligned storage
-	using storage_t = internal::raw_storage_for<T>;
-	storage_t m_storage[N]{};
-	size_type m_size = 0;
+	using base_type = internal::detail::inplace_vector_base<T, N>;
+	using base_type::m_size;
+	using base_type::m_storage;
 
 	// raw base pointer (independent of m_size)
-	pointer base() noexcept { return std::launder(reinterpret_cast<pointer>(m_storage)); }
-	const_pointer base() const noexcept { return std::launder(reinterpret_cast<const_pointer>(m_storage)); }
+	constexpr pointer base() noexcept { return m_storage.data(); }
+	constexpr const_pointer base() const noexcept { return m_storage.data(); }
+
+	template <class It>
+	static constexpr bool is_forward_iterator_v = std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+	// Sources that can be block-copied into the storage.
+	template <class It>
+	static constexpr bool is_memcpy_source_v = std::is_trivially_copyable_v<T> && internal::detail::is_memcpy_iterator_v<It> &&
+											   std::is_same_v<std::remove_cv_t<typename std::iterator_traits<It>::value_type>, T>;
 
-	static void require_capacity(size_type need)
+	constexpr void set_size_(size_type n) noexcept { m_size = static_cast<typename base_type::size_counter>(n); }
+
+	static constexpr void require_capacity(size_type need)
 	{
 		if (need > N) throw std::bad_alloc();
 	}
 
-	void construct_n_default(size_type n)
+	constexpr void require_room_(size_type extra) const
 	{
-		size_type i = 0;
+		if (extra > N - m_size) throw std::bad_alloc();
+	}
+
+	template <class... Args> static constexpr void construct_(pointer p, Args&&... args)
+	{
+		if constexpr (std::is_trivial_v<T> && std::is_constructible_v<T, Args...>)
+		{
+			// placement new is not usable in constant evaluation; the storage of a trivial T already holds live objects
+			if (is_constant_evaluated())
+			{
+				*p = T(std::forward<Args>(args)...);
+				return;
+			}
+		}
+		::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+	}
+
+	// destroys [first, last) back to front
+	static constexpr void destroy_(pointer first, pointer last) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			while (last != first) (--last)->~T();
+		}
+	}
+
+	// Copies n trivially copyable elements with a single memcpy of exactly n * sizeof(T) bytes.
+	static constexpr void copy_trivial_(pointer dst, const_pointer src, size_type n) noexcept
+	{
+		if constexpr (std::is_trivial_v<T>)
+		{
+			if (is_constant_evaluated())
+			{
+				for (size_type i = 0; i < n; ++i) construct_(dst + i, src[i]);
+				return;
+			}
+		}
+		if (n != 0) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+	}
+
+	// Grows to count elements constructed from args; on exception the new elements are destroyed again.
+	template <class... Args> SNAP_CONSTEXPR20 void construct_tail_(size_type count, const Args&... args)
+	{
+		size_type i = m_size;
+		try
+		{
+			for (; i < count; ++i) construct_(base() + i, args...);
+		}
+		catch (...)
+		{
+			destroy_(base() + m_size, base() + i);
+			throw;
+		}
+		set_size_(count);
+	}
+
+	// Appends n elements read from first; on exception the new elements are destroyed again.
+	template <class It> SNAP_CONSTEXPR20 void construct_from_(It first, size_type n)
+	{
+		const size_type count = m_size + n;
+		size_type i			  = m_size;
 		try
 		{
-			for (; i < n; ++i) ::new (static_cast<void*>(base() + i)) T();
+			for (; i < count; ++i, ++first) construct_(base() + i, *first);
 		}
 		catch (...)
 		{
-			while (i > 0)
+			destroy_(base() + m_size, base() + i);
+			throw;
+		}
+		set_size_(count);
+	}
+
+	// Appends n elements read from first; the caller has checked the capacity. Contiguous trivially copyable
+	// sources are copied with one memcpy, the rest element by element with rollback on exception.
+	template <class It> SNAP_CONSTEXPR20 void append_n_(It first, size_type n)
+	{
+		if constexpr (is_memcpy_source_v<It>)
+		{
+			copy_trivial_(base() + m_size, SNAP_NAMESPACE::to_address(first), n);
+			set_size_(m_size + n);
+		}
+		else { construct_from_(first, n); }
+	}
+
+	// Appends [first, last) one element at a time, for sources of unknown length. On overflow or exception the new
+	// elements are destroyed again and the contents are unchanged.
+	template <class It> SNAP_CONSTEXPR20 void append_input_(It first, It last)
+	{
+		size_type i = m_size;
+		try
+		{
+			for (; first != last; ++first)
 			{
-				--i;
-				(base()[i]).~T();
+				if (i == N) throw std::bad_alloc();
+				construct_(base() + i, *first);
+				++i;
 			}
+		}
+		catch (...)
+		{
+			destroy_(base() + m_size, base() + i);
 			throw;
 		}
+		set_size_(i);
 	}
 
-	void destroy_all_() noexcept
+	// Appends [first, last) with a single capacity check whenever the length can be measured up front.
+	template <class It> SNAP_CONSTEXPR20 void append_(It first, It last)
 	{
-		for (size_type i = m_size; i > 0; --i) (base()[i - 1]).~T();
-		m_size = 0;
+		if constexpr (is_forward_iterator_v<It>)
+		{
+			const auto n = static_cast<size_type>(std::distance(first, last));
+			require_room_(n);
+			append_n_(first, n);
+		}
+		else { append_input_(first, last); }
+	}
+
+	template <class R> SNAP_CONSTEXPR20 void append_range_(R& rg)
+	{
+		if constexpr (internal::detail::is_contiguous_range_v<R>)
+		{
+			const auto n = static_cast<size_type>(std::size(rg));
+			require_room_(n);
+			append_n_(std::data(rg), n);
+		}
+		else if constexpr (internal::detail::is_sized_range_v<R>)
+		{
+			const auto n = static_cast<size_type>(std::size(rg));
+			require_room_(n);
+			append_n_(std::begin(rg), n);
+		}
+		else { append_(std::begin(rg), std::end(rg)); }
+	}
+
+	// Replaces the contents with n elements read from first; the caller has checked the capacity.
+	template <class It> SNAP_CONSTEXPR20 void assign_sized_(It first, size_type n)
+	{
+		if constexpr (is_memcpy_source_v<It>)
+		{
+			// trivially copyable implies trivially destructible, so the old elements can simply be overwritten
+			copy_trivial_(base(), SNAP_NAMESPACE::to_address(first), n);
+			set_size_(n);
+		}
+		else { assign_n_(first, n); }
+	}
+
+	// Relocates [idx, size()) up by n slots, leaving n uninitialized slots at idx; size() is not changed.
+	void open_gap_(size_type idx, size_type n) noexcept
+	{
+		static_assert(is_trivially_relocatable_v<T>);
+		SNAP_NAMESPACE::uninitialized_relocate_backward(base() + idx, base() + m_size, base() + m_size + n);
+	}
+
+	// Fills the gap opened by open_gap_(idx, n) by calling construct(p) for each slot and grows by n. If a construction
+	// throws, the new elements are destroyed and the tail is relocated back, leaving the contents unchanged.
+	template <class Construct> void construct_in_gap_(size_type idx, size_type n, Construct construct)
+	{
+		pointer gap	 = base() + idx;
+		size_type i = 0;
+		try
+		{
+			for (; i < n; ++i) construct(gap + i);
+		}
+		catch (...)
+		{
+			destroy_(gap, gap + i);
+			SNAP_NAMESPACE::uninitialized_relocate(gap + n, base() + m_size + n, gap);
+			throw;
+		}
+		set_size_(m_size + n);
 	}
+
+	// Inserts n elements read from first before pos. Trivially relocatable elements open the gap with one memmove
+	// and the new ones are written straight into it; otherwise the new elements are appended and rotated into place.
+	// Either way the contents are unchanged if a construction throws.
+	template <class It> SNAP_CONSTEXPR20 iterator insert_n_(const_iterator pos, It first, size_type n)
+	{
+		const auto idx = static_cast<size_type>(pos - cbegin());
+		require_room_(n);
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (!is_constant_evaluated())
+			{
+				open_gap_(idx, n);
+				if constexpr (is_memcpy_source_v<It>)
+				{
+					copy_trivial_(base() + idx, SNAP_NAMESPACE::to_address(first), n);
+					set_size_(m_size + n);
+				}
+				else
+				{
+					construct_in_gap_(idx, n, [&](pointer p) {
+						construct_(p, *first);
+						++first;
+					});
+				}
+				return base() + idx;
+			}
+		}
+		const size_type old = m_size;
+		append_n_(first, n);
+		std::rotate(base() + idx, base() + old, base() + m_size);
+		return base() + idx;
+	}
+
+	// Replaces the contents with n elements read from first, reusing live elements by assignment.
+	template <class It> SNAP_CONSTEXPR20 void assign_n_(It first, size_type n)
+	{
+		const size_type common = n < m_size ? n : m_size;
+		for (size_type i = 0; i < common; ++i, ++first) base()[i] = *first;
+		if (n > m_size) { construct_from_(first, n - m_size); }
+		else
+		{
+			destroy_(base() + n, base() + m_size);
+			set_size_(n);
+		}
+	}
+};
+
+
+// An inplace_vector holds no pointers into itself, so it relocates exactly when its elements do.
+template <class T, std::size_t N> struct is_trivially_relocatable<inplace_vector<T, N>> : is_trivially_relocatable<T>
+{
 };
 
 // zero-capacity specialization (N == 0)
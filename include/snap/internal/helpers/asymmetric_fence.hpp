@@ -0,0 +1,31 @@
+#ifndef SNP_INCLUDE_SNAP_INTERNAL_HELPERS_ASYMMETRIC_FENCE_HPP
+#define SNP_INCLUDE_SNAP_INTERNAL_HELPERS_ASYMMETRIC_FENCE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include <atomic>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	// Set once the process-wide barrier (membarrier / FlushProcessWriteBuffers) is known to work. Never cleared.
+	inline std::atomic<bool> asymmetric_fence_native{ false };
+
+	// Heavy side of an asymmetric fence pair. Acts as a seq_cst fence on every running thread of the process
+	// when the OS supports it, and as a local seq_cst fence otherwise.
+	void asymmetric_thread_fence_heavy() noexcept;
+
+	// Light side, paired with asymmetric_thread_fence_heavy(). Only a compiler barrier once the heavy side is native,
+	// so read paths (hazard pointer publication, RCU read-side entry) avoid a hardware fence.
+	inline void asymmetric_thread_fence_light() noexcept
+	{
+		if (asymmetric_fence_native.load(std::memory_order_relaxed)) { std::atomic_signal_fence(std::memory_order_seq_cst); }
+		else { std::atomic_thread_fence(std::memory_order_seq_cst); }
+	}
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_INTERNAL_HELPERS_ASYMMETRIC_FENCE_HPP
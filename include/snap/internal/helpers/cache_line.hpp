@@ -0,0 +1,25 @@
+#ifndef SNP_INCLUDE_SNAP_INTERNAL_HELPERS_CACHE_LINE_HPP
+#define SNP_INCLUDE_SNAP_INTERNAL_HELPERS_CACHE_LINE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include <cstddef>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal
+{
+	// Fixed stand-in for std::hardware_destructive_interference_size.
+	// The standard constant is ABI-unstable (GCC warns when it leaks into headers), so we pin our own.
+	// Apple silicon and POWER use 128-byte lines; everything else we target uses 64.
+#if (defined(__APPLE__) && (defined(__aarch64__) || defined(__arm64__))) || defined(__powerpc64__) || defined(__ppc64__)
+	inline constexpr std::size_t cache_line_size = 128;
+#else
+	inline constexpr std::size_t cache_line_size = 64;
+#endif
+} // namespace internal
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_INTERNAL_HELPERS_CACHE_LINE_HPP
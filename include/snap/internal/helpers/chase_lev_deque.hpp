@@ -0,0 +1,127 @@
+#ifndef SNP_INCLUDE_SNAP_INTERNAL_HELPERS_CHASE_LEV_DEQUE_HPP
+#define SNP_INCLUDE_SNAP_INTERNAL_HELPERS_CHASE_LEV_DEQUE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/cache_line.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal
+{
+	// Chase-Lev work-stealing deque of pointers (Le, Pop, Cohen, Zappa Nardelli, "Correct and Efficient
+	// Work-Stealing for Weak Memory Models", PPoPP 2013).
+	// One owner thread pushes and pops at the bottom; any thread may steal from the top.
+	// The ring grows by doubling; superseded rings are kept until destruction because a thief may still read them.
+	template <class T> class chase_lev_deque
+	{
+		static_assert(std::is_pointer_v<T>, "chase_lev_deque stores pointers");
+
+		struct ring
+		{
+			explicit ring(std::int64_t cap) : capacity(cap), mask(cap - 1), slots(std::make_unique<std::atomic<T>[]>(static_cast<std::size_t>(cap))) {}
+
+			T get(std::int64_t i) const noexcept { return slots[static_cast<std::size_t>(i & mask)].load(std::memory_order_relaxed); }
+			void put(std::int64_t i, T v) noexcept { slots[static_cast<std::size_t>(i & mask)].store(v, std::memory_order_relaxed); }
+
+			std::int64_t capacity;
+			std::int64_t mask;
+			std::unique_ptr<std::atomic<T>[]> slots;
+		};
+
+	public:
+		explicit chase_lev_deque(std::int64_t initial_capacity = 256)
+		{
+			rings_.push_back(std::make_unique<ring>(initial_capacity));
+			ring_.store(rings_.back().get(), std::memory_order_relaxed);
+		}
+
+		chase_lev_deque(const chase_lev_deque&)			   = delete;
+		chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+		// Owner only. May allocate when the ring is full.
+		void push(T value)
+		{
+			const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+			const std::int64_t t = top_.load(std::memory_order_acquire);
+			ring* r				 = ring_.load(std::memory_order_relaxed);
+
+			if (b - t > r->capacity - 1) { r = grow(r, b, t); }
+
+			r->put(b, value);
+			std::atomic_thread_fence(std::memory_order_release);
+			bottom_.store(b + 1, std::memory_order_relaxed);
+		}
+
+		// Owner only. Returns nullptr when empty.
+		T pop() noexcept
+		{
+			const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+			ring* r				 = ring_.load(std::memory_order_relaxed);
+			bottom_.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t t = top_.load(std::memory_order_relaxed);
+
+			T value = nullptr;
+			if (t <= b)
+			{
+				value = r->get(b);
+				if (t == b)
+				{
+					// Last element: race the thieves for it.
+					if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) { value = nullptr; }
+					bottom_.store(b + 1, std::memory_order_relaxed);
+				}
+			}
+			else { bottom_.store(b + 1, std::memory_order_relaxed); }
+			return value;
+		}
+
+		// Any thread. Returns nullptr when empty or when another thread won the race.
+		T steal() noexcept
+		{
+			std::int64_t t = top_.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+			if (t >= b) { return nullptr; }
+
+			ring* r		  = ring_.load(std::memory_order_acquire);
+			const T value = r->get(t);
+			if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) { return nullptr; }
+			return value;
+		}
+
+		// A racy hint; exact only when called by the owner with no concurrent thieves.
+		[[nodiscard]] bool empty() const noexcept { return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed); }
+
+	private:
+		ring* grow(ring* old, std::int64_t b, std::int64_t t)
+		{
+			auto bigger = std::make_unique<ring>(old->capacity * 2);
+			for (std::int64_t i = t; i < b; ++i) { bigger->put(i, old->get(i)); }
+
+			ring* r = bigger.get();
+			rings_.push_back(std::move(bigger));
+			ring_.store(r, std::memory_order_release);
+			return r;
+		}
+
+		alignas(cache_line_size) std::atomic<std::int64_t> top_{ 0 };
+		alignas(cache_line_size) std::atomic<std::int64_t> bottom_{ 0 };
+		std::atomic<ring*> ring_{ nullptr };
+		std::vector<std::unique_ptr<ring>> rings_; // owner only
+	};
+} // namespace internal
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_INTERNAL_HELPERS_CHASE_LEV_DEQUE_HPP
@@ -0,0 +1,58 @@
+#ifndef SNP_INCLUDE_SNAP_INTERNAL_HELPERS_EVENT_COUNT_HPP
+#define SNP_INCLUDE_SNAP_INTERNAL_HELPERS_EVENT_COUNT_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/atomic_helpers.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal
+{
+	// Lets threads park until a condition kept elsewhere (such as "the queue is not empty") may have changed.
+	// notify_all() costs a fence and a load while nobody waits, so the side that changes the condition can call it
+	// unconditionally. Waiters register before re-checking the condition, and notifiers publish before checking for
+	// waiters, so a wakeup cannot be lost between the check and the park.
+	class event_count
+	{
+	public:
+		event_count() noexcept = default;
+
+		event_count(const event_count&)			   = delete;
+		event_count& operator=(const event_count&) = delete;
+
+		// Call after making ready() true for waiters.
+		void notify_all() noexcept
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_waiters.load(std::memory_order_relaxed) == 0) return;
+			m_epoch.fetch_add(1, std::memory_order_release);
+			atomic_notify_all(m_epoch);
+		}
+
+		// Blocks until ready() returns true; ready is re-evaluated after every wakeup.
+		template <class Ready> void await(Ready ready) noexcept(noexcept(ready()))
+		{
+			while (!ready())
+			{
+				m_waiters.fetch_add(1, std::memory_order_seq_cst);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const std::uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+				if (!ready()) atomic_wait(m_epoch, epoch, std::memory_order_acquire);
+				m_waiters.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+	private:
+		std::atomic<std::uint32_t> m_waiters{ 0 };
+		std::atomic<std::uint32_t> m_epoch{ 0 };
+	};
+} // namespace internal
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_INTERNAL_HELPERS_EVENT_COUNT_HPP
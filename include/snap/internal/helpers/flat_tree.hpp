@@ -0,0 +1,88 @@
+#ifndef SNP_INCLUDE_SNAP_INTERNAL_HELPERS_FLAT_TREE_HPP
+#define SNP_INCLUDE_SNAP_INTERNAL_HELPERS_FLAT_TREE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/meta/detector.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	template <class Compare> using is_transparent_t = typename Compare::is_transparent;
+
+	// Index of the first element of [first, first + n) for which before(element) is false. before must hold for a
+	// prefix of the range. The loop body has no data dependent branch; the select compiles to a conditional move.
+	template <class It, class Before> std::size_t branchless_partition_point(It first, std::size_t n, Before& before)
+	{
+		if (n == 0) return 0;
+		std::size_t base = 0;
+		while (n > 1)
+		{
+			const std::size_t half = n / 2;
+			base				   = before(first[base + half]) ? base + half : base;
+			n -= half;
+		}
+		return base + static_cast<std::size_t>(before(first[base]));
+	}
+
+	// Same contract as branchless_partition_point, but counts the matching prefix in one pass. For scalar keys the
+	// loop has no early exit, so the compiler can vectorise it.
+	template <class It, class Before> std::size_t linear_partition_point(It first, std::size_t n, Before& before)
+	{
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < n; ++i) count += static_cast<std::size_t>(before(first[i]));
+		return count;
+	}
+
+	// Deduction guide helpers: whether It is an iterator, and what it points at (pairs for the maps).
+	template <class It> using iter_category_t		   = typename std::iterator_traits<It>::iterator_category;
+	template <class It> inline constexpr bool is_iterator_v = is_detected_v<iter_category_t, It>;
+	template <class It> using iter_value_t			   = typename std::iterator_traits<It>::value_type;
+	template <class It> using iter_key_t			   = std::remove_const_t<typename iter_value_t<It>::first_type>;
+	template <class It> using iter_mapped_t			   = typename iter_value_t<It>::second_type;
+
+	template <class C> using reserve_t = decltype(std::declval<C&>().reserve(std::size_t{}));
+
+	template <class C> void reserve_if_possible(C& c, std::size_t n)
+	{
+		if constexpr (is_detected_v<reserve_t, C>) { c.reserve(n); }
+	}
+
+	// Merges the sorted runs a = [0, na) and b = [0, nb), calling take_a(i) / take_b(j) in key order. Entries of b
+	// equivalent to an existing entry of a are placed after it; when Unique they are dropped instead, as are repeats
+	// within b, so existing entries and the first of each run of new ones win.
+	template <bool Unique, class KeyA, class KeyB, class Compare, class TakeA, class TakeB>
+	void merge_sorted_runs(std::size_t na, std::size_t nb, KeyA key_a, KeyB key_b, const Compare& comp, TakeA take_a, TakeB take_b)
+	{
+		std::size_t i = 0;
+		std::size_t j = 0;
+		while (j < nb)
+		{
+			if constexpr (Unique)
+			{
+				while (i < na && comp(key_a(i), key_b(j))) take_a(i++);
+				std::size_t run_end = j + 1;
+				while (run_end < nb && !comp(key_b(j), key_b(run_end))) ++run_end;
+				if (i == na || comp(key_b(j), key_a(i))) take_b(j);
+				j = run_end;
+			}
+			else
+			{
+				while (i < na && !comp(key_b(j), key_a(i))) take_a(i++);
+				take_b(j++);
+			}
+		}
+		while (i < na) take_a(i++);
+	}
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_INTERNAL_HELPERS_FLAT_TREE_HPP
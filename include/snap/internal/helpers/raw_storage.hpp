@@ -17,7 +17,7 @@ namespace internal
 		static_assert(Alignment != 0, "Alignment must be non-zero");
 		static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
 
-		alignas(Alignment) std::array<std::byte, Size> buffer{};
+		alignas(Alignment) std::array<std::byte, Size> buffer; // left uninitialized; users placement-new into it
 
 		[[nodiscard]] void* data() noexcept { return static_cast<void*>(buffer.data()); }
 		[[nodiscard]] const void* data() const noexcept { return static_cast<const void*>(buffer.data()); }
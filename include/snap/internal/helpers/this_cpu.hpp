@@ -0,0 +1,20 @@
+#ifndef SNP_INCLUDE_SNAP_INTERNAL_HELPERS_THIS_CPU_HPP
+#define SNP_INCLUDE_SNAP_INTERNAL_HELPERS_THIS_CPU_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include <cstdint>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	// Index of the CPU the calling thread is running on, or a stable per-thread hash where the OS cannot tell us.
+	// Only a hint: the thread may migrate right after the call, so callers must stay correct for any value.
+	std::uint32_t this_cpu_hint() noexcept;
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_INTERNAL_HELPERS_THIS_CPU_HPP
@@ -0,0 +1,176 @@
+#ifndef SNP_INCLUDE_SNAP_MEMORY_HAZARD_POINTER_HPP
+#define SNP_INCLUDE_SNAP_MEMORY_HAZARD_POINTER_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/asymmetric_fence.hpp"
+#include "snap/internal/helpers/cache_line.hpp"
+#include "snap/internal/helpers/raw_storage.hpp"
+
+#include <atomic>
+#include <cstddef> // std::nullptr_t
+#include <memory>  // std::default_delete
+#include <new>	   // std::launder, placement new
+#include <type_traits>
+#include <utility> // std::move, std::swap
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal
+{
+	// One published hazard. Records are never freed; they are recycled between hazard_pointer objects.
+	struct alignas(cache_line_size) hazard_record
+	{
+		std::atomic<const void*> ptr{ nullptr };
+		std::atomic<bool> active{ false };
+		hazard_record* next		 = nullptr; // global registry link (immutable once published)
+		hazard_record* next_free = nullptr; // per-thread cache link
+	};
+
+	// Intrusive header carried by every hazard_pointer_obj_base, so retire() never allocates.
+	struct hazard_retired_node
+	{
+		using reclaim_fn = void (*)(hazard_retired_node*) noexcept;
+
+		hazard_retired_node* retired_next = nullptr;
+		const void* retired_object		  = nullptr;
+		reclaim_fn reclaim				  = nullptr;
+	};
+
+	hazard_record* hazard_acquire_record();
+	void hazard_release_record(hazard_record* rec) noexcept;
+	void hazard_retire(hazard_retired_node* node) noexcept;
+	void hazard_cleanup() noexcept;
+} // namespace internal
+
+// C++26 hazard_pointer_obj_base (P2530). T must publicly derive from hazard_pointer_obj_base<T, D>.
+//
+// retire() only queues the object on the calling thread's retire list; reclamation happens later,
+// in batches, once a scan proves no hazard pointer protects it.
+template <class T, class D = std::default_delete<T>> class hazard_pointer_obj_base : private internal::hazard_retired_node
+{
+public:
+	void retire(D d = D()) noexcept
+	{
+		static_assert(std::is_base_of_v<hazard_pointer_obj_base, T>, "T must derive from hazard_pointer_obj_base<T, D>");
+		static_assert(std::is_nothrow_move_constructible_v<D>, "D must be nothrow move constructible");
+
+		::new (deleter_.data()) D(std::move(d));
+		this->retired_object = static_cast<const void*>(static_cast<T*>(this));
+		this->reclaim		 = &hazard_pointer_obj_base::reclaim_self;
+		internal::hazard_retire(this);
+	}
+
+protected:
+	hazard_pointer_obj_base()											   = default;
+	hazard_pointer_obj_base(const hazard_pointer_obj_base&)				   = default;
+	hazard_pointer_obj_base(hazard_pointer_obj_base&&)					   = default;
+	hazard_pointer_obj_base& operator=(const hazard_pointer_obj_base&)	   = default;
+	hazard_pointer_obj_base& operator=(hazard_pointer_obj_base&&)		   = default;
+	~hazard_pointer_obj_base()											   = default;
+
+private:
+	static void reclaim_self(internal::hazard_retired_node* node) noexcept
+	{
+		auto* self = static_cast<hazard_pointer_obj_base*>(node);
+		D* stored  = std::launder(reinterpret_cast<D*>(self->deleter_.data()));
+		D d(std::move(*stored));
+		stored->~D();
+		d(static_cast<T*>(self));
+	}
+
+	internal::raw_storage_for<D> deleter_;
+};
+
+// C++26 hazard_pointer (P2530).
+// A non-empty hazard_pointer owns one hazard slot. Publishing a pointer is a plain store followed by the light half
+// of an asymmetric fence, so readers never issue an atomic read-modify-write on the protect path.
+class hazard_pointer
+{
+public:
+	hazard_pointer() noexcept = default;
+
+	hazard_pointer(hazard_pointer&& other) noexcept : rec_(other.rec_) { other.rec_ = nullptr; }
+
+	hazard_pointer& operator=(hazard_pointer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			rec_	   = other.rec_;
+			other.rec_ = nullptr;
+		}
+		return *this;
+	}
+
+	hazard_pointer(const hazard_pointer&)			 = delete;
+	hazard_pointer& operator=(const hazard_pointer&) = delete;
+
+	~hazard_pointer() { release(); }
+
+	[[nodiscard]] bool empty() const noexcept { return rec_ == nullptr; }
+
+	template <class T> T* protect(const std::atomic<T*>& src) noexcept
+	{
+		T* ptr = src.load(std::memory_order_relaxed);
+		while (!try_protect(ptr, src)) {}
+		return ptr;
+	}
+
+	template <class T> bool try_protect(T*& ptr, const std::atomic<T*>& src) noexcept
+	{
+		T* const expected = ptr;
+		reset_protection(expected);
+		internal::detail::asymmetric_thread_fence_light();
+
+		ptr = src.load(std::memory_order_acquire);
+		if (ptr != expected)
+		{
+			reset_protection(nullptr);
+			return false;
+		}
+		return true;
+	}
+
+	template <class T> void reset_protection(const T* ptr) noexcept { rec_->ptr.store(static_cast<const void*>(ptr), std::memory_order_release); }
+
+	void reset_protection(std::nullptr_t = nullptr) noexcept { rec_->ptr.store(nullptr, std::memory_order_release); }
+
+	void swap(hazard_pointer& other) noexcept { std::swap(rec_, other.rec_); }
+
+	friend void swap(hazard_pointer& a, hazard_pointer& b) noexcept { a.swap(b); }
+
+private:
+	explicit hazard_pointer(internal::hazard_record* rec) noexcept : rec_(rec) {}
+
+	void release() noexcept
+	{
+		if (rec_ != nullptr)
+		{
+			internal::hazard_release_record(rec_);
+			rec_ = nullptr;
+		}
+	}
+
+	internal::hazard_record* rec_ = nullptr;
+
+	friend hazard_pointer make_hazard_pointer();
+};
+
+// Returns a non-empty hazard_pointer. Slots are recycled per thread, so steady-state calls do not allocate.
+[[nodiscard]] inline hazard_pointer make_hazard_pointer()
+{
+	return hazard_pointer(internal::hazard_acquire_record());
+}
+
+// Extension: scans now and reclaims every object retired by the calling thread (and by exited threads)
+// that is no longer protected. Useful at shutdown and in tests; normal operation never needs it.
+inline void hazard_pointer_cleanup() noexcept
+{
+	internal::hazard_cleanup();
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_MEMORY_HAZARD_POINTER_HPP
@@ -0,0 +1,191 @@
+#ifndef SNP_INCLUDE_SNAP_MEMORY_RCU_HPP
+#define SNP_INCLUDE_SNAP_MEMORY_RCU_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/asymmetric_fence.hpp"
+#include "snap/internal/helpers/atomic_helpers.hpp"
+#include "snap/internal/helpers/cache_line.hpp"
+#include "snap/internal/helpers/raw_storage.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory> // std::default_delete
+#include <mutex>
+#include <new> // std::launder, placement new
+#include <type_traits>
+#include <utility> // std::move
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal
+{
+	// Per-thread read-side state. Records are never freed; a record is recycled once its thread exits.
+	struct alignas(cache_line_size) rcu_reader
+	{
+		// Epoch observed when the outermost critical section began, or 0 while quiescent.
+		std::atomic<std::uint32_t> epoch{ 0 };
+		// Set by a synchronizer that may block on this reader; the reader then wakes it from unlock().
+		std::atomic<std::uint32_t> waiter{ 0 };
+		std::uint32_t nesting = 0;
+		std::atomic<bool> active{ false };
+		rcu_reader* next = nullptr;
+	};
+
+	// Intrusive header carried by every rcu_obj_base, so retire() never allocates.
+	struct rcu_retired_node
+	{
+		using reclaim_fn = void (*)(rcu_retired_node*) noexcept;
+
+		rcu_retired_node* retired_next = nullptr;
+		reclaim_fn reclaim			   = nullptr;
+	};
+
+	// Heap-allocated wrapper used by rcu_retire() for objects that do not derive from rcu_obj_base.
+	template <class T, class D> struct rcu_retired_box final : rcu_retired_node
+	{
+		rcu_retired_box(T* p, D&& d) noexcept : object(p), deleter(std::move(d)) { this->reclaim = &rcu_retired_box::reclaim_box; }
+
+		static void reclaim_box(rcu_retired_node* node) noexcept
+		{
+			auto* self = static_cast<rcu_retired_box*>(node);
+			self->deleter(self->object);
+			delete self;
+		}
+
+		T* object;
+		D deleter;
+	};
+
+	inline thread_local rcu_reader* rcu_this_reader = nullptr;
+
+	rcu_reader* rcu_register_reader();
+} // namespace internal
+
+class rcu_domain;
+
+rcu_domain& rcu_default_domain() noexcept;
+
+// Blocks until every read-side critical section that began before the call has ended.
+// Waiting readers are parked on their own epoch word and woken by unlock(); there is no polling loop.
+// Must not be called from inside a critical section.
+void rcu_synchronize(rcu_domain& dom = rcu_default_domain()) noexcept;
+
+// Blocks until every object retired before the call has been reclaimed.
+void rcu_barrier(rcu_domain& dom = rcu_default_domain()) noexcept;
+
+// Retires an object that does not derive from rcu_obj_base. Allocates a small tracking node.
+template <class T, class D = std::default_delete<T>> void rcu_retire(T* p, D d = D(), rcu_domain& dom = rcu_default_domain());
+
+// C++26 rcu_domain (P2545). Only the default domain exists; obtain it with rcu_default_domain().
+//
+// Read-side critical sections are epoch based: the outermost lock() copies the global epoch into this thread's
+// record and unlock() clears it, each followed by the light half of an asymmetric fence. Neither side performs an
+// atomic read-modify-write, and on x86 the cost is the thread-local store plus a compiler barrier.
+// Sections nest and satisfy Cpp17Lockable, so std::scoped_lock works.
+class rcu_domain
+{
+public:
+	rcu_domain(const rcu_domain&)			 = delete;
+	rcu_domain& operator=(const rcu_domain&) = delete;
+
+	void lock() noexcept
+	{
+		internal::rcu_reader* self = internal::rcu_this_reader;
+		if (self == nullptr) { self = internal::rcu_register_reader(); }
+
+		if (self->nesting++ == 0)
+		{
+			self->epoch.store(epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			internal::detail::asymmetric_thread_fence_light();
+		}
+	}
+
+	bool try_lock() noexcept
+	{
+		lock();
+		return true;
+	}
+
+	void unlock() noexcept
+	{
+		internal::rcu_reader* self = internal::rcu_this_reader;
+		if (--self->nesting == 0)
+		{
+			self->epoch.store(0, std::memory_order_release);
+			internal::detail::asymmetric_thread_fence_light();
+			if (self->waiter.load(std::memory_order_relaxed) != 0) { internal::atomic_notify_all(self->epoch); }
+		}
+	}
+
+private:
+	rcu_domain()  = default;
+	~rcu_domain() = default;
+
+	void synchronize() noexcept;
+	void barrier() noexcept;
+	void retire_node(internal::rcu_retired_node* node) noexcept;
+	void reclaim_batch() noexcept;
+
+	std::atomic<std::uint32_t> epoch_{ 1 };
+	std::atomic<internal::rcu_retired_node*> retired_{ nullptr };
+	std::atomic<std::size_t> retired_count_{ 0 };
+	std::mutex gp_mutex_;
+	std::mutex reclaim_mutex_;
+
+	friend rcu_domain& rcu_default_domain() noexcept;
+	friend void rcu_synchronize(rcu_domain& dom) noexcept;
+	friend void rcu_barrier(rcu_domain& dom) noexcept;
+	template <class T, class D> friend class rcu_obj_base;
+	template <class T, class D> friend void rcu_retire(T* p, D d, rcu_domain& dom);
+};
+
+// C++26 rcu_obj_base (P2545). T must publicly derive from rcu_obj_base<T, D>.
+//
+// retire() queues the object on the domain and returns immediately; deleters run in batches after a grace period,
+// on whichever thread crosses the batch threshold outside a critical section (or in rcu_barrier()).
+template <class T, class D = std::default_delete<T>> class rcu_obj_base : private internal::rcu_retired_node
+{
+public:
+	void retire(D d = D(), rcu_domain& dom = rcu_default_domain()) noexcept
+	{
+		static_assert(std::is_base_of_v<rcu_obj_base, T>, "T must derive from rcu_obj_base<T, D>");
+		static_assert(std::is_nothrow_move_constructible_v<D>, "D must be nothrow move constructible");
+
+		::new (deleter_.data()) D(std::move(d));
+		this->reclaim = &rcu_obj_base::reclaim_self;
+		dom.retire_node(this);
+	}
+
+protected:
+	rcu_obj_base()								 = default;
+	rcu_obj_base(const rcu_obj_base&)			 = default;
+	rcu_obj_base(rcu_obj_base&&)				 = default;
+	rcu_obj_base& operator=(const rcu_obj_base&) = default;
+	rcu_obj_base& operator=(rcu_obj_base&&)		 = default;
+	~rcu_obj_base()								 = default;
+
+private:
+	static void reclaim_self(internal::rcu_retired_node* node) noexcept
+	{
+		auto* self = static_cast<rcu_obj_base*>(node);
+		D* stored  = std::launder(reinterpret_cast<D*>(self->deleter_.data()));
+		D d(std::move(*stored));
+		stored->~D();
+		d(static_cast<T*>(self));
+	}
+
+	internal::raw_storage_for<D> deleter_;
+};
+
+template <class T, class D> void rcu_retire(T* p, D d, rcu_domain& dom)
+{
+	static_assert(std::is_nothrow_move_constructible_v<D>, "D must be nothrow move constructible");
+	dom.retire_node(new internal::rcu_retired_box<T, D>(p, std::move(d)));
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_MEMORY_RCU_HPP
@@ -0,0 +1,130 @@
+#ifndef SNP_INCLUDE_SNAP_MEMORY_RELOCATE_HPP
+#define SNP_INCLUDE_SNAP_MEMORY_RELOCATE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/memory/to_address.hpp"
+#include "snap/type_traits/is_trivially_relocatable.hpp"
+
+#include <cstring> // std::memmove
+#include <iterator>
+#include <memory> // std::addressof
+#include <new>	  // std::launder, placement new
+#include <type_traits>
+#include <utility> // std::move
+
+SNAP_BEGIN_NAMESPACE
+
+namespace detail
+{
+	template <class It> using iter_value_t = typename std::iterator_traits<It>::value_type;
+
+	// Both ends are pointers to the same trivially relocatable type, so the whole range moves with one memmove.
+	template <class In, class Out>
+	inline constexpr bool is_memmove_relocation_v = std::is_pointer_v<In> && std::is_pointer_v<Out> &&
+													std::is_same_v<std::remove_cv_t<iter_value_t<In>>, iter_value_t<Out>> &&
+													is_trivially_relocatable_v<iter_value_t<Out>>;
+
+	template <class T> void* relocate_voidify(T& r) noexcept
+	{
+		return const_cast<void*>(static_cast<const void*>(std::addressof(r)));
+	}
+} // namespace detail
+
+// Moves *source into the uninitialized storage at dest and ends the lifetime of *source. Trivially relocatable
+// types are copied bytewise. Returns a pointer to the new object.
+template <class T> T* relocate_at(T* source, T* dest) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>)
+{
+	static_assert(!std::is_const_v<T>, "relocate_at needs a modifiable source");
+	if constexpr (is_trivially_relocatable_v<T>)
+	{
+		std::memmove(detail::relocate_voidify(*dest), detail::relocate_voidify(*source), sizeof(T));
+		return std::launder(dest);
+	}
+	else
+	{
+		T* result = ::new (detail::relocate_voidify(*dest)) T(std::move(*source));
+		source->~T();
+		return result;
+	}
+}
+
+// Relocates [first, last) into the uninitialized range starting at d_first and returns its end. The ranges may
+// overlap if d_first is not inside (first, last), e.g. when shifting elements towards the front.
+//
+// If a move constructor throws, every object in both ranges has been destroyed when the exception propagates.
+template <class InputIt, class ForwardIt> ForwardIt uninitialized_relocate(InputIt first, InputIt last, ForwardIt d_first)
+{
+	if constexpr (detail::is_memmove_relocation_v<InputIt, ForwardIt>)
+	{
+		const auto count = static_cast<std::size_t>(last - first);
+		if (count != 0) { std::memmove(static_cast<void*>(d_first), static_cast<const void*>(first), count * sizeof(*first)); }
+		return d_first + count;
+	}
+	else
+	{
+		using T			 = detail::iter_value_t<ForwardIt>;
+		ForwardIt d_cur = d_first;
+		try
+		{
+			for (; first != last; ++first, (void)++d_cur)
+			{
+				::new (detail::relocate_voidify(*d_cur)) T(std::move(*first));
+				first->~T();
+			}
+		}
+		catch (...)
+		{
+			// *first was not relocated
+			for (; first != last; ++first) { first->~T(); }
+			for (; d_first != d_cur; ++d_first) { d_first->~T(); }
+			throw;
+		}
+		return d_cur;
+	}
+}
+
+// Relocates [first, last) into the uninitialized range ending at d_last, back to front, and returns its start. The
+// ranges may overlap if d_last is not inside (first, last), e.g. when shifting elements towards the back.
+//
+// If a move constructor throws, every object in both ranges has been destroyed when the exception propagates.
+template <class BidirIt1, class BidirIt2> BidirIt2 uninitialized_relocate_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last)
+{
+	if constexpr (detail::is_memmove_relocation_v<BidirIt1, BidirIt2>)
+	{
+		const auto count = last - first;
+		if (count != 0)
+		{
+			std::memmove(static_cast<void*>(d_last - count), static_cast<const void*>(first), static_cast<std::size_t>(count) * sizeof(*first));
+		}
+		return d_last - count;
+	}
+	else
+	{
+		using T			 = detail::iter_value_t<BidirIt2>;
+		BidirIt2 d_cur	 = d_last;
+		try
+		{
+			while (first != last)
+			{
+				--last;
+				--d_cur;
+				::new (detail::relocate_voidify(*d_cur)) T(std::move(*last));
+				last->~T();
+			}
+		}
+		catch (...)
+		{
+			// *last was not relocated and *d_cur was not constructed
+			for (++last; first != last; ++first) { first->~T(); }
+			for (++d_cur; d_cur != d_last; ++d_cur) { d_cur->~T(); }
+			throw;
+		}
+		return d_cur;
+	}
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_MEMORY_RELOCATE_HPP
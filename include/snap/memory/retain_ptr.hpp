@@ -6,6 +6,7 @@
 
 #include "snap/internal/compat/constexpr.hpp"
 #include "snap/meta/detector.hpp"
+#include "snap/type_traits/is_trivially_relocatable.hpp"
 
 #include <atomic>
 #include <cstddef>
@@ -202,6 +203,11 @@ private:
 	pointer ptr{};
 };
 
+// A retain_ptr is just its pointer; moving it and destroying the source leaves the count untouched.
+template <class T, class R> struct is_trivially_relocatable<retain_ptr<T, R>> : is_trivially_relocatable<typename retain_ptr<T, R>::pointer>
+{
+};
+
 // make_retain
 template <class T, class... Args> SNAP_CONSTEXPR20 retain_ptr<T> make_retain(Args &&...args)
 {
@@ -0,0 +1,724 @@
+#ifndef SNP_INCLUDE_SNAP_SMALL_VECTOR_HPP
+#define SNP_INCLUDE_SNAP_SMALL_VECTOR_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/raw_storage.hpp"
+#include "snap/internal/pp/no_unique_address.hpp"
+#include "snap/memory/relocate.hpp"
+#include "snap/memory/to_address.hpp"
+#include "snap/type_traits/is_trivially_relocatable.hpp"
+
+#include <algorithm> // std::move, std::rotate, std::lexicographical_compare, std::swap_ranges
+#include <cstddef>
+#include <cstring> // std::memcpy, std::memmove
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory> // std::allocator, std::allocator_traits
+#include <new>	  // placement new
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+// Capacity growth policies for small_vector. next_capacity() is asked for a new capacity once `required` elements no
+// longer fit into `capacity`; small_vector never uses less than `required`.
+template <std::size_t Num, std::size_t Den> struct geometric_growth
+{
+	static_assert(Den != 0 && Num > Den, "geometric_growth must grow");
+
+	static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required) noexcept
+	{
+		constexpr std::size_t limit = std::numeric_limits<std::size_t>::max() / Num;
+		const std::size_t grown		= capacity > limit ? std::numeric_limits<std::size_t>::max() : capacity * Num / Den;
+		return grown > required ? grown : required;
+	}
+};
+
+struct exact_growth
+{
+	static constexpr std::size_t next_capacity(std::size_t /*capacity*/, std::size_t required) noexcept { return required; }
+};
+
+using default_growth = geometric_growth<2, 1>;
+
+// A vector that keeps up to N elements inline and moves them to an allocator-backed buffer beyond that.
+//
+// Elements live in exactly one buffer at a time: the inline one while capacity() == N, the heap one after the first
+// spill. shrink_to_fit() moves the elements back inline once they fit again. Growth follows the Growth policy.
+// Trivially relocatable elements (see is_trivially_relocatable) are moved with memcpy/memmove on growth, insert and
+// erase. A small_vector itself is not trivially relocatable, since it points into its own inline buffer.
+//
+// The allocator only provides heap storage; elements are constructed in place in either buffer. Moving or swapping
+// a small_vector moves the inline elements, so unlike std::vector it invalidates iterators into inline storage.
+template <class T, std::size_t N, class Alloc = std::allocator<T>, class Growth = default_growth> class small_vector
+{
+	using alloc_traits = std::allocator_traits<Alloc>;
+
+	static_assert(std::is_same_v<typename alloc_traits::value_type, T>, "Alloc::value_type must be T");
+	static_assert(std::is_move_constructible_v<T> && std::is_move_assignable_v<T>, "T must be MoveConstructible and MoveAssignable");
+
+public:
+	// member types
+	using value_type			 = T;
+	using allocator_type		 = Alloc;
+	using growth_policy			 = Growth;
+	using size_type				 = std::size_t;
+	using difference_type		 = std::ptrdiff_t;
+	using reference				 = value_type&;
+	using const_reference		 = const value_type&;
+	using pointer				 = value_type*;
+	using const_pointer			 = const value_type*;
+	using iterator				 = pointer;
+	using const_iterator		 = const_pointer;
+	using reverse_iterator		 = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	static constexpr size_type inline_capacity = N;
+
+	// constructors
+	small_vector() noexcept(std::is_nothrow_default_constructible_v<Alloc>) : small_vector(Alloc()) {}
+
+	explicit small_vector(const Alloc& alloc) noexcept : m_data(inline_data()), m_alloc(alloc) {}
+
+	explicit small_vector(size_type count, const Alloc& alloc = Alloc()) : small_vector(alloc)
+	{
+		reserve(count);
+		construct_tail_(count);
+	}
+
+	small_vector(size_type count, const T& value, const Alloc& alloc = Alloc()) : small_vector(alloc)
+	{
+		reserve(count);
+		construct_tail_(count, value);
+	}
+
+	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+	small_vector(InputIt first, InputIt last, const Alloc& alloc = Alloc()) : small_vector(alloc)
+	{
+		append_range(first, last);
+	}
+
+	small_vector(std::initializer_list<T> il, const Alloc& alloc = Alloc()) : small_vector(alloc) { append_range(il.begin(), il.end()); }
+
+	small_vector(const small_vector& other) : small_vector(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+	{
+		reserve(other.m_size);
+		append_n_(other.m_data, other.m_size);
+	}
+
+	small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : small_vector(std::move(other.m_alloc))
+	{
+		take_(other);
+	}
+
+	~small_vector()
+	{
+		destroy_(m_data, m_data + m_size);
+		release_();
+	}
+
+	// assignment
+	small_vector& operator=(const small_vector& rhs)
+	{
+		if (this == &rhs) return *this;
+		if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+		{
+			if (m_alloc != rhs.m_alloc)
+			{
+				clear();
+				release_();
+			}
+			m_alloc = rhs.m_alloc;
+		}
+		assign_n_(rhs.m_data, rhs.m_size);
+		return *this;
+	}
+
+	small_vector& operator=(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T> &&
+														  (alloc_traits::propagate_on_container_move_assignment::value ||
+														   alloc_traits::is_always_equal::value))
+	{
+		if (this == &rhs) return *this;
+		if (alloc_traits::propagate_on_container_move_assignment::value || m_alloc == rhs.m_alloc)
+		{
+			clear();
+			release_();
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value) { m_alloc = std::move(rhs.m_alloc); }
+			take_(rhs);
+		}
+		else
+		{
+			// unequal allocators that do not propagate: the heap buffer cannot change hands
+			assign_n_(std::make_move_iterator(rhs.m_data), rhs.m_size);
+			rhs.clear();
+		}
+		return *this;
+	}
+
+	small_vector& operator=(std::initializer_list<T> il)
+	{
+		assign(il.begin(), il.end());
+		return *this;
+	}
+
+	void assign(size_type count, const T& value)
+	{
+		if (count > capacity())
+		{
+			const T copy(value); // value may live in the buffer that is about to be released
+			clear();
+			grow_exact_(count);
+			construct_tail_(count, copy);
+			return;
+		}
+		const size_type common = count < m_size ? count : m_size;
+		std::fill_n(m_data, common, value);
+		if (count > m_size) { construct_tail_(count, value); }
+		else
+		{
+			destroy_(m_data + count, m_data + m_size);
+			m_size = count;
+		}
+	}
+
+	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>> void assign(InputIt first, InputIt last)
+	{
+		if constexpr (is_forward_iterator_v<InputIt>) { assign_n_(first, static_cast<size_type>(std::distance(first, last))); }
+		else
+		{
+			clear();
+			for (; first != last; ++first) emplace_back(*first);
+		}
+	}
+
+	void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
+
+	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))> void assign_range(R&& rg)
+	{
+		assign(std::begin(rg), std::end(rg));
+	}
+
+	[[nodiscard]] allocator_type get_allocator() const noexcept { return m_alloc; }
+
+	// element access
+	reference at(size_type pos)
+	{
+		if (pos >= m_size) throw std::out_of_range("small_vector::at");
+		return m_data[pos];
+	}
+	const_reference at(size_type pos) const
+	{
+		if (pos >= m_size) throw std::out_of_range("small_vector::at");
+		return m_data[pos];
+	}
+
+	reference operator[](size_type pos) noexcept { return m_data[pos]; }
+	const_reference operator[](size_type pos) const noexcept { return m_data[pos]; }
+
+	reference front() noexcept { return m_data[0]; }
+	const_reference front() const noexcept { return m_data[0]; }
+
+	reference back() noexcept { return m_data[m_size - 1]; }
+	const_reference back() const noexcept { return m_data[m_size - 1]; }
+
+	pointer data() noexcept { return m_data; }
+	const_pointer data() const noexcept { return m_data; }
+
+	// iterators
+	iterator begin() noexcept { return m_data; }
+	const_iterator begin() const noexcept { return m_data; }
+	const_iterator cbegin() const noexcept { return m_data; }
+	iterator end() noexcept { return m_data + m_size; }
+	const_iterator end() const noexcept { return m_data + m_size; }
+	const_iterator cend() const noexcept { return m_data + m_size; }
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+	reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+	// size & capacity
+	[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+	size_type size() const noexcept { return m_size; }
+	size_type capacity() const noexcept { return m_capacity; }
+	size_type max_size() const noexcept
+	{
+		const size_type by_alloc = alloc_traits::max_size(m_alloc);
+		const size_type by_diff	 = static_cast<size_type>(std::numeric_limits<difference_type>::max()) / sizeof(T);
+		return by_alloc < by_diff ? by_alloc : by_diff;
+	}
+
+	// True while the elements live in the inline buffer.
+	[[nodiscard]] bool is_inline() const noexcept { return m_data == inline_data(); }
+
+	void reserve(size_type new_cap)
+	{
+		if (new_cap > m_capacity) { grow_exact_(new_cap); }
+	}
+
+	// Moves the elements back into the inline buffer once they fit, or into an exactly sized heap buffer otherwise.
+	// Non-binding: if relocating throws, the elements stay where they are.
+	void shrink_to_fit() noexcept
+	{
+		if (is_inline() || m_size == m_capacity) return;
+		try
+		{
+			if (m_size <= N) { move_to_(inline_data(), N); }
+			else { move_to_(alloc_traits::allocate(m_alloc, m_size), m_size); }
+		}
+		catch (...)
+		{
+			// keep the current buffer
+		}
+	}
+
+	// modifiers
+	void clear() noexcept
+	{
+		destroy_(m_data, m_data + m_size);
+		m_size = 0;
+	}
+
+	void push_back(const T& v) { emplace_back(v); }
+	void push_back(T&& v) { emplace_back(std::move(v)); }
+
+	template <class... Args> reference emplace_back(Args&&... args)
+	{
+		if (m_size == m_capacity) { return grow_emplace_back_(std::forward<Args>(args)...); }
+		::new (static_cast<void*>(m_data + m_size)) T(std::forward<Args>(args)...);
+		return m_data[m_size++];
+	}
+
+	// pop_back: precondition !empty()
+	void pop_back() noexcept
+	{
+		--m_size;
+		destroy_(m_data + m_size, m_data + m_size + 1);
+	}
+
+	void resize(size_type count)
+	{
+		if (count > m_size)
+		{
+			reserve(count);
+			construct_tail_(count);
+		}
+		else { erase(begin() + count, end()); }
+	}
+
+	void resize(size_type count, const T& value)
+	{
+		if (count > m_size)
+		{
+			if (count > m_capacity)
+			{
+				const T copy(value);
+				grow_exact_(count);
+				construct_tail_(count, copy);
+			}
+			else { construct_tail_(count, value); }
+		}
+		else { erase(begin() + count, end()); }
+	}
+
+	iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+	iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+	iterator insert(const_iterator pos, size_type count, const T& value)
+	{
+		const auto idx = static_cast<size_type>(pos - cbegin());
+		if (count == 0) return m_data + idx;
+		const T copy(value); // value may be an element that moves below
+		reserve_for_(count);
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			open_gap_(idx, count);
+			size_type i = 0;
+			try
+			{
+				for (; i < count; ++i) ::new (static_cast<void*>(m_data + idx + i)) T(copy);
+			}
+			catch (...)
+			{
+				destroy_(m_data + idx, m_data + idx + i);
+				SNAP_NAMESPACE::uninitialized_relocate(m_data + idx + count, m_data + m_size + count, m_data + idx);
+				throw;
+			}
+			m_size += count;
+		}
+		else
+		{
+			const size_type old = m_size;
+			construct_tail_(m_size + count, copy);
+			std::rotate(m_data + idx, m_data + old, m_data + m_size);
+		}
+		return m_data + idx;
+	}
+
+	template <class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>> iterator insert(const_iterator pos, InputIt first, InputIt last)
+	{
+		const auto idx		= static_cast<size_type>(pos - cbegin());
+		const size_type old = m_size;
+		if constexpr (is_forward_iterator_v<InputIt>)
+		{
+			const auto count = static_cast<size_type>(std::distance(first, last));
+			if (count == 0) return m_data + idx;
+			reserve_for_(count);
+			if constexpr (is_memcpy_source_v<InputIt>)
+			{
+				open_gap_(idx, count);
+				std::memcpy(static_cast<void*>(m_data + idx), static_cast<const void*>(SNAP_NAMESPACE::to_address(first)), count * sizeof(T));
+				m_size += count;
+				return m_data + idx;
+			}
+			else { append_n_(first, count); }
+		}
+		else
+		{
+			for (; first != last; ++first) emplace_back(*first);
+		}
+		std::rotate(m_data + idx, m_data + old, m_data + m_size);
+		return m_data + idx;
+	}
+
+	iterator insert(const_iterator pos, std::initializer_list<T> il) { return insert(pos, il.begin(), il.end()); }
+
+	template <class... Args> iterator emplace(const_iterator pos, Args&&... args)
+	{
+		const auto idx = static_cast<size_type>(pos - cbegin());
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (idx != m_size)
+			{
+				// built first: args may refer to an element that moves below
+				internal::raw_storage_for<T> slot;
+				T* element = ::new (slot.data()) T(std::forward<Args>(args)...);
+				try
+				{
+					reserve_for_(1);
+				}
+				catch (...)
+				{
+					element->~T();
+					throw;
+				}
+				open_gap_(idx, 1);
+				SNAP_NAMESPACE::relocate_at(element, m_data + idx);
+				++m_size;
+				return m_data + idx;
+			}
+		}
+		emplace_back(std::forward<Args>(args)...);
+		std::rotate(m_data + idx, m_data + m_size - 1, m_data + m_size);
+		return m_data + idx;
+	}
+
+	template <class InputIt> void append_range(InputIt first, InputIt last)
+	{
+		if constexpr (is_forward_iterator_v<InputIt>)
+		{
+			const auto count = static_cast<size_type>(std::distance(first, last));
+			reserve_for_(count);
+			append_n_(first, count);
+		}
+		else
+		{
+			for (; first != last; ++first) emplace_back(*first);
+		}
+	}
+
+	template <class R, class B = decltype(std::begin(std::declval<R&>())), class E = decltype(std::end(std::declval<R&>()))> void append_range(R&& rg)
+	{
+		append_range(std::begin(rg), std::end(rg));
+	}
+
+	iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		const auto i_first = static_cast<size_type>(first - cbegin());
+		const auto i_last  = static_cast<size_type>(last - cbegin());
+		if (i_first == i_last) return m_data + i_first;
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			destroy_(m_data + i_first, m_data + i_last);
+			SNAP_NAMESPACE::uninitialized_relocate(m_data + i_last, m_data + m_size, m_data + i_first);
+		}
+		else
+		{
+			pointer new_end = std::move(m_data + i_last, m_data + m_size, m_data + i_first);
+			destroy_(new_end, m_data + m_size);
+		}
+		m_size -= i_last - i_first;
+		return m_data + i_first;
+	}
+
+	void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T> &&
+											alloc_traits::is_always_equal::value)
+	{
+		if (this == &other) return;
+		if (!is_inline() && !other.is_inline())
+		{
+			using std::swap;
+			if constexpr (alloc_traits::propagate_on_container_swap::value) { swap(m_alloc, other.m_alloc); }
+			swap(m_data, other.m_data);
+			swap(m_size, other.m_size);
+			swap(m_capacity, other.m_capacity);
+			return;
+		}
+		small_vector tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	// comparisons
+	friend bool operator==(const small_vector& a, const small_vector& b)
+	{
+		return a.m_size == b.m_size && std::equal(a.begin(), a.end(), b.begin());
+	}
+	friend bool operator!=(const small_vector& a, const small_vector& b) { return !(a == b); }
+	friend bool operator<(const small_vector& a, const small_vector& b)
+	{
+		return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+	friend void swap(small_vector& a, small_vector& b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
+
+private:
+	template <class It>
+	static constexpr bool is_forward_iterator_v = std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+	template <class It>
+	static constexpr bool is_memcpy_source_v = std::is_trivially_copyable_v<T> && std::is_pointer_v<It> &&
+											   std::is_same_v<std::remove_cv_t<typename std::iterator_traits<It>::value_type>, T>;
+
+	pointer inline_data() noexcept { return reinterpret_cast<pointer>(m_inline); }
+	const_pointer inline_data() const noexcept { return reinterpret_cast<const_pointer>(m_inline); }
+
+	static void destroy_(pointer first, pointer last) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			while (last != first) (--last)->~T();
+		}
+	}
+
+	// Moves n elements from src into uninitialized dst and ends the lifetime of the originals. Elements whose move
+	// may throw are copied instead when they can be, so a failure leaves src intact.
+	static void relocate_(pointer dst, pointer src, size_type n)
+	{
+		if constexpr (is_trivially_relocatable_v<T>) { SNAP_NAMESPACE::uninitialized_relocate(src, src + n, dst); }
+		else
+		{
+			size_type i = 0;
+			try
+			{
+				for (; i < n; ++i) ::new (static_cast<void*>(dst + i)) T(std::move_if_noexcept(src[i]));
+			}
+			catch (...)
+			{
+				destroy_(dst, dst + i);
+				throw;
+			}
+			destroy_(src, src + n);
+		}
+	}
+
+	// Gives back the heap buffer, if any, and points at the empty inline buffer. The elements must be gone already.
+	void release_() noexcept
+	{
+		if (!is_inline()) { alloc_traits::deallocate(m_alloc, m_data, m_capacity); }
+		m_data	   = inline_data();
+		m_capacity = N;
+	}
+
+	// Takes other's elements: the heap buffer changes hands, inline elements are relocated. Leaves other empty.
+	void take_(small_vector& other)
+	{
+		if (other.is_inline())
+		{
+			relocate_(m_data, other.m_data, other.m_size);
+			m_size		 = other.m_size;
+			other.m_size = 0;
+			return;
+		}
+		m_data			 = other.m_data;
+		m_size			 = other.m_size;
+		m_capacity		 = other.m_capacity;
+		other.m_data	 = other.inline_data();
+		other.m_size	 = 0;
+		other.m_capacity = N;
+	}
+
+	// Releases the old buffer, whose elements have been relocated, and switches to new_data.
+	void adopt_(pointer new_data, size_type new_cap) noexcept
+	{
+		if (!is_inline()) { alloc_traits::deallocate(m_alloc, m_data, m_capacity); }
+		m_data	   = new_data;
+		m_capacity = new_cap;
+	}
+
+	// Relocates the elements into new_data (inline or freshly allocated with capacity new_cap) and releases the
+	// old buffer. On exception new_data is released and nothing changes.
+	void move_to_(pointer new_data, size_type new_cap)
+	{
+		try
+		{
+			relocate_(new_data, m_data, m_size);
+		}
+		catch (...)
+		{
+			if (new_data != inline_data()) { alloc_traits::deallocate(m_alloc, new_data, new_cap); }
+			throw;
+		}
+		adopt_(new_data, new_cap);
+	}
+
+	void grow_exact_(size_type new_cap)
+	{
+		if (new_cap > max_size()) throw std::length_error("small_vector");
+		move_to_(alloc_traits::allocate(m_alloc, new_cap), new_cap);
+	}
+
+	size_type next_capacity_(size_type required) const
+	{
+		const size_type limit = max_size();
+		if (required > limit) throw std::length_error("small_vector");
+		const size_type grown = Growth::next_capacity(m_capacity, required);
+		if (grown < required) return required;
+		return grown > limit ? limit : grown;
+	}
+
+	// Makes room for extra more elements, growing by the policy.
+	void reserve_for_(size_type extra)
+	{
+		if (extra > m_capacity - m_size) { grow_exact_(next_capacity_(m_size + extra)); }
+	}
+
+	// The new element is built in the new buffer first, so args may refer to elements of the old one.
+	template <class... Args> reference grow_emplace_back_(Args&&... args)
+	{
+		const size_type new_cap = next_capacity_(m_size + 1);
+		pointer new_data		= alloc_traits::allocate(m_alloc, new_cap);
+		try
+		{
+			::new (static_cast<void*>(new_data + m_size)) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			alloc_traits::deallocate(m_alloc, new_data, new_cap);
+			throw;
+		}
+		try
+		{
+			relocate_(new_data, m_data, m_size);
+		}
+		catch (...)
+		{
+			destroy_(new_data + m_size, new_data + m_size + 1);
+			alloc_traits::deallocate(m_alloc, new_data, new_cap);
+			throw;
+		}
+		adopt_(new_data, new_cap);
+		return m_data[m_size++];
+	}
+
+	// Relocates [idx, size) up by count trivially relocatable elements; the caller has reserved the room.
+	void open_gap_(size_type idx, size_type count) noexcept
+	{
+		SNAP_NAMESPACE::uninitialized_relocate_backward(m_data + idx, m_data + m_size, m_data + m_size + count);
+	}
+
+	// Grows to count elements constructed from args within the current capacity, with rollback.
+	template <class... Args> void construct_tail_(size_type count, const Args&... args)
+	{
+		size_type i = m_size;
+		try
+		{
+			for (; i < count; ++i) ::new (static_cast<void*>(m_data + i)) T(args...);
+		}
+		catch (...)
+		{
+			destroy_(m_data + m_size, m_data + i);
+			throw;
+		}
+		m_size = count;
+	}
+
+	// Appends n elements read from first within the current capacity, with rollback.
+	template <class It> void append_n_(It first, size_type n)
+	{
+		if constexpr (is_memcpy_source_v<It>)
+		{
+			if (n != 0) std::memcpy(static_cast<void*>(m_data + m_size), static_cast<const void*>(first), n * sizeof(T));
+			m_size += n;
+		}
+		else
+		{
+			const size_type count = m_size + n;
+			size_type i			  = m_size;
+			try
+			{
+				for (; i < count; ++i, ++first) ::new (static_cast<void*>(m_data + i)) T(*first);
+			}
+			catch (...)
+			{
+				destroy_(m_data + m_size, m_data + i);
+				throw;
+			}
+			m_size = count;
+		}
+	}
+
+	// Replaces the contents with n elements read from first, reusing live elements by assignment.
+	template <class It> void assign_n_(It first, size_type n)
+	{
+		if (n > m_capacity)
+		{
+			clear();
+			grow_exact_(n);
+		}
+		const size_type common = n < m_size ? n : m_size;
+		for (size_type i = 0; i < common; ++i, ++first) m_data[i] = *first;
+		if (n > m_size) { append_n_(first, n - m_size); }
+		else
+		{
+			destroy_(m_data + n, m_data + m_size);
+			m_size = n;
+		}
+	}
+
+	pointer m_data;
+	size_type m_size	 = 0;
+	size_type m_capacity = N;
+	SNAP_NO_UNIQUE_ADDRESS_ATTR Alloc m_alloc;
+	internal::raw_storage_for<T> m_inline[N > 0 ? N : 1];
+};
+
+// non-member erase / erase_if
+template <class T, std::size_t N, class Alloc, class Growth, class U>
+typename small_vector<T, N, Alloc, Growth>::size_type erase(small_vector<T, N, Alloc, Growth>& c, const U& value)
+{
+	auto it			   = std::remove(c.begin(), c.end(), value);
+	const auto removed = static_cast<std::size_t>(c.end() - it);
+	c.erase(it, c.end());
+	return removed;
+}
+
+template <class T, std::size_t N, class Alloc, class Growth, class Pred>
+typename small_vector<T, N, Alloc, Growth>::size_type erase_if(small_vector<T, N, Alloc, Growth>& c, Pred pred)
+{
+	auto it			   = std::remove_if(c.begin(), c.end(), pred);
+	const auto removed = static_cast<std::size_t>(c.end() - it);
+	c.erase(it, c.end());
+	return removed;
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_SMALL_VECTOR_HPP
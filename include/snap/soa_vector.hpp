@@ -0,0 +1,650 @@
+#ifndef SNP_INCLUDE_SNAP_SOA_VECTOR_HPP
+#define SNP_INCLUDE_SNAP_SOA_VECTOR_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/cache_line.hpp"
+#include "snap/internal/pp/no_unique_address.hpp"
+#include "snap/memory/relocate.hpp"
+#include "snap/meta/type_list.hpp"
+#include "snap/span.hpp"
+#include "snap/type_traits/is_trivially_relocatable.hpp"
+
+#include <algorithm> // std::equal, std::move
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory> // std::allocator, std::allocator_traits, std::uninitialized_copy
+#include <new>	  // placement new
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+template <class Fields, std::size_t Alignment = internal::cache_line_size, class Alloc = std::allocator<std::byte>> class soa_vector;
+
+// A vector of records stored as a struct of arrays: soa_vector<type_list<float, int>> keeps one contiguous array per
+// field. Code that reads a few fields of every record streams through just those columns.
+//
+// All columns share a single allocation, carved so that each column starts on an Alignment boundary (a cache line by
+// default, which also suits the widest SIMD loads). get<I>() returns column I as a snap::span. Element access goes
+// through proxy references, std::tuple<Fields&...>, which work with std::get and structured bindings. Growth relocates
+// each column with memcpy when its field type is trivially relocatable (see is_trivially_relocatable), moves it when
+// the move cannot throw, and otherwise copies it so that a throwing copy leaves the vector unchanged.
+template <class... Fields, std::size_t Alignment, class Alloc> class soa_vector<type_list<Fields...>, Alignment, Alloc>
+{
+	static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+	static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+	static_assert(((Alignment >= alignof(Fields)) && ...), "Alignment must be at least the alignment of every field");
+	static_assert((std::is_nothrow_destructible_v<Fields> && ...), "soa_vector fields must be nothrow destructible");
+
+	using indices = std::index_sequence_for<Fields...>;
+	using columns = std::tuple<Fields*...>;
+
+	struct alignas(Alignment) block
+	{
+		std::byte bytes[Alignment];
+	};
+
+	using block_alloc  = typename std::allocator_traits<Alloc>::template rebind_alloc<block>;
+	using block_traits = std::allocator_traits<block_alloc>;
+
+	// growth can move every column without a chance of failing halfway
+	static constexpr bool nothrow_transfer = ((is_trivially_relocatable_v<Fields> || std::is_nothrow_move_constructible_v<Fields>) && ...);
+
+	template <bool Const> class basic_iterator
+	{
+		friend class soa_vector;
+
+		using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+		basic_iterator(owner* v, std::size_t index) noexcept : m_owner(v), m_index(index) {}
+
+		owner* m_owner		= nullptr;
+		std::size_t m_index = 0;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type		= std::tuple<Fields...>;
+		using difference_type	= std::ptrdiff_t;
+		using reference			= std::conditional_t<Const, std::tuple<const Fields&...>, std::tuple<Fields&...>>;
+		using pointer			= void;
+
+		basic_iterator() noexcept = default;
+
+		template <bool C = Const, class = std::enable_if_t<C>> basic_iterator(const basic_iterator<false>& other) noexcept
+			: m_owner(other.m_owner), m_index(other.m_index)
+		{
+		}
+
+		reference operator*() const noexcept { return (*m_owner)[m_index]; }
+		reference operator[](difference_type n) const noexcept { return (*m_owner)[m_index + static_cast<std::size_t>(n)]; }
+
+		basic_iterator& operator++() noexcept
+		{
+			++m_index;
+			return *this;
+		}
+		basic_iterator operator++(int) noexcept { return basic_iterator(m_owner, m_index++); }
+		basic_iterator& operator--() noexcept
+		{
+			--m_index;
+			return *this;
+		}
+		basic_iterator operator--(int) noexcept { return basic_iterator(m_owner, m_index--); }
+		basic_iterator& operator+=(difference_type n) noexcept
+		{
+			m_index += static_cast<std::size_t>(n);
+			return *this;
+		}
+		basic_iterator& operator-=(difference_type n) noexcept
+		{
+			m_index -= static_cast<std::size_t>(n);
+			return *this;
+		}
+
+		friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+		friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+		friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+		friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return static_cast<difference_type>(a.m_index) - static_cast<difference_type>(b.m_index);
+		}
+
+		friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.m_index == b.m_index; }
+		friend bool operator!=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.m_index != b.m_index; }
+		friend bool operator<(const basic_iterator& a, const basic_iterator& b) noexcept { return a.m_index < b.m_index; }
+		friend bool operator>(const basic_iterator& a, const basic_iterator& b) noexcept { return a.m_index > b.m_index; }
+		friend bool operator<=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.m_index <= b.m_index; }
+		friend bool operator>=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.m_index >= b.m_index; }
+	};
+
+public:
+	// member types
+	using fields		  = type_list<Fields...>;
+	using value_type	  = std::tuple<Fields...>;
+	using allocator_type  = Alloc;
+	using size_type		  = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference		  = std::tuple<Fields&...>;
+	using const_reference = std::tuple<const Fields&...>;
+	using iterator		  = basic_iterator<false>;
+	using const_iterator  = basic_iterator<true>;
+
+	template <std::size_t I> using field_type = typelist::at_t<fields, I>;
+
+	static constexpr size_type field_count		= sizeof...(Fields);
+	static constexpr size_type column_alignment = Alignment;
+
+	// constructors
+	soa_vector() noexcept(std::is_nothrow_default_constructible_v<Alloc>) : soa_vector(Alloc()) {}
+
+	explicit soa_vector(const Alloc& alloc) noexcept : m_alloc(alloc) {}
+
+	explicit soa_vector(size_type count, const Alloc& alloc = Alloc()) : soa_vector(alloc) { resize(count); }
+
+	soa_vector(size_type count, const value_type& value, const Alloc& alloc = Alloc()) : soa_vector(alloc) { resize(count, value); }
+
+	soa_vector(std::initializer_list<value_type> il, const Alloc& alloc = Alloc()) : soa_vector(alloc)
+	{
+		reserve(il.size());
+		for (const value_type& row : il) push_back(row);
+	}
+
+	soa_vector(const soa_vector& other)
+		: soa_vector(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.m_alloc))
+	{
+		reserve(other.m_size);
+		copy_columns_(other.m_columns, other.m_size, indices{});
+	}
+
+	soa_vector(soa_vector&& other) noexcept : m_alloc(std::move(other.m_alloc)) { take_(other); }
+
+	~soa_vector()
+	{
+		clear();
+		release_();
+	}
+
+	// assignment
+	soa_vector& operator=(const soa_vector& rhs)
+	{
+		if (this == &rhs) return *this;
+		clear();
+		if constexpr (std::allocator_traits<Alloc>::propagate_on_container_copy_assignment::value)
+		{
+			if (m_alloc != rhs.m_alloc) release_();
+			m_alloc = rhs.m_alloc;
+		}
+		reserve(rhs.m_size);
+		copy_columns_(rhs.m_columns, rhs.m_size, indices{});
+		return *this;
+	}
+
+	soa_vector& operator=(soa_vector&& rhs) noexcept(std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+													 std::allocator_traits<Alloc>::is_always_equal::value)
+	{
+		if (this == &rhs) return *this;
+		clear();
+		if (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value || m_alloc == rhs.m_alloc)
+		{
+			release_();
+			if constexpr (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value) { m_alloc = std::move(rhs.m_alloc); }
+			take_(rhs);
+		}
+		else
+		{
+			// unequal allocators that do not propagate: the buffer cannot change hands
+			reserve(rhs.m_size);
+			move_rows_from_(rhs, indices{});
+			rhs.clear();
+		}
+		return *this;
+	}
+
+	[[nodiscard]] allocator_type get_allocator() const noexcept { return m_alloc; }
+
+	// columns
+	template <std::size_t I> span<field_type<I>> get() noexcept { return span<field_type<I>>(std::get<I>(m_columns), m_size); }
+	template <std::size_t I> span<const field_type<I>> get() const noexcept { return span<const field_type<I>>(std::get<I>(m_columns), m_size); }
+
+	// Column of field type T, which must appear exactly once in Fields.
+	template <class T> span<T> get() noexcept { return get<unique_index_<T>()>(); }
+	template <class T> span<const T> get() const noexcept { return get<unique_index_<T>()>(); }
+
+	template <std::size_t I> field_type<I>* data() noexcept { return std::get<I>(m_columns); }
+	template <std::size_t I> const field_type<I>* data() const noexcept { return std::get<I>(m_columns); }
+
+	// element access
+	reference operator[](size_type pos) noexcept { return row_(pos, indices{}); }
+	const_reference operator[](size_type pos) const noexcept { return row_(pos, indices{}); }
+
+	reference at(size_type pos)
+	{
+		if (pos >= m_size) throw std::out_of_range("soa_vector::at");
+		return (*this)[pos];
+	}
+	const_reference at(size_type pos) const
+	{
+		if (pos >= m_size) throw std::out_of_range("soa_vector::at");
+		return (*this)[pos];
+	}
+
+	reference front() noexcept { return (*this)[0]; }
+	const_reference front() const noexcept { return (*this)[0]; }
+	reference back() noexcept { return (*this)[m_size - 1]; }
+	const_reference back() const noexcept { return (*this)[m_size - 1]; }
+
+	// iterators
+	iterator begin() noexcept { return iterator(this, 0); }
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+	const_iterator cbegin() const noexcept { return begin(); }
+	iterator end() noexcept { return iterator(this, m_size); }
+	const_iterator end() const noexcept { return const_iterator(this, m_size); }
+	const_iterator cend() const noexcept { return end(); }
+
+	// size & capacity
+	[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+	size_type size() const noexcept { return m_size; }
+	size_type capacity() const noexcept { return m_capacity; }
+	size_type max_size() const noexcept
+	{
+		// every column may waste up to Alignment - 1 bytes of padding
+		constexpr size_type row_bytes	  = (sizeof(Fields) + ...);
+		constexpr size_type max_blocks = static_cast<size_type>(std::numeric_limits<difference_type>::max()) / Alignment;
+		const size_type by_alloc	   = block_traits::max_size(block_alloc(m_alloc));
+		const size_type blocks		   = by_alloc < max_blocks ? by_alloc : max_blocks;
+		return blocks <= field_count ? 0 : (blocks - field_count) * Alignment / row_bytes;
+	}
+
+	void reserve(size_type new_cap)
+	{
+		if (new_cap <= m_capacity) return;
+		if (new_cap > max_size()) throw std::length_error("soa_vector::reserve");
+		reallocate_(new_cap);
+	}
+
+	// Non-binding: keeps the current buffer if the transfer throws.
+	void shrink_to_fit() noexcept
+	{
+		if (m_size == m_capacity) return;
+		try
+		{
+			if (m_size == 0) { release_(); }
+			else { reallocate_(m_size); }
+		}
+		catch (...)
+		{
+			// keep the current buffer
+		}
+	}
+
+	// modifiers
+	void clear() noexcept
+	{
+		destroy_columns_(m_columns, 0, m_size, indices{});
+		m_size = 0;
+	}
+
+	void push_back(const value_type& row) { std::apply([this](const Fields&... f) { emplace_row_(f...); }, row); }
+	void push_back(value_type&& row) { std::apply([this](Fields&... f) { emplace_row_(std::move(f)...); }, row); }
+
+	// Constructs field I of the new record from args...[I].
+	template <class... Args, class = std::enable_if_t<sizeof...(Args) == sizeof...(Fields)>> reference emplace_back(Args&&... args)
+	{
+		emplace_row_(std::forward<Args>(args)...);
+		return back();
+	}
+
+	// pop_back: precondition !empty()
+	void pop_back() noexcept
+	{
+		--m_size;
+		destroy_columns_(m_columns, m_size, m_size + 1, indices{});
+	}
+
+	void resize(size_type count)
+	{
+		if (count <= m_size)
+		{
+			destroy_columns_(m_columns, count, m_size, indices{});
+			m_size = count;
+			return;
+		}
+		reserve(count);
+		while (m_size < count)
+		{
+			construct_row_(m_columns, m_size, [](auto field, void* where) { ::new (where) field_type<decltype(field)::value>(); });
+			++m_size;
+		}
+	}
+
+	void resize(size_type count, const value_type& value)
+	{
+		if (count <= m_size)
+		{
+			destroy_columns_(m_columns, count, m_size, indices{});
+			m_size = count;
+			return;
+		}
+		if (count > m_capacity)
+		{
+			const value_type copy(value); // value may live in the buffer that is about to be released
+			reserve(count);
+			while (m_size < count) push_back(copy);
+		}
+		else
+		{
+			while (m_size < count) push_back(value);
+		}
+	}
+
+	iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		const size_type from  = first.m_index;
+		const size_type count = last.m_index - from;
+		if (count != 0)
+		{
+			shift_down_(from, count, indices{});
+			destroy_columns_(m_columns, m_size - count, m_size, indices{});
+			m_size -= count;
+		}
+		return iterator(this, from);
+	}
+
+	void swap(soa_vector& other) noexcept
+	{
+		using std::swap;
+		if constexpr (std::allocator_traits<Alloc>::propagate_on_container_swap::value) { swap(m_alloc, other.m_alloc); }
+		swap(m_data, other.m_data);
+		swap(m_columns, other.m_columns);
+		swap(m_size, other.m_size);
+		swap(m_capacity, other.m_capacity);
+	}
+
+	friend bool operator==(const soa_vector& a, const soa_vector& b) { return a.m_size == b.m_size && equal_columns_(a, b, indices{}); }
+	friend bool operator!=(const soa_vector& a, const soa_vector& b) { return !(a == b); }
+
+	friend void swap(soa_vector& a, soa_vector& b) noexcept { a.swap(b); }
+
+private:
+	template <class T> static constexpr std::size_t unique_index_()
+	{
+		static_assert(typelist::contains_v<fields, T>, "soa_vector has no field of this type");
+		static_assert(typelist::size_v<typelist::filter_t<fields, same_as_<T>::template test>> == 1, "soa_vector has several fields of this type");
+		return typelist::index_of_v<fields, T>;
+	}
+
+	template <class T> struct same_as_
+	{
+		template <class U> using test = std::is_same<T, U>;
+	};
+
+	static constexpr size_type column_bytes_(size_type capacity, size_type element_size) noexcept
+	{
+		return (capacity * element_size + Alignment - 1) / Alignment * Alignment;
+	}
+
+	static constexpr size_type blocks_for_(size_type capacity) noexcept { return (column_bytes_(capacity, sizeof(Fields)) + ...) / Alignment; }
+
+	template <std::size_t... I> static columns carve_(block* data, size_type capacity, std::index_sequence<I...>) noexcept
+	{
+		columns out{};
+		auto* next = reinterpret_cast<std::byte*>(data);
+		((std::get<I>(out) = reinterpret_cast<Fields*>(next), next += column_bytes_(capacity, sizeof(Fields))), ...);
+		return out;
+	}
+
+	template <std::size_t... I> reference row_(size_type pos, std::index_sequence<I...>) noexcept { return reference(std::get<I>(m_columns)[pos]...); }
+	template <std::size_t... I> const_reference row_(size_type pos, std::index_sequence<I...>) const noexcept
+	{
+		return const_reference(std::get<I>(m_columns)[pos]...);
+	}
+
+	template <std::size_t I> static void destroy_column_(const columns& cols, size_type first, size_type last) noexcept
+	{
+		using field = field_type<I>;
+		if constexpr (!std::is_trivially_destructible_v<field>)
+		{
+			for (size_type i = first; i < last; ++i) std::get<I>(cols)[i].~field();
+		}
+	}
+
+	template <std::size_t... I> static void destroy_columns_(const columns& cols, size_type first, size_type last, std::index_sequence<I...>) noexcept
+	{
+		(destroy_column_<I>(cols, first, last), ...);
+	}
+
+	// Constructs the fields of row `row` one after another with make(integral_constant<I>, where); if one throws, the
+	// fields already built are destroyed.
+	template <class Make> static void construct_row_(const columns& cols, size_type row, Make make)
+	{
+		construct_row_(cols, row, make, indices{});
+	}
+
+	template <class Make, std::size_t... I> static void construct_row_(const columns& cols, size_type row, Make& make, std::index_sequence<I...>)
+	{
+		size_type built = 0;
+		try
+		{
+			((make(std::integral_constant<std::size_t, I>{}, static_cast<void*>(std::get<I>(cols) + row)), ++built), ...);
+		}
+		catch (...)
+		{
+			((I < built ? destroy_column_<I>(cols, row, row + 1) : void()), ...);
+			throw;
+		}
+	}
+
+	// Appends a record. When the buffer is full the record is built in the new buffer before the old one is released,
+	// so args may refer to elements of *this.
+	template <class... Args> void emplace_row_(Args&&... args)
+	{
+		auto make = [&](auto field, void* where)
+		{
+			constexpr std::size_t I = decltype(field)::value;
+			::new (where) field_type<I>(std::get<I>(std::forward_as_tuple(std::forward<Args>(args)...)));
+		};
+		if (m_size < m_capacity)
+		{
+			construct_row_(m_columns, m_size, make);
+			++m_size;
+			return;
+		}
+
+		const size_type new_cap = next_capacity_();
+		block_alloc alloc(m_alloc);
+		block* data				  = block_traits::allocate(alloc, blocks_for_(new_cap));
+		const columns new_columns = carve_(data, new_cap, indices{});
+		try
+		{
+			construct_row_(new_columns, m_size, make);
+		}
+		catch (...)
+		{
+			block_traits::deallocate(alloc, data, blocks_for_(new_cap));
+			throw;
+		}
+		try
+		{
+			transfer_(new_columns, indices{});
+		}
+		catch (...)
+		{
+			destroy_columns_(new_columns, m_size, m_size + 1, indices{});
+			block_traits::deallocate(alloc, data, blocks_for_(new_cap));
+			throw;
+		}
+		adopt_(data, new_columns, new_cap);
+		++m_size;
+	}
+
+	size_type next_capacity_() const
+	{
+		const size_type limit = max_size();
+		if (m_size == limit) throw std::length_error("soa_vector: too many elements");
+		if (m_capacity > limit / 2) return limit;
+		return m_capacity < 8 ? 8 : 2 * m_capacity;
+	}
+
+	void reallocate_(size_type new_cap)
+	{
+		block_alloc alloc(m_alloc);
+		block* data				  = block_traits::allocate(alloc, blocks_for_(new_cap));
+		const columns new_columns = carve_(data, new_cap, indices{});
+		try
+		{
+			transfer_(new_columns, indices{});
+		}
+		catch (...)
+		{
+			block_traits::deallocate(alloc, data, blocks_for_(new_cap));
+			throw;
+		}
+		adopt_(data, new_columns, new_cap);
+	}
+
+	// Moves the m_size records into new columns and ends their lifetime in the old ones. Columns whose move may throw
+	// are copied first; the rest are moved only once those copies have succeeded, so a throwing copy leaves every old
+	// column intact.
+	template <std::size_t... I> void transfer_(const columns& to, std::index_sequence<I...>) noexcept(nothrow_transfer)
+	{
+		if constexpr (nothrow_transfer)
+		{
+			(SNAP_NAMESPACE::uninitialized_relocate(std::get<I>(m_columns), std::get<I>(m_columns) + m_size, std::get<I>(to)), ...);
+		}
+		else
+		{
+			size_type done = 0;
+			try
+			{
+				((copy_column_if_throwing_(std::get<I>(m_columns), m_size, std::get<I>(to)), ++done), ...);
+			}
+			catch (...)
+			{
+				((I < done && !std::is_nothrow_move_constructible_v<field_type<I>> ? destroy_column_<I>(to, 0, m_size) : void()), ...);
+				throw;
+			}
+			(move_column_if_nothrow_(std::get<I>(m_columns), m_size, std::get<I>(to)), ...);
+			destroy_columns_(m_columns, 0, m_size, indices{});
+		}
+	}
+
+	// A field without a copy constructor is moved even if that may throw; it then cannot be restored, as with
+	// std::vector.
+	template <class T> static void copy_column_if_throwing_(T* from, size_type n, T* to)
+	{
+		if constexpr (std::is_nothrow_move_constructible_v<T>) { return; }
+		else if constexpr (!std::is_copy_constructible_v<T>)
+		{
+			std::uninitialized_copy(std::make_move_iterator(from), std::make_move_iterator(from + n), to);
+		}
+		else { std::uninitialized_copy(from, from + n, to); }
+	}
+
+	template <class T> static void move_column_if_nothrow_(T* from, size_type n, T* to) noexcept
+	{
+		if constexpr (std::is_nothrow_move_constructible_v<T>)
+		{
+			std::uninitialized_copy(std::make_move_iterator(from), std::make_move_iterator(from + n), to);
+		}
+	}
+
+	template <std::size_t... I> void copy_columns_(const columns& from, size_type n, std::index_sequence<I...>)
+	{
+		size_type done = 0;
+		try
+		{
+			((std::uninitialized_copy(std::get<I>(from), std::get<I>(from) + n, std::get<I>(m_columns) + m_size), ++done), ...);
+		}
+		catch (...)
+		{
+			((I < done ? destroy_column_<I>(m_columns, m_size, m_size + n) : void()), ...);
+			throw;
+		}
+		m_size += n;
+	}
+
+	template <std::size_t... I> void move_rows_from_(soa_vector& other, std::index_sequence<I...>)
+	{
+		for (size_type i = 0; i < other.m_size; ++i) emplace_row_(std::move(std::get<I>(other.m_columns)[i])...);
+	}
+
+	template <std::size_t... I> void shift_down_(size_type from, size_type count, std::index_sequence<I...>)
+	{
+		(std::move(std::get<I>(m_columns) + from + count, std::get<I>(m_columns) + m_size, std::get<I>(m_columns) + from), ...);
+	}
+
+	template <std::size_t... I> static bool equal_columns_(const soa_vector& a, const soa_vector& b, std::index_sequence<I...>)
+	{
+		return (std::equal(std::get<I>(a.m_columns), std::get<I>(a.m_columns) + a.m_size, std::get<I>(b.m_columns)) && ...);
+	}
+
+	void adopt_(block* data, const columns& cols, size_type capacity) noexcept
+	{
+		release_();
+		m_data	   = data;
+		m_columns  = cols;
+		m_capacity = capacity;
+	}
+
+	void release_() noexcept
+	{
+		if (m_data == nullptr) return;
+		block_alloc alloc(m_alloc);
+		block_traits::deallocate(alloc, m_data, blocks_for_(m_capacity));
+		m_data	   = nullptr;
+		m_columns  = columns{};
+		m_capacity = 0;
+	}
+
+	void take_(soa_vector& other) noexcept
+	{
+		m_data	   = std::exchange(other.m_data, nullptr);
+		m_columns  = std::exchange(other.m_columns, columns{});
+		m_size	   = std::exchange(other.m_size, 0);
+		m_capacity = std::exchange(other.m_capacity, 0);
+	}
+
+	block* m_data = nullptr;
+	columns m_columns{};
+	size_type m_size	 = 0;
+	size_type m_capacity = 0;
+	SNAP_NO_UNIQUE_ADDRESS_ATTR Alloc m_alloc;
+};
+
+namespace detail
+{
+	template <class SoaVector, std::size_t... I> void soa_vector_move_row(SoaVector& c, std::size_t to, std::size_t from, std::index_sequence<I...>)
+	{
+		((c.template get<I>()[to] = std::move(c.template get<I>()[from])), ...);
+	}
+} // namespace detail
+
+// non-member erase_if: pred receives a const_reference to each record
+template <class Fields, std::size_t Alignment, class Alloc, class Pred>
+typename soa_vector<Fields, Alignment, Alloc>::size_type erase_if(soa_vector<Fields, Alignment, Alloc>& c, Pred pred)
+{
+	using vector		= soa_vector<Fields, Alignment, Alloc>;
+	const auto& cc		= c;
+	const auto old_size = c.size();
+	std::size_t kept	= 0;
+	for (std::size_t i = 0; i < old_size; ++i)
+	{
+		if (pred(cc[i])) continue;
+		if (kept != i) detail::soa_vector_move_row(c, kept, i, std::make_index_sequence<vector::field_count>{});
+		++kept;
+	}
+	c.erase(c.begin() + static_cast<typename vector::difference_type>(kept), c.end());
+	return old_size - kept;
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_SOA_VECTOR_HPP
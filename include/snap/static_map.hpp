@@ -0,0 +1,279 @@
+#ifndef SNP_INCLUDE_SNAP_STATIC_MAP_HPP
+#define SNP_INCLUDE_SNAP_STATIC_MAP_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/bit/bit_ceil.hpp"
+#include "snap/bit/endian.hpp"
+#include "snap/bit/rotl.hpp"
+#include "snap/fixed_string.hpp"
+#include "snap/internal/compat/std.hpp"
+#include "snap/type_traits/is_constant_evaluated.hpp"
+#include "snap/type_traits/remove_cvref.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace detail
+{
+	// String hash shared by the compile-time build and runtime lookups. Narrow strings are consumed eight bytes at
+	// a time; the result only has to be well mixed, since the table is built around it.
+	template <class CharT> class static_map_hash
+	{
+		static constexpr std::uint64_t k_mul = 0x9FB21C651E98DF25ULL;
+
+		static constexpr std::uint64_t mix_(std::uint64_t h, std::uint64_t word) noexcept { return (rotl(h, 23) ^ word) * k_mul; }
+
+		// little-endian load of n <= 8 bytes
+		static constexpr std::uint64_t load_(const CharT* p, std::size_t n) noexcept
+		{
+			if constexpr (sizeof(CharT) == 1 && endian::native == endian::little)
+			{
+				if (n == 8 && !is_constant_evaluated())
+				{
+					std::uint64_t word = 0;
+					std::memcpy(&word, p, 8);
+					return word;
+				}
+			}
+			std::uint64_t word = 0;
+			for (std::size_t i = 0; i < n; ++i) word |= std::uint64_t{ static_cast<std::make_unsigned_t<CharT>>(p[i]) } << (8 * i);
+			return word;
+		}
+
+	public:
+		// splitmix64 finaliser
+		static constexpr std::uint64_t finalize(std::uint64_t h) noexcept
+		{
+			h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+			return h ^ (h >> 31);
+		}
+
+		static constexpr std::uint64_t hash(std::basic_string_view<CharT> key, std::uint64_t seed) noexcept
+		{
+			const CharT* p		= key.data();
+			const std::size_t n = key.size();
+			std::uint64_t h		= seed ^ (static_cast<std::uint64_t>(n) * 0x9E3779B97F4A7C15ULL);
+			if constexpr (sizeof(CharT) == 1)
+			{
+				std::size_t i = 0;
+				for (; i + 8 <= n; i += 8) h = mix_(h, load_(p + i, 8));
+				if (i != n) h = mix_(h, load_(p + i, n - i));
+			}
+			else
+			{
+				for (std::size_t i = 0; i < n; ++i) h = mix_(h, static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<CharT>>(p[i])));
+			}
+			return finalize(h);
+		}
+	};
+
+	template <std::size_t N>
+	using static_map_index_t = std::conditional_t<N <= UINT8_MAX, std::uint8_t, std::conditional_t<N <= UINT16_MAX, std::uint16_t, std::uint32_t>>;
+} // namespace detail
+
+// An immutable string-keyed map whose hash table is built by the constructor, at compile time when the map is a
+// constexpr variable. The table is a minimal-probe perfect hash in the CHD/PTHash style: every key hashes to a
+// bucket, and each bucket stores the displacement that sends its keys to distinct slots. A lookup hashes the key
+// once, reads one displacement and one slot, and does a single key comparison.
+//
+// Entries keep their input order for iteration. Keys are string views, so they must outlive the map (string
+// literals and fixed_string template arguments do). Duplicate keys make construction throw, which is a compile
+// error in a constant expression.
+template <class V, std::size_t N, class CharT = char> class static_map
+{
+	static_assert(N > 0, "static_map needs at least one entry");
+
+	using index_type = detail::static_map_index_t<N>;
+	using hasher	 = detail::static_map_hash<CharT>;
+
+public:
+	using key_type		 = std::basic_string_view<CharT>;
+	using mapped_type	 = V;
+	using value_type	 = std::pair<key_type, V>;
+	using size_type		 = std::size_t;
+	using const_iterator = const value_type*;
+	using iterator		 = const_iterator;
+
+	// slots at a load factor of at most 0.8, and about two keys per bucket
+	static constexpr size_type table_size	= bit_ceil(N + N / 4 + 1);
+	static constexpr size_type bucket_count = (N + 1) / 2;
+
+	constexpr explicit static_map(const value_type (&entries)[N]) : static_map(entries, std::make_index_sequence<N>{}) {}
+
+	constexpr const_iterator begin() const noexcept { return m_entries.data(); }
+	constexpr const_iterator end() const noexcept { return m_entries.data() + N; }
+	constexpr const_iterator cbegin() const noexcept { return begin(); }
+	constexpr const_iterator cend() const noexcept { return end(); }
+
+	[[nodiscard]] constexpr bool empty() const noexcept { return false; }
+	constexpr size_type size() const noexcept { return N; }
+
+	constexpr const_iterator find(key_type key) const noexcept
+	{
+		const std::uint64_t h = hasher::hash(key, m_seed);
+		const value_type& e	  = m_entries[m_slots[slot_(h, m_displacement[bucket_(h)])]];
+		return e.first == key ? &e : end();
+	}
+
+	constexpr bool contains(key_type key) const noexcept { return find(key) != end(); }
+	constexpr size_type count(key_type key) const noexcept { return contains(key) ? 1 : 0; }
+
+	constexpr const V& at(key_type key) const
+	{
+		const const_iterator it = find(key);
+		if (it == end()) throw std::out_of_range("snap::static_map::at: key not found");
+		return it->second;
+	}
+
+private:
+	// Seeds and displacements tried before giving up; a table of a few hundred keys needs a handful of attempts.
+	static constexpr std::uint64_t max_seeds			   = 64;
+	static constexpr std::uint32_t max_displacement		   = 0xFFFF;
+	static constexpr std::uint64_t displacement_multiplier = 0xD6E8FEB86659FD93ULL;
+
+	static constexpr size_type bucket_(std::uint64_t h) noexcept { return static_cast<size_type>(((h >> 32) * bucket_count) >> 32); }
+
+	static constexpr size_type slot_(std::uint64_t h, std::uint16_t displacement) noexcept
+	{
+		return static_cast<size_type>(hasher::finalize(h ^ (displacement * displacement_multiplier)) & (table_size - 1));
+	}
+
+	template <std::size_t... I>
+	constexpr static_map(const value_type (&entries)[N], std::index_sequence<I...>) : m_entries{ { entries[I]... } }
+	{
+		for (std::uint64_t seed = 0; seed < max_seeds; ++seed)
+		{
+			if (try_build_(seed)) return;
+		}
+		throw std::logic_error("snap::static_map: no perfect hash found");
+	}
+
+	// Places the buckets largest first, trying displacements until each bucket's keys land on free slots.
+	constexpr bool try_build_(std::uint64_t seed)
+	{
+		// a failed seed leaves its placements behind
+		m_displacement = {};
+		m_slots		   = {};
+
+		std::array<std::uint64_t, N> hashes{};
+		std::array<size_type, bucket_count + 1> start{};
+		for (size_type i = 0; i < N; ++i)
+		{
+			hashes[i] = hasher::hash(m_entries[i].first, seed);
+			++start[bucket_(hashes[i]) + 1];
+		}
+		size_type largest = 0;
+		for (size_type b = 0; b < bucket_count; ++b)
+		{
+			if (start[b + 1] > largest) largest = start[b + 1];
+			start[b + 1] += start[b];
+		}
+
+		// keys grouped by bucket
+		std::array<index_type, N> members{};
+		std::array<size_type, bucket_count> fill{};
+		for (size_type i = 0; i < N; ++i)
+		{
+			const size_type b			  = bucket_(hashes[i]);
+			members[start[b] + fill[b]++] = static_cast<index_type>(i);
+		}
+
+		std::array<bool, table_size> taken{};
+		for (size_type size = largest; size > 0; --size)
+		{
+			for (size_type b = 0; b < bucket_count; ++b)
+			{
+				if (start[b + 1] - start[b] != size) continue;
+				for (size_type x = start[b]; x < start[b + 1]; ++x)
+				{
+					for (size_type y = start[b]; y < x; ++y)
+					{
+						if (hashes[members[x]] != hashes[members[y]]) continue;
+						if (m_entries[members[x]].first == m_entries[members[y]].first) throw std::invalid_argument("snap::static_map: duplicate key");
+						return false; // a full hash collision no displacement can separate
+					}
+				}
+				if (!place_bucket_(hashes, members, start[b], start[b + 1], taken, b)) return false;
+			}
+		}
+		m_seed = seed;
+		return true;
+	}
+
+	constexpr bool place_bucket_(const std::array<std::uint64_t, N>& hashes,
+								 const std::array<index_type, N>& members,
+								 size_type first,
+								 size_type last,
+								 std::array<bool, table_size>& taken,
+								 size_type bucket)
+	{
+		for (std::uint32_t d = 0; d <= max_displacement; ++d)
+		{
+			const auto displacement = static_cast<std::uint16_t>(d);
+			size_type placed		= first;
+			for (; placed < last; ++placed)
+			{
+				const size_type slot = slot_(hashes[members[placed]], displacement);
+				if (taken[slot]) break;
+				taken[slot]	  = true;
+				m_slots[slot] = members[placed];
+			}
+			if (placed == last)
+			{
+				m_displacement[bucket] = displacement;
+				return true;
+			}
+			while (placed-- > first) taken[slot_(hashes[members[placed]], displacement)] = false;
+		}
+		return false;
+	}
+
+	std::array<value_type, N> m_entries;
+	std::array<std::uint16_t, bucket_count> m_displacement{};
+	std::array<index_type, table_size> m_slots{}; // unused slots point at entry 0; find compares the key, so any entry is safe
+	std::uint64_t m_seed = 0;
+};
+
+// Builds a static_map from a braced list: `constexpr auto m = make_static_map<int>({ { "GET", 1 }, { "PUT", 2 } });`
+template <class V, class CharT = char, std::size_t N>
+constexpr static_map<V, N, CharT> make_static_map(const std::pair<std::basic_string_view<CharT>, V> (&entries)[N])
+{
+	return static_map<V, N, CharT>(entries);
+}
+
+#if SNAP_HAS_CPP20 && defined(__cpp_nontype_template_args) && (__cpp_nontype_template_args >= 201911L)
+namespace detail
+{
+	template <auto First, auto...> struct static_map_key_char
+	{
+		using type = typename remove_cvref_t<decltype(First)>::value_type;
+	};
+} // namespace detail
+
+// Builds a static_map whose keys are fixed_string template arguments: `make_static_map<"GET", "PUT">(1, 2)`.
+template <basic_fixed_string... Keys, class... Values>
+constexpr auto make_static_map(Values... values)
+	-> static_map<std::common_type_t<Values...>, sizeof...(Keys), typename detail::static_map_key_char<Keys...>::type>
+{
+	static_assert(sizeof...(Keys) == sizeof...(Values), "one value per key");
+	using char_type	 = typename detail::static_map_key_char<Keys...>::type;
+	using value_type = std::pair<std::basic_string_view<char_type>, std::common_type_t<Values...>>;
+	const value_type entries[] = { value_type(Keys.view(), values)... };
+	return static_map<std::common_type_t<Values...>, sizeof...(Keys), char_type>(entries);
+}
+#endif
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_STATIC_MAP_HPP
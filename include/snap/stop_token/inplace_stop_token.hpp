@@ -0,0 +1,111 @@
+#ifndef SNP_INCLUDE_SNAP_STOP_TOKEN_INPLACE_STOP_TOKEN_HPP
+#define SNP_INCLUDE_SNAP_STOP_TOKEN_INPLACE_STOP_TOKEN_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/pp/no_unique_address.hpp"
+#include "snap/stop_token/stop_state.hpp"
+
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+class inplace_stop_source;
+template <class Callback> class inplace_stop_callback;
+
+// C++26 std::inplace_stop_token.
+// A plain pointer to the stop_state embedded in an inplace_stop_source: copies are free and never touch a refcount.
+// The token must not outlive its source.
+class inplace_stop_token
+{
+public:
+	inplace_stop_token() noexcept = default;
+
+	void swap(inplace_stop_token& other) noexcept { std::swap(state_, other.state_); }
+
+	[[nodiscard]] bool stop_requested() const noexcept { return state_ != nullptr && state_->stop_requested(); }
+
+	[[nodiscard]] bool stop_possible() const noexcept { return state_ != nullptr; }
+
+	friend bool operator==(const inplace_stop_token& a, const inplace_stop_token& b) noexcept { return a.state_ == b.state_; }
+	friend bool operator!=(const inplace_stop_token& a, const inplace_stop_token& b) noexcept { return !(a == b); }
+
+	friend void swap(inplace_stop_token& a, inplace_stop_token& b) noexcept { a.swap(b); }
+
+private:
+	explicit inplace_stop_token(stop_state* state) noexcept : state_(state) {}
+
+	stop_state* state_ = nullptr;
+
+	friend class inplace_stop_source;
+	template <class Callback> friend class inplace_stop_callback;
+};
+
+// C++26 std::inplace_stop_source.
+// Owns its stop_state by value, so creating one never allocates. Neither copyable nor movable, since tokens and
+// callbacks point into it. Every inplace_stop_callback must be destroyed before the source.
+class inplace_stop_source
+{
+public:
+	inplace_stop_source() noexcept { state_.increment_stop_source_counter(); }
+
+	~inplace_stop_source() { state_.decrement_stop_source_counter(); }
+
+	inplace_stop_source(const inplace_stop_source&)			   = delete;
+	inplace_stop_source(inplace_stop_source&&)				   = delete;
+	inplace_stop_source& operator=(const inplace_stop_source&) = delete;
+	inplace_stop_source& operator=(inplace_stop_source&&)	   = delete;
+
+	[[nodiscard]] inplace_stop_token get_token() const noexcept { return inplace_stop_token(&state_); }
+
+	[[nodiscard]] static constexpr bool stop_possible() noexcept { return true; }
+
+	[[nodiscard]] bool stop_requested() const noexcept { return state_.stop_requested(); }
+
+	bool request_stop() noexcept { return state_.request_stop(); }
+
+private:
+	// Mutable because get_token() is const but tokens and callbacks mutate the shared state.
+	mutable stop_state state_{};
+};
+
+// C++26 std::inplace_stop_callback. Same registration semantics as stop_callback, without touching a refcount.
+template <class Callback> class inplace_stop_callback : private stop_callback_base
+{
+	static_assert(std::is_invocable_v<Callback>, "Callback must be invocable with no arguments");
+	static_assert(std::is_destructible_v<Callback>, "Callback must be destructible");
+
+public:
+	using callback_type = Callback;
+
+	template <class C, std::enable_if_t<std::is_constructible_v<Callback, C>, int> = 0>
+	explicit inplace_stop_callback(inplace_stop_token st, C&& cb) noexcept(std::is_nothrow_constructible_v<Callback, C>)
+		: stop_callback_base(&inplace_stop_callback::invoke_callback), callback_(std::forward<C>(cb))
+	{
+		if (st.state_ != nullptr && st.state_->add_callback(this)) { state_ = st.state_; }
+	}
+
+	~inplace_stop_callback()
+	{
+		if (state_ != nullptr) { state_->remove_callback(this); }
+	}
+
+	inplace_stop_callback(const inplace_stop_callback&)			   = delete;
+	inplace_stop_callback(inplace_stop_callback&&)				   = delete;
+	inplace_stop_callback& operator=(const inplace_stop_callback&) = delete;
+	inplace_stop_callback& operator=(inplace_stop_callback&&)	   = delete;
+
+private:
+	static void invoke_callback(stop_callback_base* base) noexcept { std::forward<Callback>(static_cast<inplace_stop_callback*>(base)->callback_)(); }
+
+	SNAP_NO_UNIQUE_ADDRESS_ATTR Callback callback_;
+	stop_state* state_ = nullptr;
+};
+
+template <class Callback> inplace_stop_callback(inplace_stop_token, Callback) -> inplace_stop_callback<Callback>;
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_STOP_TOKEN_INPLACE_STOP_TOKEN_HPP
@@ -17,8 +17,22 @@ SNAP_BEGIN_NAMESPACE
 //   template<> struct intrusive_shared_ptr_traits<MyType> {
 //     static std::atomic<unsigned>& get_atomic_ref_count(MyType& obj) noexcept { return obj.refcnt; }
 //   };
+// The specialization may also provide `static void deallocate(MyType* obj) noexcept`, which is then used instead of
+// `delete` when the last reference is dropped (for objects that came from an allocator or a pool).
 template <class T> struct intrusive_shared_ptr_traits;
 
+namespace internal::detail
+{
+	template <class T, class = void> struct has_intrusive_deallocate : std::false_type
+	{
+	};
+
+	template <class T>
+	struct has_intrusive_deallocate<T, std::void_t<decltype(intrusive_shared_ptr_traits<T>::deallocate(static_cast<T*>(nullptr)))>> : std::true_type
+	{
+	};
+} // namespace internal::detail
+
 // A lightweight intrusive shared pointer.
 // The pointee T stores its own atomic refcount, exposed via intrusive_shared_ptr_traits<T>.
 template <class T> class intrusive_shared_ptr
@@ -87,7 +101,11 @@ private:
 
 	static void decrement_ref_count(T& obj) noexcept
 	{
-		if (get_atomic_ref_count(obj).fetch_sub(1, std::memory_order_acq_rel) == 1) { delete std::addressof(obj); }
+		if (get_atomic_ref_count(obj).fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			if constexpr (internal::detail::has_intrusive_deallocate<T>::value) { intrusive_shared_ptr_traits<T>::deallocate(std::addressof(obj)); }
+			else { delete std::addressof(obj); }
+		}
 	}
 
 	static decltype(auto) get_atomic_ref_count(T& obj) noexcept
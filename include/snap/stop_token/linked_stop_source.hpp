@@ -0,0 +1,74 @@
+#ifndef SNP_INCLUDE_SNAP_STOP_TOKEN_LINKED_STOP_SOURCE_HPP
+#define SNP_INCLUDE_SNAP_STOP_TOKEN_LINKED_STOP_SOURCE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/stop_token/intrusive_shared_ptr.hpp"
+#include "snap/stop_token/stop_source.hpp"
+#include "snap/stop_token/stop_state.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+SNAP_BEGIN_NAMESPACE
+
+// A stop source that is also stopped when any of its N parent tokens is stopped.
+//
+// Each parent stop_state holds a stop_link to this source's state, and request_stop() on a parent pushes the stop
+// bit down that link before running the parent's own callbacks. A child token's stop_requested() is therefore the
+// same single acquire load as for any other token, and deep chains (server -> connection -> request) cost one link
+// per edge rather than a stop_callback per level. Calling request_stop() on the linked source stops it and its
+// descendants only, never its parents.
+//
+// Neither copyable nor movable: the parents point at the links stored inside this object.
+template <std::size_t N> class linked_stop_source
+{
+public:
+	template <class... Tokens,
+			  std::enable_if_t<sizeof...(Tokens) == N && (std::is_same_v<std::remove_cv_t<std::remove_reference_t<Tokens>>, stop_token> && ...), int> = 0>
+	explicit linked_stop_source(const Tokens&... parents) : source_()
+	{
+		[[maybe_unused]] std::size_t i = 0;
+		(link_to(parents, i++), ...);
+	}
+
+	~linked_stop_source()
+	{
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			if (parents_[i]) { parents_[i]->remove_child(&links_[i]); }
+		}
+	}
+
+	linked_stop_source(const linked_stop_source&)			 = delete;
+	linked_stop_source(linked_stop_source&&)				 = delete;
+	linked_stop_source& operator=(const linked_stop_source&) = delete;
+	linked_stop_source& operator=(linked_stop_source&&)		 = delete;
+
+	[[nodiscard]] stop_token get_token() const noexcept { return source_.get_token(); }
+
+	[[nodiscard]] static constexpr bool stop_possible() noexcept { return true; }
+
+	[[nodiscard]] bool stop_requested() const noexcept { return source_.stop_requested(); }
+
+	bool request_stop() noexcept { return source_.request_stop(); }
+
+private:
+	void link_to(const stop_token& parent, std::size_t i) noexcept
+	{
+		links_[i].child = source_.state_.operator->();
+		if (parent.state_ && parent.state_->add_child(&links_[i])) { parents_[i] = parent.state_; }
+	}
+
+	stop_source source_;
+	std::array<stop_link, N> links_{};
+	std::array<intrusive_shared_ptr<stop_state>, N> parents_{};
+};
+
+template <class... Tokens> linked_stop_source(const Tokens&...) -> linked_stop_source<sizeof...(Tokens)>;
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_STOP_TOKEN_LINKED_STOP_SOURCE_HPP
@@ -0,0 +1,71 @@
+#ifndef SNP_INCLUDE_SNAP_STOP_TOKEN_STOP_CALLBACK_HPP
+#define SNP_INCLUDE_SNAP_STOP_TOKEN_STOP_CALLBACK_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/pp/no_unique_address.hpp"
+#include "snap/stop_token/intrusive_shared_ptr.hpp"
+#include "snap/stop_token/stop_source.hpp"
+#include "snap/stop_token/stop_state.hpp"
+
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+// C++20 std::stop_callback.
+// The callback is stored inline in the node that is linked into the stop_state, so registration never allocates.
+// If stop was already requested, the callback runs inside the constructor.
+// The destructor unregisters; if the callback is running on another thread it blocks until it returns,
+// and if it is running on this thread (the callback destroys its own stop_callback) it returns immediately.
+template <class Callback> class stop_callback : private stop_callback_base
+{
+	static_assert(std::is_invocable_v<Callback>, "Callback must be invocable with no arguments");
+	static_assert(std::is_destructible_v<Callback>, "Callback must be destructible");
+
+public:
+	using callback_type = Callback;
+
+	template <class C, std::enable_if_t<std::is_constructible_v<Callback, C>, int> = 0>
+	explicit stop_callback(const stop_token& st, C&& cb) noexcept(std::is_nothrow_constructible_v<Callback, C>)
+		: stop_callback(st.state_, std::forward<C>(cb))
+	{
+	}
+
+	template <class C, std::enable_if_t<std::is_constructible_v<Callback, C>, int> = 0>
+	explicit stop_callback(stop_token&& st, C&& cb) noexcept(std::is_nothrow_constructible_v<Callback, C>)
+		: stop_callback(std::move(st.state_), std::forward<C>(cb))
+	{
+	}
+
+	~stop_callback()
+	{
+		if (state_) { state_->remove_callback(this); }
+	}
+
+	stop_callback(const stop_callback&)			   = delete;
+	stop_callback(stop_callback&&)				   = delete;
+	stop_callback& operator=(const stop_callback&) = delete;
+	stop_callback& operator=(stop_callback&&)	   = delete;
+
+private:
+	// The callback is constructed before the node is published, so a concurrent request_stop() never sees it half built.
+	template <class StatePtr, class C>
+	stop_callback(StatePtr&& state, C&& cb) noexcept(std::is_nothrow_constructible_v<Callback, C>)
+		: stop_callback_base(&stop_callback::invoke_callback), callback_(std::forward<C>(cb))
+	{
+		if (state && state->add_callback(this)) { state_ = std::forward<StatePtr>(state); }
+	}
+
+	static void invoke_callback(stop_callback_base* base) noexcept { std::forward<Callback>(static_cast<stop_callback*>(base)->callback_)(); }
+
+	SNAP_NO_UNIQUE_ADDRESS_ATTR Callback callback_;
+	intrusive_shared_ptr<stop_state> state_{};
+};
+
+template <class Callback> stop_callback(stop_token, Callback) -> stop_callback<Callback>;
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_STOP_TOKEN_STOP_CALLBACK_HPP
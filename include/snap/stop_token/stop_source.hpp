@@ -5,7 +5,11 @@
 
 #include "snap/stop_token/intrusive_shared_ptr.hpp"
 #include "snap/stop_token/stop_state.hpp"
+#include "snap/stop_token/stop_state_allocation.hpp"
 
+#include <cstddef>
+#include <memory> // std::allocator_arg_t
+#include <thread>
 #include <utility>
 
 SNAP_BEGIN_NAMESPACE
@@ -17,7 +21,17 @@ struct nostopstate_t
 
 inline constexpr nostopstate_t nostopstate{};
 
+// Selects the sharded callback registration mode of stop_state (see stop_state::enable_callback_sharding).
+struct sharded_callbacks_t
+{
+	explicit constexpr sharded_callbacks_t() noexcept = default;
+};
+
+inline constexpr sharded_callbacks_t sharded_callbacks{};
+
 class stop_source;
+template <class Callback> class stop_callback;
+template <std::size_t N> class linked_stop_source;
 
 class stop_token
 {
@@ -46,12 +60,28 @@ private:
 	explicit stop_token(intrusive_shared_ptr<stop_state> state) noexcept : state_(std::move(state)) {}
 
 	friend class stop_source;
+	template <class Callback> friend class stop_callback;
+	template <std::size_t N> friend class linked_stop_source;
 };
 
 class stop_source
 {
 public:
-	stop_source() : state_(new stop_state()) { state_->increment_stop_source_counter(); }
+	// The shared state comes from a per-thread cache of stop_state blocks, so steady-state creation skips malloc.
+	stop_source() : state_(internal::make_pooled_stop_state()) { state_->increment_stop_source_counter(); }
+
+	// Allocates the shared state with `alloc` (rebound); the allocator is kept with the state and used to free it.
+	template <class Alloc> stop_source(std::allocator_arg_t, const Alloc& alloc) : state_(internal::make_allocated_stop_state(alloc))
+	{
+		state_->increment_stop_source_counter();
+	}
+
+	// For tokens shared by many concurrently registering callbacks. A shard_count of 0 picks one per hardware thread.
+	stop_source(sharded_callbacks_t, std::size_t shard_count = 0) : stop_source()
+	{
+		if (shard_count == 0) { shard_count = std::thread::hardware_concurrency(); }
+		state_->enable_callback_sharding(shard_count);
+	}
 
 	explicit stop_source(nostopstate_t) noexcept {}
 
@@ -94,6 +124,8 @@ public:
 
 private:
 	intrusive_shared_ptr<stop_state> state_{};
+
+	template <std::size_t N> friend class linked_stop_source;
 };
 
 SNAP_END_NAMESPACE
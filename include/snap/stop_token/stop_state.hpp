@@ -4,12 +4,15 @@
 // Must be included first
 #include "snap/internal/abi_namespace.hpp"
 
+#include "snap/bit/bit_ceil.hpp"
 #include "snap/internal/helpers/atomic_helpers.hpp"
+#include "snap/internal/helpers/cache_line.hpp"
 #include "snap/stop_token/atomic_unique_lock.hpp"
 #include "snap/stop_token/intrusive_list_view.hpp"
 
 #include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <thread>
@@ -32,19 +35,65 @@ struct stop_callback_base : intrusive_node_base<stop_callback_base>
 	bool* destroyed = nullptr;
 };
 
+class stop_state;
+
+// Parent-to-child edge of a linked stop_source tree, owned by the child side and registered with the parent.
+struct stop_link : intrusive_node_base<stop_link>
+{
+	stop_state* child = nullptr;
+
+	std::atomic<bool> completed{ false };
+	bool* destroyed = nullptr;
+};
+
 class stop_state
 {
 	static constexpr std::uint32_t stop_requested_bit		 = 1u;
 	static constexpr std::uint32_t callback_list_locked_bit	 = 1u << 1;
 	static constexpr std::uint32_t stop_source_counter_shift = 2u;
 
+	// Shard words: the detached bit is set once request_stop() has moved the shard's callbacks to callbacks_.
+	static constexpr std::uint32_t shard_detached_bit = 1u;
+	static constexpr std::uint32_t shard_locked_bit	  = 1u << 1;
+
 	using state_t		= std::uint32_t;
 	using list_lock		= atomic_unique_lock<state_t, callback_list_locked_bit>;
+	using shard_lock	= atomic_unique_lock<state_t, shard_locked_bit>;
 	using callback_list = intrusive_list_view<stop_callback_base>;
 
+	struct alignas(internal::cache_line_size) callback_shard
+	{
+		std::atomic<state_t> word{ 0 };
+		callback_list callbacks{};
+	};
+
 public:
+	// Releases the storage of a stop_state whose last reference went away. Null means it came from plain new.
+	using deallocate_fn = void (*)(stop_state*) noexcept;
+
 	stop_state() noexcept = default;
 
+	explicit stop_state(deallocate_fn deallocate) noexcept : deallocate_(deallocate) {}
+
+	stop_state(const stop_state&)			 = delete;
+	stop_state& operator=(const stop_state&) = delete;
+
+	~stop_state() { delete[] shards_; }
+
+	// Switches registration to `shard_count` (rounded up to a power of two) independently locked callback lists,
+	// picked by callback address, so concurrent add/remove on a widely shared token stop contending on state_.
+	// request_stop() detaches every shard in one pass before running callbacks. Must be called before the state
+	// is shared, and at most once.
+	void enable_callback_sharding(std::size_t shard_count)
+	{
+		assert(shards_ == nullptr && "callback sharding is already enabled");
+		const std::size_t count = SNAP_NAMESPACE::bit_ceil(shard_count == 0 ? std::size_t{ 1 } : shard_count);
+		shards_					= new callback_shard[count];
+		shard_mask_				= count - 1;
+	}
+
+	[[nodiscard]] bool callbacks_sharded() const noexcept { return shards_ != nullptr; }
+
 	void increment_stop_source_counter() noexcept
 	{
 		const state_t cur = state_.load(std::memory_order_relaxed);
@@ -76,38 +125,63 @@ public:
 
 		requesting_thread_ = std::this_thread::get_id();
 
-		while (!callbacks_.empty())
-		{
-			stop_callback_base* cb = callbacks_.pop_front();
+		if (shards_ != nullptr) { detach_shards(); }
 
-			lock.unlock();
+		// Children first, so a whole linked subtree observes the stop before this level's callbacks run.
+		drain(lock, children_, [](stop_link* link) noexcept { link->child->request_stop(); });
+		drain(lock, callbacks_, [](stop_callback_base* cb) noexcept { cb->invoke(); });
 
-			bool destroyed_flag = false;
-			cb->destroyed		= &destroyed_flag;
+		return true;
+	}
 
-			cb->invoke();
+	bool add_callback(stop_callback_base* cb) noexcept
+	{
+		if (shards_ != nullptr) { return add_sharded_callback(cb); }
 
-			if (!destroyed_flag)
+		const auto give_up = [cb](state_t s)
+		{
+			if ((s & stop_requested_bit) != 0)
 			{
-				cb->destroyed = nullptr;
-
-				cb->completed.store(true, std::memory_order_release);
-				internal::atomic_notify_all(cb->completed);
+				cb->invoke();
+				return true;
 			}
+			return (s >> stop_source_counter_shift) == 0;
+		};
 
-			lock.lock();
-		}
+		list_lock lock(state_, give_up);
+		if (!lock.owns_lock()) { return false; }
 
+		callbacks_.push_front(cb);
 		return true;
 	}
 
-	bool add_callback(stop_callback_base* cb) noexcept
+	void remove_callback(stop_callback_base* cb) noexcept
 	{
-		const auto give_up = [cb](state_t s)
+		if (shards_ != nullptr)
+		{
+			callback_shard& shard = shard_for(cb);
+			shard_lock slock(shard.word, [](state_t w) { return (w & shard_detached_bit) != 0; });
+			if (slock.owns_lock())
+			{
+				shard.callbacks.remove(cb);
+				return;
+			}
+			// Detached: request_stop() already moved the node to callbacks_, so resolve it there.
+		}
+
+		remove_node(callbacks_, cb);
+	}
+
+	// Links `link->child` below this state: when this state is stopped, the child is stopped too, from the
+	// requesting thread and without any stop_callback_base on this state. Returns false without linking if this
+	// state is already stopped (the child is then stopped immediately) or can never be stopped.
+	bool add_child(stop_link* link) noexcept
+	{
+		const auto give_up = [link](state_t s)
 		{
 			if ((s & stop_requested_bit) != 0)
 			{
-				cb->invoke();
+				link->child->request_stop();
 				return true;
 			}
 			return (s >> stop_source_counter_shift) == 0;
@@ -116,34 +190,108 @@ public:
 		list_lock lock(state_, give_up);
 		if (!lock.owns_lock()) { return false; }
 
-		callbacks_.push_front(cb);
+		children_.push_front(link);
 		return true;
 	}
 
-	void remove_callback(stop_callback_base* cb) noexcept
+	// Same guarantees as remove_callback: on return, propagation through `link` is finished or will never start.
+	void remove_child(stop_link* link) noexcept { remove_node(children_, link); }
+
+private:
+	callback_shard& shard_for(const stop_callback_base* cb) const noexcept
+	{
+		// Fibonacci hash of the node address; the low bits are mostly alignment.
+		const auto addr = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(cb));
+		return shards_[static_cast<std::size_t>((addr * 0x9E3779B97F4A7C15ull) >> 40u) & shard_mask_];
+	}
+
+	bool add_sharded_callback(stop_callback_base* cb) noexcept
+	{
+		const state_t s = state_.load(std::memory_order_acquire);
+		if ((s & stop_requested_bit) != 0)
+		{
+			cb->invoke();
+			return false;
+		}
+		if ((s >> stop_source_counter_shift) == 0) { return false; }
+
+		callback_shard& shard = shard_for(cb);
+		shard_lock lock(shard.word, [](state_t w) { return (w & shard_detached_bit) != 0; });
+		if (!lock.owns_lock())
+		{
+			// Only request_stop() detaches a shard.
+			cb->invoke();
+			return false;
+		}
+
+		shard.callbacks.push_front(cb);
+		return true;
+	}
+
+	// Called by request_stop() with the main list lock held. Each shard is locked once and marked detached
+	// in the same step, so later registrations on it run inline and later removals go through callbacks_.
+	void detach_shards() noexcept
+	{
+		const auto never_give_up = [](state_t) { return false; };
+		const auto detach		 = [](state_t w) { return static_cast<state_t>(w | shard_locked_bit | shard_detached_bit); };
+
+		for (std::size_t i = 0; i <= shard_mask_; ++i)
+		{
+			callback_shard& shard = shards_[i];
+			shard_lock lock(shard.word, never_give_up, detach, std::memory_order_acquire);
+			while (!shard.callbacks.empty()) { callbacks_.push_front(shard.callbacks.pop_front()); }
+		}
+	}
+
+	// Pops each node, releases the list lock while it runs, then publishes completion for remove_node().
+	template <class Node, class Invoke> void drain(list_lock& lock, intrusive_list_view<Node>& list, Invoke invoke) noexcept
+	{
+		while (!list.empty())
+		{
+			Node* node = list.pop_front();
+
+			lock.unlock();
+
+			bool destroyed_flag = false;
+			node->destroyed		= &destroyed_flag;
+
+			invoke(node);
+
+			if (!destroyed_flag)
+			{
+				node->destroyed = nullptr;
+
+				node->completed.store(true, std::memory_order_release);
+				internal::atomic_notify_all(node->completed);
+			}
+
+			lock.lock();
+		}
+	}
+
+	template <class Node> void remove_node(intrusive_list_view<Node>& list, Node* node) noexcept
 	{
 		list_lock lock(state_);
 
-		const bool potentially_executing_now = cb->prev == nullptr && !callbacks_.is_head(cb);
+		const bool potentially_executing_now = node->prev == nullptr && !list.is_head(node);
 
 		if (potentially_executing_now)
 		{
 			const auto requester = requesting_thread_;
 			lock.unlock();
 
-			if (std::this_thread::get_id() != requester) { internal::atomic_wait(cb->completed, false, std::memory_order_acquire); }
+			if (std::this_thread::get_id() != requester) { internal::atomic_wait(node->completed, false, std::memory_order_acquire); }
 			else
 			{
-				if (cb->destroyed) { *cb->destroyed = true; }
+				if (node->destroyed) { *node->destroyed = true; }
 			}
 		}
 		else
 		{
-			callbacks_.remove(cb);
+			list.remove(node);
 		}
 	}
 
-private:
 	list_lock try_lock_for_request_stop() noexcept
 	{
 		const auto lock_fail  = [](state_t s) { return (s & stop_requested_bit) != 0; };
@@ -154,7 +302,11 @@ private:
 	std::atomic<state_t> state_{ 0 };
 	std::atomic<state_t> ref_count_{ 0 };
 	callback_list callbacks_{};
+	intrusive_list_view<stop_link> children_{};
 	std::thread::id requesting_thread_{};
+	deallocate_fn deallocate_ = nullptr;
+	callback_shard* shards_	  = nullptr;
+	std::size_t shard_mask_	  = 0;
 
 	template <class T> friend struct intrusive_shared_ptr_traits;
 };
@@ -162,6 +314,12 @@ private:
 template <> struct intrusive_shared_ptr_traits<stop_state>
 {
 	static std::atomic<std::uint32_t>& get_atomic_ref_count(stop_state& s) noexcept { return s.ref_count_; }
+
+	static void deallocate(stop_state* s) noexcept
+	{
+		if (s->deallocate_ != nullptr) { s->deallocate_(s); }
+		else { delete s; }
+	}
 };
 
 SNAP_END_NAMESPACE
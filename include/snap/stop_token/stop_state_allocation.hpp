@@ -0,0 +1,68 @@
+#ifndef SNP_INCLUDE_SNAP_STOP_TOKEN_STOP_STATE_ALLOCATION_HPP
+#define SNP_INCLUDE_SNAP_STOP_TOKEN_STOP_STATE_ALLOCATION_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/pp/no_unique_address.hpp"
+#include "snap/stop_token/stop_state.hpp"
+
+#include <memory> // std::allocator_traits
+#include <new>	  // placement new
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal
+{
+	namespace detail
+	{
+		// Thread-caching pool of stop_state-sized blocks. A block freed on any thread goes to that thread's cache,
+		// which holds a bounded number of blocks and falls back to the global heap beyond that.
+		void* stop_state_pool_allocate();
+		void stop_state_pool_deallocate(void* block) noexcept;
+
+		inline void deallocate_pooled_stop_state(stop_state* s) noexcept
+		{
+			s->~stop_state();
+			stop_state_pool_deallocate(s);
+		}
+
+		// stop_state followed by the allocator that produced it; the allocator is moved out before the block is freed.
+		template <class Alloc> struct allocated_stop_state final : stop_state
+		{
+			using alloc_traits	 = typename std::allocator_traits<Alloc>::template rebind_traits<allocated_stop_state>;
+			using allocator_type = typename alloc_traits::allocator_type;
+
+			explicit allocated_stop_state(const allocator_type& a) noexcept : stop_state(&allocated_stop_state::deallocate_self), alloc(a) {}
+
+			static void deallocate_self(stop_state* s) noexcept
+			{
+				auto* self = static_cast<allocated_stop_state*>(s);
+				allocator_type a(std::move(self->alloc));
+				self->~allocated_stop_state();
+				alloc_traits::deallocate(a, self, 1);
+			}
+
+			SNAP_NO_UNIQUE_ADDRESS_ATTR allocator_type alloc;
+		};
+	} // namespace detail
+
+	inline stop_state* make_pooled_stop_state()
+	{
+		return ::new (detail::stop_state_pool_allocate()) stop_state(&detail::deallocate_pooled_stop_state);
+	}
+
+	template <class Alloc> stop_state* make_allocated_stop_state(const Alloc& alloc)
+	{
+		using node_t = detail::allocated_stop_state<Alloc>;
+
+		typename node_t::allocator_type a(alloc);
+		node_t* p = node_t::alloc_traits::allocate(a, 1);
+		return ::new (static_cast<void*>(p)) node_t(a);
+	}
+} // namespace internal
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_STOP_TOKEN_STOP_STATE_ALLOCATION_HPP
@@ -5,9 +5,16 @@
 #include "snap/internal/abi_namespace.hpp"
 
 #include "snap/stop_token/stop_source.hpp"
+#include "snap/thread/thread_attributes.hpp"
 #include "snap/type_traits/remove_cvref.hpp"
 
+#include <exception>
+#include <functional> // std::invoke
+#include <future>
+#include <memory>
+#include <system_error>
 #include <thread>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -21,7 +28,10 @@ public:
 
 	jthread() noexcept : stop_source_(nostopstate) {}
 
-	template <class Fun, class... Args, class = std::enable_if_t<!std::is_same_v<remove_cvref_t<Fun>, jthread>>> explicit jthread(Fun&& fun, Args&&... args)
+	template <class Fun,
+			  class... Args,
+			  class = std::enable_if_t<!std::is_same_v<remove_cvref_t<Fun>, jthread> && !std::is_same_v<remove_cvref_t<Fun>, thread_attributes>>>
+	explicit jthread(Fun&& fun, Args&&... args)
 		: stop_source_(), thread_(init_thread(stop_source_, std::forward<Fun>(fun), std::forward<Args>(args)...))
 	{
 		static_assert(std::is_constructible_v<std::decay_t<Fun>, Fun>, "Fun must be constructible from the provided callable");
@@ -31,6 +41,83 @@ public:
 					  "Callable must be invocable with (Args...) or (stop_token, Args...)");
 	}
 
+	// Starts a thread with `attrs` applied before `fun` runs. The thread is created with pthread_create so that
+	// the stack size is passed in its own pthread_attr_t; the name, affinity, scheduling policy and nice value are
+	// applied by the new thread itself, and the constructor waits for that step. If any attribute cannot be
+	// applied, `fun` never runs, the thread is joined, and the constructor throws std::system_error. Where threads
+	// cannot be started natively, a non-zero stack size throws with errc::not_supported.
+	template <class Fun, class... Args> explicit jthread(const thread_attributes& attrs, Fun&& fun, Args&&... args) : stop_source_()
+	{
+		static_assert(std::is_constructible_v<std::decay_t<Fun>, Fun>, "Fun must be constructible from the provided callable");
+		static_assert((std::is_constructible_v<std::decay_t<Args>, Args> && ...), "Each Arg must be constructible from the provided argument");
+		static_assert(std::is_invocable_v<std::decay_t<Fun>, std::decay_t<Args>...> ||
+						  std::is_invocable_v<std::decay_t<Fun>, stop_token, std::decay_t<Args>...>,
+					  "Callable must be invocable with (Args...) or (stop_token, Args...)");
+
+		std::promise<id> started;
+		std::future<id> started_future = started.get_future();
+
+		auto body = [&attrs, started = std::move(started), token = stop_source_.get_token(), fn = std::decay_t<Fun>(std::forward<Fun>(fun)),
+					 bound = std::make_tuple(std::decay_t<Args>(std::forward<Args>(args))...)]() mutable
+		{
+			// `attrs` is only read before `started` is fulfilled, while the constructor is still waiting.
+			const char* what		 = nullptr;
+			const std::error_code ec = internal::detail::apply_thread_attributes(attrs, what);
+			if (ec)
+			{
+				started.set_exception(std::make_exception_ptr(std::system_error(ec, std::string("jthread: cannot apply ") + what)));
+				return;
+			}
+			started.set_value(std::this_thread::get_id());
+
+			std::apply(
+				[&](auto&... a)
+				{
+					if constexpr (std::is_invocable_v<std::decay_t<Fun>, stop_token, std::decay_t<Args>...>)
+					{
+						std::invoke(std::move(fn), std::move(token), std::move(a)...);
+					}
+					else { std::invoke(std::move(fn), std::move(a)...); }
+				},
+				bound);
+		};
+
+#if SNAP_HAS_NATIVE_THREAD_START
+		using body_type = decltype(body);
+		auto state		= std::make_unique<body_type>(std::move(body));
+		const std::error_code ec =
+			internal::detail::start_native_thread(attrs.stack_size, &jthread::native_entry_<body_type>, state.get(), native_);
+		if (ec) { throw std::system_error(ec, "jthread: cannot start thread"); }
+		state.release(); // owned by the new thread
+
+		try
+		{
+			native_id_ = started_future.get();
+		}
+		catch (...)
+		{
+			(void)internal::detail::join_native_thread(native_);
+			throw;
+		}
+#else
+		if (attrs.stack_size != 0)
+		{
+			throw std::system_error(std::make_error_code(std::errc::not_supported), "jthread: cannot apply stack size");
+		}
+		thread_ = std::thread(std::move(body));
+
+		try
+		{
+			(void)started_future.get();
+		}
+		catch (...)
+		{
+			thread_.join();
+			throw;
+		}
+#endif
+	}
+
 	~jthread()
 	{
 		if (joinable())
@@ -43,7 +130,13 @@ public:
 	jthread(const jthread&)			   = delete;
 	jthread& operator=(const jthread&) = delete;
 
-	jthread(jthread&&) noexcept = default;
+	jthread(jthread&& other) noexcept : stop_source_(std::move(other.stop_source_)), thread_(std::move(other.thread_))
+	{
+#if SNAP_HAS_NATIVE_THREAD_START
+		native_	   = other.native_;
+		native_id_ = std::exchange(other.native_id_, id());
+#endif
+	}
 
 	jthread& operator=(jthread&& other) noexcept
 	{
@@ -56,6 +149,10 @@ public:
 			}
 			stop_source_ = std::move(other.stop_source_);
 			thread_		 = std::move(other.thread_);
+#if SNAP_HAS_NATIVE_THREAD_START
+			native_	   = other.native_;
+			native_id_ = std::exchange(other.native_id_, id());
+#endif
 		}
 		return *this;
 	}
@@ -65,16 +162,44 @@ public:
 		using std::swap;
 		swap(stop_source_, other.stop_source_);
 		swap(thread_, other.thread_);
+#if SNAP_HAS_NATIVE_THREAD_START
+		swap(native_, other.native_);
+		swap(native_id_, other.native_id_);
+#endif
 	}
 
 	[[nodiscard]] bool joinable() const noexcept { return get_id() != id(); }
 
+#if SNAP_HAS_NATIVE_THREAD_START
+	void join()
+	{
+		if (native_id_ == id()) { return thread_.join(); }
+		if (native_id_ == std::this_thread::get_id())
+		{
+			throw std::system_error(std::make_error_code(std::errc::resource_deadlock_would_occur), "jthread::join");
+		}
+		if (const std::error_code ec = internal::detail::join_native_thread(native_); ec) { throw std::system_error(ec, "jthread::join"); }
+		native_id_ = id();
+	}
+
+	void detach()
+	{
+		if (native_id_ == id()) { return thread_.detach(); }
+		if (const std::error_code ec = internal::detail::detach_native_thread(native_); ec) { throw std::system_error(ec, "jthread::detach"); }
+		native_id_ = id();
+	}
+
+	[[nodiscard]] id get_id() const noexcept { return native_id_ != id() ? native_id_ : thread_.get_id(); }
+
+	[[nodiscard]] native_handle_type native_handle() { return native_id_ != id() ? native_ : thread_.native_handle(); }
+#else
 	void join() { thread_.join(); }
 	void detach() { thread_.detach(); }
 
 	[[nodiscard]] id get_id() const noexcept { return thread_.get_id(); }
 
 	[[nodiscard]] native_handle_type native_handle() { return thread_.native_handle(); }
+#endif
 
 	[[nodiscard]] stop_source get_stop_source() noexcept { return stop_source_; }
 	[[nodiscard]] stop_token get_stop_token() const noexcept { return stop_source_.get_token(); }
@@ -99,8 +224,23 @@ private:
 		}
 	}
 
+#if SNAP_HAS_NATIVE_THREAD_START
+	// Runs a thread started by start_native_thread; an escaping exception ends in std::terminate as with std::thread.
+	template <class Body> static void* native_entry_(void* state) noexcept
+	{
+		const std::unique_ptr<Body> body(static_cast<Body*>(state));
+		(*body)();
+		return nullptr;
+	}
+#endif
+
 	stop_source stop_source_{};
 	std::thread thread_{};
+#if SNAP_HAS_NATIVE_THREAD_START
+	// set instead of thread_ for threads started with attributes
+	native_handle_type native_{};
+	id native_id_{};
+#endif
 };
 
 SNAP_END_NAMESPACE
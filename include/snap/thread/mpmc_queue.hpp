@@ -0,0 +1,269 @@
+#ifndef SNP_INCLUDE_SNAP_THREAD_MPMC_QUEUE_HPP
+#define SNP_INCLUDE_SNAP_THREAD_MPMC_QUEUE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/bit/bit_ceil.hpp"
+#include "snap/internal/helpers/cache_line.hpp"
+#include "snap/internal/helpers/event_count.hpp"
+#include "snap/internal/helpers/raw_storage.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new> // placement new, std::launder
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+// Bounded lock-free multi-producer multi-consumer ring (Vyukov's bounded MPMC queue).
+//
+// Every cell carries a sequence number that says whose turn it is: a producer may fill cell i once its sequence
+// equals the ticket i, and a consumer may drain it once the sequence is i + 1. Producers and consumers claim
+// tickets by CAS on separate, cache-line aligned counters, so the two sides only meet on the cells themselves.
+// push_n/pop_n claim a run of ready cells with a single CAS.
+//
+// The capacity is rounded up to a power of two. With Blocking = true the queue also offers push/emplace and pop,
+// which park through internal::atomic_wait while the ring is full or empty; every successful operation then pays
+// a fence to check for parked threads.
+template <class T, bool Blocking = false> class mpmc_queue
+{
+public:
+	using value_type = T;
+	using size_type	 = std::size_t;
+
+	explicit mpmc_queue(size_type capacity)
+		: m_mask(bit_ceil(capacity < 2 ? size_type{ 2 } : capacity) - 1), m_cells(std::make_unique<cell[]>(m_mask + 1))
+	{
+		for (size_type i = 0; i <= m_mask; ++i) m_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	mpmc_queue(const mpmc_queue&)			 = delete;
+	mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+	~mpmc_queue()
+	{
+		const size_type tail = m_enqueue.load(std::memory_order_relaxed);
+		for (size_type i = m_dequeue.load(std::memory_order_relaxed); i != tail; ++i) m_cells[i & m_mask].value()->~T();
+	}
+
+	size_type capacity() const noexcept { return m_mask + 1; }
+
+	// A racy hint unless the queue is quiescent.
+	size_type size() const noexcept
+	{
+		const size_type head = m_dequeue.load(std::memory_order_acquire);
+		const size_type tail = m_enqueue.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+	[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+	// Returns false when the ring is full. If constructing T from args may throw, the element is built before a
+	// cell is claimed, since a claimed cell must be filled, and moved in afterwards.
+	template <class... Args> bool try_emplace(Args&&... args)
+	{
+		if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+		{
+			size_type ticket = 0;
+			if (!claim_(m_enqueue, 0, ticket)) return false;
+			fill_(ticket, std::forward<Args>(args)...);
+			return true;
+		}
+		else { return try_emplace(T(std::forward<Args>(args)...)); }
+	}
+
+	bool try_push(const T& value) { return try_emplace(value); }
+	bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+	// Claims up to n consecutive free cells with one CAS and copies [first, first + n) into them; returns how many.
+	// Elements whose construction may throw are pushed one at a time instead.
+	template <class InputIt> size_type push_n(InputIt first, size_type n)
+	{
+		if constexpr (!std::is_nothrow_constructible_v<T, decltype(*first)>)
+		{
+			size_type count = 0;
+			for (; count < n && try_emplace(*first); ++count, ++first) {}
+			return count;
+		}
+		size_type ticket	  = 0;
+		const size_type count = claim_n_(m_enqueue, 0, n, ticket);
+		for (size_type i = 0; i < count; ++i, ++first)
+		{
+			cell& c = m_cells[(ticket + i) & m_mask];
+			::new (static_cast<void*>(c.storage.data())) T(*first);
+			c.sequence.store(ticket + i + 1, std::memory_order_release);
+		}
+		if constexpr (Blocking)
+		{
+			if (count != 0) m_not_empty.notify_all();
+		}
+		return count;
+	}
+
+	template <class... Args> void emplace(Args&&... args)
+	{
+		static_assert(Blocking, "mpmc_queue: blocking operations need Blocking = true");
+		if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+		{
+			size_type ticket = 0;
+			while (!claim_(m_enqueue, 0, ticket))
+			{
+				m_not_full.await([&]() noexcept { return ready_(m_enqueue, 0); });
+			}
+			fill_(ticket, std::forward<Args>(args)...);
+		}
+		else { emplace(T(std::forward<Args>(args)...)); }
+	}
+
+	void push(const T& value) { emplace(value); }
+	void push(T&& value) { emplace(std::move(value)); }
+
+	// Returns false when the ring is empty. If assigning to out throws, the element is lost.
+	bool try_pop(T& out)
+	{
+		size_type ticket = 0;
+		if (!claim_(m_dequeue, 1, ticket)) return false;
+		out = take_(ticket);
+		return true;
+	}
+
+	// Claims up to max consecutive filled cells with one CAS and moves them to out; returns how many. When writing
+	// to out may throw, elements are claimed one at a time instead, and only the one being written can be lost.
+	template <class OutputIt> size_type pop_n(OutputIt out, size_type max)
+	{
+		if constexpr (!std::is_nothrow_assignable_v<decltype(*out), T&&>)
+		{
+			size_type count	 = 0;
+			size_type ticket = 0;
+			for (; count < max && claim_(m_dequeue, 1, ticket); ++count, ++out) *out = take_(ticket);
+			return count;
+		}
+		size_type ticket	  = 0;
+		const size_type count = claim_n_(m_dequeue, 1, max, ticket);
+		for (size_type i = 0; i < count; ++i, ++out)
+		{
+			cell& c = m_cells[(ticket + i) & m_mask];
+			T* p	= c.value();
+			*out	= std::move(*p);
+			p->~T();
+			c.sequence.store(ticket + i + m_mask + 1, std::memory_order_release);
+		}
+		if constexpr (Blocking)
+		{
+			if (count != 0) m_not_full.notify_all();
+		}
+		return count;
+	}
+
+	T pop() noexcept
+	{
+		static_assert(Blocking, "mpmc_queue: blocking operations need Blocking = true");
+		size_type ticket = 0;
+		while (!claim_(m_dequeue, 1, ticket))
+		{
+			m_not_empty.await([&]() noexcept { return ready_(m_dequeue, 1); });
+		}
+		return take_(ticket);
+	}
+
+private:
+	// A consumer cannot hand a claimed element back, and a claimed cell must be filled.
+	static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>,
+				  "mpmc_queue elements must be nothrow move constructible and destructible");
+
+	struct cell
+	{
+		T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage.data())); }
+
+		std::atomic<size_type> sequence{ 0 };
+		internal::raw_storage_for<T> storage;
+	};
+
+	// Sequence - ticket: 0 when the cell is ready for this side, negative when the ring is full (producers) or
+	// empty (consumers), positive when another thread already took the ticket.
+	static std::ptrdiff_t lag_(size_type sequence, size_type ticket) noexcept { return static_cast<std::ptrdiff_t>(sequence - ticket); }
+
+	bool ready_(const std::atomic<size_type>& counter, size_type offset) const noexcept
+	{
+		const size_type ticket = counter.load(std::memory_order_relaxed);
+		return lag_(m_cells[ticket & m_mask].sequence.load(std::memory_order_acquire), ticket + offset) >= 0;
+	}
+
+	// Takes the next ticket whose cell is ready for this side (offset 0 for producers, 1 for consumers).
+	bool claim_(std::atomic<size_type>& counter, size_type offset, size_type& ticket) noexcept
+	{
+		ticket = counter.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			const std::ptrdiff_t lag = lag_(m_cells[ticket & m_mask].sequence.load(std::memory_order_acquire), ticket + offset);
+			if (lag == 0)
+			{
+				if (counter.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) return true;
+			}
+			else if (lag < 0) { return false; }
+			else { ticket = counter.load(std::memory_order_relaxed); }
+		}
+	}
+
+	// Takes up to n consecutive tickets whose cells are all ready for this side and returns how many.
+	size_type claim_n_(std::atomic<size_type>& counter, size_type offset, size_type n, size_type& ticket) noexcept
+	{
+		ticket = counter.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			size_type count	   = 0;
+			std::ptrdiff_t lag = 0;
+			for (; count < n; ++count)
+			{
+				lag = lag_(m_cells[(ticket + count) & m_mask].sequence.load(std::memory_order_acquire), ticket + count + offset);
+				if (lag != 0) break;
+			}
+			if (count == 0 && lag > 0)
+			{
+				ticket = counter.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (count == 0) return 0;
+			if (counter.compare_exchange_weak(ticket, ticket + count, std::memory_order_relaxed)) return count;
+		}
+	}
+
+	template <class... Args> void fill_(size_type ticket, Args&&... args) noexcept
+	{
+		cell& c = m_cells[ticket & m_mask];
+		::new (static_cast<void*>(c.storage.data())) T(std::forward<Args>(args)...);
+		c.sequence.store(ticket + 1, std::memory_order_release);
+		if constexpr (Blocking) m_not_empty.notify_all();
+	}
+
+	// Moves the element out of a claimed cell and hands the cell to the producers of the next lap.
+	T take_(size_type ticket) noexcept
+	{
+		cell& c = m_cells[ticket & m_mask];
+		T* p	= c.value();
+		T value(std::move(*p));
+		p->~T();
+		c.sequence.store(ticket + m_mask + 1, std::memory_order_release);
+		if constexpr (Blocking) m_not_full.notify_all();
+		return value;
+	}
+
+	struct no_event
+	{
+	};
+	using event = std::conditional_t<Blocking, internal::event_count, no_event>;
+
+	// each side notifies the event kept on its own line
+	alignas(internal::cache_line_size) std::atomic<size_type> m_enqueue{ 0 };
+	event m_not_empty;
+	alignas(internal::cache_line_size) std::atomic<size_type> m_dequeue{ 0 };
+	event m_not_full;
+	alignas(internal::cache_line_size) const size_type m_mask;
+	std::unique_ptr<cell[]> m_cells;
+};
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_THREAD_MPMC_QUEUE_HPP
@@ -0,0 +1,156 @@
+#ifndef SNP_INCLUDE_SNAP_THREAD_QUEUE_LOCK_HPP
+#define SNP_INCLUDE_SNAP_THREAD_QUEUE_LOCK_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/atomic_helpers.hpp"
+#include "snap/internal/helpers/cache_line.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+
+SNAP_BEGIN_NAMESPACE
+
+// Per-waiter queue node. Every waiter spins on its own node, so contention never bounces the lock word itself.
+struct alignas(internal::cache_line_size) queue_lock_node
+{
+	std::atomic<queue_lock_node*> next{ nullptr };
+	std::atomic<std::uint32_t> state{ 0 };
+};
+
+namespace internal::detail
+{
+	// Thread-local node cache backing the Lockable interface of queue_lock.
+	queue_lock_node* queue_lock_acquire_node();
+	void queue_lock_release_node(queue_lock_node* node) noexcept;
+
+	inline constexpr int queue_lock_spin_iters = 128;
+} // namespace internal::detail
+
+// MCS queue lock.
+// Waiters enqueue FIFO and spin on their own cache line. After a spin budget they park on their node word,
+// and unlock hands ownership directly to the single successor, waking only that thread.
+//
+// Two interfaces are provided:
+// - lock()/try_lock()/unlock() meet Lockable and take a node from a per-thread cache.
+// - lock(node)/try_lock(node)/unlock(node) let callers supply the node (typically on the stack).
+class queue_lock
+{
+	static constexpr std::uint32_t waiting = 0;
+	static constexpr std::uint32_t granted = 1;
+	static constexpr std::uint32_t parked  = 2;
+
+public:
+	using node = queue_lock_node;
+
+	constexpr queue_lock() noexcept = default;
+
+	queue_lock(const queue_lock&)			 = delete;
+	queue_lock& operator=(const queue_lock&) = delete;
+	queue_lock(queue_lock&&)				 = delete;
+	queue_lock& operator=(queue_lock&&)		 = delete;
+
+	~queue_lock() { assert(tail_.load(std::memory_order_relaxed) == nullptr && "queue_lock destroyed while locked"); }
+
+	void lock()
+	{
+		node* n = internal::detail::queue_lock_acquire_node();
+		lock(*n);
+		owner_ = n;
+	}
+
+	bool try_lock()
+	{
+		node* n = internal::detail::queue_lock_acquire_node();
+		if (!try_lock(*n))
+		{
+			internal::detail::queue_lock_release_node(n);
+			return false;
+		}
+		owner_ = n;
+		return true;
+	}
+
+	void unlock() noexcept
+	{
+		// Read our node before the handoff; the next owner overwrites owner_.
+		node* n = owner_;
+		unlock(*n);
+		internal::detail::queue_lock_release_node(n);
+	}
+
+	void lock(node& n) noexcept
+	{
+		n.next.store(nullptr, std::memory_order_relaxed);
+		n.state.store(waiting, std::memory_order_relaxed);
+
+		node* pred = tail_.exchange(&n, std::memory_order_acq_rel);
+		if (pred == nullptr) { return; }
+
+		pred->next.store(&n, std::memory_order_release);
+		wait_for_grant(n);
+	}
+
+	bool try_lock(node& n) noexcept
+	{
+		n.next.store(nullptr, std::memory_order_relaxed);
+		n.state.store(waiting, std::memory_order_relaxed);
+
+		node* expected = nullptr;
+		return tail_.compare_exchange_strong(expected, &n, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	void unlock(node& n) noexcept
+	{
+		node* succ = n.next.load(std::memory_order_acquire);
+		if (succ == nullptr)
+		{
+			node* expected = &n;
+			if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) { return; }
+
+			// A successor swapped the tail but has not linked itself yet. The window is a few instructions wide,
+			// but yield once the budget runs out in case the successor was preempted inside it.
+			for (int spins = 0; (succ = n.next.load(std::memory_order_acquire)) == nullptr; ++spins)
+			{
+				if (spins < internal::detail::queue_lock_spin_iters) { internal::detail::cpu_relax(); }
+				else { std::this_thread::yield(); }
+			}
+		}
+
+		// Only the successor ever waits on its node word, so notify_all still wakes exactly one thread.
+		// It also keeps the parking-lot fallback correct when unrelated keys share a bucket.
+		if (succ->state.exchange(granted, std::memory_order_release) == parked) { internal::atomic_notify_all(succ->state); }
+	}
+
+	// Advisory only: true if some thread held the lock at the instant of the load.
+	[[nodiscard]] bool is_locked() const noexcept { return tail_.load(std::memory_order_relaxed) != nullptr; }
+
+private:
+	static void wait_for_grant(node& n) noexcept
+	{
+		for (int i = 0; i < internal::detail::queue_lock_spin_iters; ++i)
+		{
+			if (n.state.load(std::memory_order_acquire) == granted) { return; }
+			internal::detail::cpu_relax();
+		}
+
+		// Announce that we are about to sleep so the releaser knows a wake-up is needed.
+		std::uint32_t expected = waiting;
+		if (!n.state.compare_exchange_strong(expected, parked, std::memory_order_acquire, std::memory_order_acquire)) { return; }
+
+		do
+		{
+			internal::atomic_wait(n.state, parked, std::memory_order_acquire);
+		} while (n.state.load(std::memory_order_acquire) != granted);
+	}
+
+	alignas(internal::cache_line_size) std::atomic<node*> tail_{ nullptr };
+	node* owner_ = nullptr;
+};
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_THREAD_QUEUE_LOCK_HPP
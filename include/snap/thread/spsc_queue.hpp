@@ -0,0 +1,218 @@
+#ifndef SNP_INCLUDE_SNAP_THREAD_SPSC_QUEUE_HPP
+#define SNP_INCLUDE_SNAP_THREAD_SPSC_QUEUE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/cache_line.hpp"
+#include "snap/internal/helpers/event_count.hpp"
+#include "snap/internal/helpers/raw_storage.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new> // placement new, std::launder
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+// Bounded lock-free single-producer single-consumer ring of N elements.
+//
+// head and tail are free-running counters on separate cache lines. Each side also keeps a private copy of the
+// other side's counter and reloads it only when the ring looks full (producer) or empty (consumer), so in steady
+// state neither side reads the other's line.
+//
+// try_push/try_pop and the batched push_n/pop_n never block; a batch costs one release store. With Blocking = true
+// the queue also offers push/emplace and pop, which park through internal::atomic_wait while the ring is full or
+// empty. Every successful operation then pays a fence to check for parked threads, so that mode is opt-in.
+template <class T, std::size_t N, bool Blocking = false> class spsc_queue
+{
+	static_assert(N > 0, "spsc_queue needs room for at least one element");
+
+public:
+	using value_type = T;
+	using size_type	 = std::size_t;
+
+	spsc_queue() noexcept = default;
+
+	spsc_queue(const spsc_queue&)			 = delete;
+	spsc_queue& operator=(const spsc_queue&) = delete;
+
+	~spsc_queue()
+	{
+		const size_type tail = m_tail.load(std::memory_order_relaxed);
+		for (size_type i = m_head.load(std::memory_order_relaxed); i != tail; ++i) slot_(i)->~T();
+	}
+
+	static constexpr size_type capacity() noexcept { return N; }
+
+	// A racy hint unless the queue is quiescent.
+	size_type size() const noexcept { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+	[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+	// Producer only. Returns false, without touching args, when the ring is full.
+	template <class... Args> bool try_emplace(Args&&... args)
+	{
+		const size_type tail = m_tail.load(std::memory_order_relaxed);
+		if (!has_room_(tail)) return false;
+		publish_one_(tail, std::forward<Args>(args)...);
+		return true;
+	}
+
+	bool try_push(const T& value) { return try_emplace(value); }
+	bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+	// Producer only. Pushes the first min(n, free slots) elements of [first, first + n) and returns how many. If a
+	// copy throws, the elements already copied stay queued.
+	template <class InputIt> size_type push_n(InputIt first, size_type n)
+	{
+		const size_type tail = m_tail.load(std::memory_order_relaxed);
+		if (N - (tail - m_cached_head) < n) m_cached_head = m_head.load(std::memory_order_acquire);
+		const size_type room  = N - (tail - m_cached_head);
+		const size_type count = n < room ? n : room;
+		size_type i			  = 0;
+		try
+		{
+			for (; i < count; ++i, ++first) ::new (static_cast<void*>(m_slots[(tail + i) % N].data())) T(*first);
+		}
+		catch (...)
+		{
+			publish_(tail + i);
+			throw;
+		}
+		if (count != 0) publish_(tail + count);
+		return count;
+	}
+
+	// Producer only. Waits while the ring is full.
+	template <class... Args> void emplace(Args&&... args)
+	{
+		static_assert(Blocking, "spsc_queue: blocking operations need Blocking = true");
+		const size_type tail = m_tail.load(std::memory_order_relaxed);
+		if (!has_room_(tail))
+		{
+			m_not_full.await([&]() noexcept { return tail - m_head.load(std::memory_order_acquire) != N; });
+			m_cached_head = m_head.load(std::memory_order_acquire);
+		}
+		publish_one_(tail, std::forward<Args>(args)...);
+	}
+
+	void push(const T& value) { emplace(value); }
+	void push(T&& value) { emplace(std::move(value)); }
+
+	// Consumer only. Returns false when the ring is empty.
+	bool try_pop(T& out)
+	{
+		const size_type head = m_head.load(std::memory_order_relaxed);
+		if (!has_element_(head)) return false;
+		consume_one_(head, out);
+		return true;
+	}
+
+	// Consumer only. Moves up to max elements to out and returns how many.
+	template <class OutputIt> size_type pop_n(OutputIt out, size_type max)
+	{
+		const size_type head = m_head.load(std::memory_order_relaxed);
+		if (m_cached_tail - head < max) m_cached_tail = m_tail.load(std::memory_order_acquire);
+		const size_type ready = m_cached_tail - head;
+		const size_type count = max < ready ? max : ready;
+		size_type i			  = 0;
+		try
+		{
+			for (; i < count; ++i, ++out)
+			{
+				T* p = slot_(head + i);
+				*out = std::move(*p);
+				p->~T();
+			}
+		}
+		catch (...)
+		{
+			retire_(head + i);
+			throw;
+		}
+		if (count != 0) retire_(head + count);
+		return count;
+	}
+
+	// Consumer only. Waits while the ring is empty.
+	T pop()
+	{
+		static_assert(Blocking, "spsc_queue: blocking operations need Blocking = true");
+		const size_type head = m_head.load(std::memory_order_relaxed);
+		if (!has_element_(head))
+		{
+			m_not_empty.await([&]() noexcept { return m_tail.load(std::memory_order_acquire) != head; });
+			m_cached_tail = m_tail.load(std::memory_order_acquire);
+		}
+		T* p = slot_(head);
+		T value(std::move(*p));
+		p->~T();
+		retire_(head + 1);
+		return value;
+	}
+
+private:
+	T* slot_(size_type i) noexcept { return std::launder(reinterpret_cast<T*>(m_slots[i % N].data())); }
+
+	bool has_room_(size_type tail) noexcept
+	{
+		if (tail - m_cached_head != N) return true;
+		m_cached_head = m_head.load(std::memory_order_acquire);
+		return tail - m_cached_head != N;
+	}
+
+	bool has_element_(size_type head) noexcept
+	{
+		if (head != m_cached_tail) return true;
+		m_cached_tail = m_tail.load(std::memory_order_acquire);
+		return head != m_cached_tail;
+	}
+
+	template <class... Args> void publish_one_(size_type tail, Args&&... args)
+	{
+		::new (static_cast<void*>(m_slots[tail % N].data())) T(std::forward<Args>(args)...);
+		publish_(tail + 1);
+	}
+
+	void consume_one_(size_type head, T& out)
+	{
+		T* p = slot_(head);
+		out	 = std::move(*p);
+		p->~T();
+		retire_(head + 1);
+	}
+
+	void publish_(size_type tail) noexcept
+	{
+		m_tail.store(tail, std::memory_order_release);
+		if constexpr (Blocking) m_not_empty.notify_all();
+	}
+
+	void retire_(size_type head) noexcept
+	{
+		m_head.store(head, std::memory_order_release);
+		if constexpr (Blocking) m_not_full.notify_all();
+	}
+
+	struct no_event
+	{
+	};
+	using event = std::conditional_t<Blocking, internal::event_count, no_event>;
+
+	// consumer side
+	alignas(internal::cache_line_size) std::atomic<size_type> m_head{ 0 };
+	size_type m_cached_tail = 0;
+	event m_not_full;
+
+	// producer side
+	alignas(internal::cache_line_size) std::atomic<size_type> m_tail{ 0 };
+	size_type m_cached_head = 0;
+	event m_not_empty;
+
+	alignas(internal::cache_line_size) internal::raw_storage_for<T> m_slots[N];
+};
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_THREAD_SPSC_QUEUE_HPP
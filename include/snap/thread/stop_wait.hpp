@@ -0,0 +1,132 @@
+#ifndef SNP_INCLUDE_SNAP_THREAD_STOP_WAIT_HPP
+#define SNP_INCLUDE_SNAP_THREAD_STOP_WAIT_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/atomic_helpers.hpp"
+#include "snap/stop_token/stop_callback.hpp"
+#include "snap/stop_token/stop_source.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory> // std::addressof
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace this_thread
+{
+	// Sleeps until `abs_time` or until stop is requested on `st`, whichever comes first.
+	// A stop callback signals the sleeping thread directly, so request_stop() wakes it immediately instead of
+	// at the next poll. Returns true if the deadline was reached, false if the sleep was cut short by a stop request.
+	template <class Clock, class Duration> bool sleep_until(const std::chrono::time_point<Clock, Duration>& abs_time, const stop_token& st)
+	{
+		if (st.stop_requested()) { return false; }
+		if (!st.stop_possible())
+		{
+			std::this_thread::sleep_until(abs_time);
+			return true;
+		}
+
+		struct sleeper
+		{
+			std::mutex mutex;
+			std::condition_variable cv;
+			bool stopped = false;
+		};
+
+		sleeper s;
+		const auto wake = [&s]() noexcept
+		{
+			{
+				const std::lock_guard<std::mutex> lock(s.mutex);
+				s.stopped = true;
+			}
+			s.cv.notify_all();
+		};
+		const stop_callback<decltype(wake)> cb(st, wake);
+
+		std::unique_lock<std::mutex> lock(s.mutex);
+		return !s.cv.wait_until(lock, abs_time, [&s] { return s.stopped; });
+	}
+
+	template <class Rep, class Period> bool sleep_for(const std::chrono::duration<Rep, Period>& rel_time, const stop_token& st)
+	{
+		if (rel_time <= rel_time.zero()) { return !st.stop_requested(); }
+		return this_thread::sleep_until(std::chrono::steady_clock::now() + rel_time, st);
+	}
+} // namespace this_thread
+
+namespace internal::detail
+{
+	template <class T> bool stop_wait_changed(const std::atomic<T>& a, const T& expected, std::memory_order order) noexcept
+	{
+		return !value_repr_equal(a.load(order), expected);
+	}
+
+	// Stop-aware waiters park on the parking lot slot of `a` only, never on a native wait of `a` itself: a stop wake
+	// does not change the value, so a native wait could sleep through it. The generation is taken before the final
+	// check, so a notify or stop wake that lands in between bumps it and parking_lot_wait returns at once.
+	template <class Done> void stop_wait_park(const void* key, Done& done) noexcept
+	{
+		const std::uint32_t gen = parking_lot_prepare(key);
+		if (done()) { return; }
+		parking_lot_wait(key, gen);
+	}
+} // namespace internal::detail
+
+// Wake the threads blocked on `a` in wait(stop_token, a, ...) as well as in internal::atomic_wait (and, with C++20,
+// std::atomic::wait). A plain a.notify_one()/a.notify_all() does not reach wait(stop_token, a, ...): standard
+// library waits keep their own waiter bookkeeping, which the stop-aware wait cannot join portably.
+template <class T> void notify_all(std::atomic<T>& a) noexcept
+{
+	internal::atomic_notify_all(a);
+	// without the member, atomic_notify_all already went through the parking lot
+	if constexpr (internal::detail::has_notify_all<std::atomic<T>>::value) { internal::detail::parking_lot_notify_all(std::addressof(a)); }
+}
+
+template <class T> void notify_one(std::atomic<T>& a) noexcept
+{
+	internal::atomic_notify_one(a);
+	if constexpr (internal::detail::has_notify_one<std::atomic<T>>::value) { internal::detail::parking_lot_notify_one(std::addressof(a)); }
+}
+
+// Blocks while `a` holds `expected`, until another thread changes it and calls notify_one(a)/notify_all(a), or until
+// stop is requested on `st`. Returns true if the value changed, false on a stop request.
+template <class T> bool wait(const stop_token& st, const std::atomic<T>& a, T expected, std::memory_order order = std::memory_order_seq_cst) noexcept
+{
+	static_assert(std::is_trivially_copyable_v<T>, "wait requires a trivially copyable value type");
+
+	const std::memory_order observe = internal::detail::wait_observe_order(order);
+
+	if (internal::detail::stop_wait_changed(a, expected, observe)) { return true; }
+	if (st.stop_requested()) { return false; }
+
+	bool changed	= false;
+	const auto done = [&]() noexcept
+	{
+		changed = internal::detail::stop_wait_changed(a, expected, observe);
+		return changed || st.stop_requested();
+	};
+
+	// One wake of the parking lot slot; request_stop() does not wait for the waiter to leave.
+	const auto wake = [&a]() noexcept { internal::detail::parking_lot_notify_all(std::addressof(a)); };
+	const stop_callback<decltype(wake)> cb(st, wake);
+
+	for (;;)
+	{
+		for (int i = 0; i < internal::detail::atomic_wait_spin_iters && !done(); ++i) { internal::detail::cpu_relax(); }
+		if (done()) { break; }
+		internal::detail::stop_wait_park(std::addressof(a), done);
+	}
+	return changed;
+}
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_THREAD_STOP_WAIT_HPP
@@ -0,0 +1,73 @@
+#ifndef SNP_INCLUDE_SNAP_THREAD_THREAD_ATTRIBUTES_HPP
+#define SNP_INCLUDE_SNAP_THREAD_THREAD_ATTRIBUTES_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Threads started with attributes are created through pthread_create so the stack size travels in a per-thread
+// pthread_attr_t; std::thread's native handle is a pthread_t there.
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+	#define SNAP_HAS_NATIVE_THREAD_START 1
+#else
+	#define SNAP_HAS_NATIVE_THREAD_START 0
+#endif
+
+SNAP_BEGIN_NAMESPACE
+
+// Start-up attributes for jthread(const thread_attributes&, f, args...).
+// Every field defaults to "inherit"; only the fields that are set are applied.
+struct thread_attributes
+{
+	enum class sched_policy
+	{
+		inherit,
+		other, // SCHED_OTHER
+		fifo,  // SCHED_FIFO
+		round_robin
+	};
+
+	// CPUs the thread may run on. Empty keeps the creator's affinity.
+	std::vector<unsigned> affinity{};
+
+	// Thread name as shown by top/perf/gdb. Linux truncates to 15 bytes.
+	std::string name{};
+
+	// Stack size in bytes. 0 keeps the platform default.
+	std::size_t stack_size = 0;
+
+	sched_policy policy = sched_policy::inherit;
+	int priority		= 0; // only meaningful for fifo/round_robin
+
+	// Per-thread nice value (Linux). Unset keeps the creator's.
+	std::optional<int> nice{};
+};
+
+namespace internal::detail
+{
+	// Applies everything but the stack size to the calling thread. On failure returns the error and sets `what`
+	// to the attribute that could not be applied.
+	std::error_code apply_thread_attributes(const thread_attributes& attrs, const char*& what) noexcept;
+
+	// Starts entry(arg) on a new thread whose stack is stack_size bytes (0 keeps the platform default). The stack
+	// size is set on an attribute object private to this thread; the process-wide defaults are left alone. On
+	// failure nothing is started and the caller still owns arg. Without native thread support, returns
+	// errc::not_supported.
+	std::error_code start_native_thread(std::size_t stack_size,
+										void* (*entry)(void*),
+										void* arg,
+										std::thread::native_handle_type& handle) noexcept;
+
+	std::error_code join_native_thread(std::thread::native_handle_type handle) noexcept;
+	std::error_code detach_native_thread(std::thread::native_handle_type handle) noexcept;
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_THREAD_THREAD_ATTRIBUTES_HPP
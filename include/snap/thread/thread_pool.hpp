@@ -0,0 +1,230 @@
+#ifndef SNP_INCLUDE_SNAP_THREAD_THREAD_POOL_HPP
+#define SNP_INCLUDE_SNAP_THREAD_THREAD_POOL_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/helpers/atomic_helpers.hpp"
+#include "snap/internal/helpers/cache_line.hpp"
+#include "snap/internal/helpers/chase_lev_deque.hpp"
+#include "snap/stop_token/stop_source.hpp"
+#include "snap/thread/jthread.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional> // std::invoke
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+SNAP_BEGIN_NAMESPACE
+
+class thread_pool;
+
+namespace internal
+{
+	struct pool_access;
+
+	// Type-erased unit of work. One allocation per submission holds the callable, the completion flag and the
+	// two references (pool side and task_handle side).
+	struct pool_task
+	{
+		using run_fn	 = void (*)(pool_task*, const stop_token&) noexcept;
+		using destroy_fn = void (*)(pool_task*) noexcept;
+
+		pool_task(run_fn r, destroy_fn d) noexcept : run(r), destroy(d) {}
+
+		void release() noexcept
+		{
+			if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) { destroy(this); }
+		}
+
+		void complete() noexcept
+		{
+			done.store(1, std::memory_order_release);
+			atomic_notify_all(done);
+		}
+
+		pool_task* next = nullptr; // injection queue link
+		run_fn run;
+		destroy_fn destroy;
+		std::atomic<std::uint32_t> refs{ 2 };
+		std::atomic<std::uint32_t> done{ 0 };
+		std::exception_ptr error{};
+	};
+
+	template <class F> struct pool_task_impl final : pool_task
+	{
+		template <class G> explicit pool_task_impl(G&& g) : pool_task(&pool_task_impl::run_impl, &pool_task_impl::destroy_impl), fn(std::forward<G>(g)) {}
+
+		static void run_impl(pool_task* base, const stop_token& st) noexcept
+		{
+			auto* self = static_cast<pool_task_impl*>(base);
+			try
+			{
+				if constexpr (std::is_invocable_v<F&, stop_token>) { std::invoke(self->fn, st); }
+				else
+				{
+					(void)st;
+					std::invoke(self->fn);
+				}
+			}
+			catch (...)
+			{
+				self->error = std::current_exception();
+			}
+			self->complete();
+			self->release();
+		}
+
+		static void destroy_impl(pool_task* base) noexcept { delete static_cast<pool_task_impl*>(base); }
+
+		F fn;
+	};
+} // namespace internal
+
+// Completion handle for a task submitted to a thread_pool. Move-only and one pointer wide; dropping it does not
+// cancel the task.
+class task_handle
+{
+public:
+	task_handle() noexcept = default;
+
+	task_handle(task_handle&& other) noexcept : task_(std::exchange(other.task_, nullptr)) {}
+
+	task_handle& operator=(task_handle&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			task_ = std::exchange(other.task_, nullptr);
+		}
+		return *this;
+	}
+
+	task_handle(const task_handle&)			   = delete;
+	task_handle& operator=(const task_handle&) = delete;
+
+	~task_handle() { reset(); }
+
+	[[nodiscard]] bool valid() const noexcept { return task_ != nullptr; }
+
+	[[nodiscard]] bool done() const noexcept { return task_->done.load(std::memory_order_acquire) != 0; }
+
+	// Blocks until the task has run; rethrows whatever it threw.
+	void wait() const
+	{
+		internal::atomic_wait(task_->done, std::uint32_t{ 0 }, std::memory_order_acquire);
+		if (task_->error) { std::rethrow_exception(task_->error); }
+	}
+
+private:
+	explicit task_handle(internal::pool_task* task) noexcept : task_(task) {}
+
+	void reset() noexcept
+	{
+		if (task_ != nullptr) { std::exchange(task_, nullptr)->release(); }
+	}
+
+	internal::pool_task* task_ = nullptr;
+
+	friend class thread_pool;
+};
+
+// Work-stealing pool of jthread workers.
+//
+// Each worker owns a Chase-Lev deque: tasks submitted from inside the pool go to the submitting worker's deque
+// (LIFO for locality), tasks from outside go to a shared injection queue, and idle workers steal from the top of
+// other deques. A worker with nothing to do parks on an epoch word through internal::atomic_wait and is woken
+// by the next submission.
+//
+// Tasks may take a stop_token; it is the running worker's token, which is stopped when the pool shuts down.
+// Shutdown is cooperative: the destructor requests stop on every worker, workers finish all queued tasks, then exit.
+class thread_pool
+{
+public:
+	explicit thread_pool(std::size_t thread_count = jthread::hardware_concurrency());
+	~thread_pool();
+
+	thread_pool(const thread_pool&)			   = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	// Queues f. From outside the pool this throws std::system_error (operation_canceled) once request_stop() has
+	// been called; tasks submitted by pool workers are still accepted and run before the workers exit.
+	template <class F> task_handle submit(F&& f)
+	{
+		using task_t = internal::pool_task_impl<std::decay_t<F>>;
+		static_assert(std::is_invocable_v<std::decay_t<F>&> || std::is_invocable_v<std::decay_t<F>&, stop_token>,
+					  "Task must be invocable with () or (stop_token)");
+
+		auto* task = new task_t(std::forward<F>(f));
+		try
+		{
+			enqueue(task);
+		}
+		catch (...)
+		{
+			delete task;
+			throw;
+		}
+		return task_handle(task);
+	}
+
+	// Asks every worker to stop. Tasks already queued still run and observe the request through their stop_token,
+	// at the latest on the thread that destroys the pool; later submits from outside the pool are rejected.
+	void request_stop() noexcept;
+
+	[[nodiscard]] std::size_t size() const noexcept { return workers_.size(); }
+
+	// Index of the calling worker in this pool, or size() when called from outside it.
+	[[nodiscard]] std::size_t current_worker_index() const noexcept;
+
+private:
+	struct worker
+	{
+		internal::chase_lev_deque<internal::pool_task*> deque{};
+		jthread thread{};
+		std::uint32_t rng = 0;
+	};
+
+	void shutdown() noexcept;
+	void enqueue(internal::pool_task* task);
+	void worker_main(const stop_token& st, std::size_t index);
+	internal::pool_task* find_task(worker* self) noexcept;
+	internal::pool_task* pop_injected() noexcept;
+	void wake_idle() noexcept;
+
+	std::vector<std::unique_ptr<worker>> workers_;
+
+	std::mutex inject_mutex_;
+	internal::pool_task* inject_head_ = nullptr;
+	internal::pool_task* inject_tail_ = nullptr;
+	bool stopping_					  = false; // guarded by inject_mutex_
+	std::atomic<std::size_t> inject_size_{ 0 };
+
+	alignas(internal::cache_line_size) std::atomic<std::uint32_t> epoch_{ 0 };
+	alignas(internal::cache_line_size) std::atomic<std::uint32_t> idle_{ 0 };
+
+	friend struct internal::pool_access;
+};
+
+namespace internal
+{
+	// Hands a caller-owned pool_task to the pool without the per-submit allocation. The pool calls task->run once
+	// and never touches the task afterwards; refs, done and error are left to the owner. Throws like submit once the
+	// pool is stopping. Used by the execution
+	// layer's pool scheduler, whose operation states are pool_tasks.
+	struct pool_access
+	{
+		static void enqueue(thread_pool& pool, pool_task* task) { pool.enqueue(task); }
+	};
+} // namespace internal
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_THREAD_THREAD_POOL_HPP
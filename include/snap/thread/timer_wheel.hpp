@@ -0,0 +1,176 @@
+#ifndef SNP_INCLUDE_SNAP_THREAD_TIMER_WHEEL_HPP
+#define SNP_INCLUDE_SNAP_THREAD_TIMER_WHEEL_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/pp/no_unique_address.hpp"
+#include "snap/stop_token/stop_callback.hpp"
+#include "snap/stop_token/stop_source.hpp"
+#include "snap/thread/jthread.hpp"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // std::invoke
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal
+{
+	// Intrusive link of an armed timer. Linked into a wheel slot or into the batch being fired.
+	struct timer_node
+	{
+		using fire_fn = void (*)(timer_node*) noexcept;
+
+		explicit timer_node(fire_fn fn) noexcept : fire(fn) {}
+
+		[[nodiscard]] bool linked() const noexcept { return next != nullptr; }
+
+		timer_node* prev	  = nullptr;
+		timer_node* next	  = nullptr;
+		std::uint64_t expires = 0; // tick
+		fire_fn fire;
+	};
+} // namespace internal
+
+// Hierarchical timing wheel (Varghese & Lauck) driven by its own jthread.
+//
+// Six levels of 64 slots each; level k holds timers due within 64^(k+1) ticks and is cascaded into the level
+// below whenever the tick count crosses one of its slot boundaries. Arming and cancelling are O(1) list
+// operations under one mutex. The driver sleeps until the next occupied level-0 slot or cascade boundary,
+// advances the wheel, and fires every timer that came due in one batch with the mutex released.
+//
+// Timers are wheel_timer objects owned by the caller, so the wheel never allocates per timer. Every timer must be
+// fired, cancelled or destroyed before the wheel is destroyed.
+class timer_wheel
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	static constexpr unsigned level_bits = 6;
+	static constexpr unsigned level_size = 1u << level_bits;
+	static constexpr unsigned levels	 = 6;
+
+	explicit timer_wheel(clock::duration resolution = std::chrono::milliseconds(1));
+	~timer_wheel();
+
+	timer_wheel(const timer_wheel&)			   = delete;
+	timer_wheel& operator=(const timer_wheel&) = delete;
+
+	[[nodiscard]] clock::duration resolution() const noexcept { return resolution_; }
+
+	// Number of armed timers.
+	[[nodiscard]] std::size_t pending() const;
+
+private:
+	template <class> friend class wheel_timer;
+
+	struct slot
+	{
+		internal::timer_node head{ nullptr }; // circular sentinel
+	};
+
+	void arm(internal::timer_node* node, clock::time_point deadline);
+	bool cancel(internal::timer_node* node) noexcept;
+	bool is_armed(const internal::timer_node* node) const;
+
+	void run(const stop_token& st);
+	void place(internal::timer_node* node) noexcept;
+	void unlink(internal::timer_node* node) noexcept;
+	void advance_to(std::uint64_t target, internal::timer_node& batch) noexcept;
+	void cascade(unsigned level) noexcept;
+	std::uint64_t next_event() const noexcept;
+	std::uint64_t ticks_until(clock::time_point t, bool round_up) const noexcept;
+
+	clock::duration resolution_;
+	clock::time_point start_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable driver_cv_;
+	std::condition_variable cancel_cv_;
+
+	std::array<std::array<slot, level_size>, levels> wheel_{};
+	std::array<std::uint64_t, levels> occupied_{}; // bit per possibly non-empty slot
+	std::uint64_t now_			= 0;			   // last tick processed
+	std::uint64_t wake_at_		= 0;			   // tick the driver sleeps until; 0 while idle
+	std::size_t pending_		= 0;
+	std::size_t cancel_waiters_ = 0;
+
+	const internal::timer_node* running_ = nullptr; // timer whose callback the driver is running
+	std::thread::id driver_id_{};
+
+	jthread driver_;
+};
+
+// A one-shot timer armed on construction: after `delay`, the wheel's driver thread calls the callback once.
+// The callback lives inside the timer object. An exception escaping it terminates.
+//
+// cancel() and the destructor guarantee that the callback is not running and will not run once they return,
+// except when called from inside the callback itself. With a stop_token, a stop request cancels the timer
+// through a stop_callback.
+template <class Callback> class wheel_timer : private internal::timer_node
+{
+	static_assert(std::is_invocable_v<Callback&>, "Callback must be invocable with no arguments");
+
+	struct cancel_on_stop
+	{
+		wheel_timer* self;
+
+		void operator()() const noexcept { self->cancel(); }
+	};
+
+public:
+	using callback_type = Callback;
+
+	template <class C, std::enable_if_t<std::is_constructible_v<Callback, C>, int> = 0>
+	wheel_timer(timer_wheel& wheel, timer_wheel::clock::duration delay, C&& cb)
+		: internal::timer_node(&wheel_timer::fire_impl), wheel_(&wheel), callback_(std::forward<C>(cb))
+	{
+		wheel_->arm(this, timer_wheel::clock::now() + delay);
+	}
+
+	template <class C, std::enable_if_t<std::is_constructible_v<Callback, C>, int> = 0>
+	wheel_timer(timer_wheel& wheel, timer_wheel::clock::duration delay, const stop_token& st, C&& cb)
+		: internal::timer_node(&wheel_timer::fire_impl), wheel_(&wheel), callback_(std::forward<C>(cb))
+	{
+		if (st.stop_requested()) { return; }
+		wheel_->arm(this, timer_wheel::clock::now() + delay);
+		on_stop_.emplace(st, cancel_on_stop{ this });
+	}
+
+	~wheel_timer()
+	{
+		on_stop_.reset();
+		cancel();
+	}
+
+	wheel_timer(const wheel_timer&)			   = delete;
+	wheel_timer& operator=(const wheel_timer&) = delete;
+
+	// Returns true if the timer was still armed, i.e. this call prevented the callback from running.
+	bool cancel() noexcept { return wheel_->cancel(this); }
+
+	[[nodiscard]] bool pending() const { return wheel_->is_armed(this); }
+
+private:
+	static void fire_impl(internal::timer_node* node) noexcept { std::invoke(static_cast<wheel_timer*>(node)->callback_); }
+
+	timer_wheel* wheel_;
+	SNAP_NO_UNIQUE_ADDRESS_ATTR Callback callback_;
+	std::optional<stop_callback<cancel_on_stop>> on_stop_;
+};
+
+template <class Callback> wheel_timer(timer_wheel&, timer_wheel::clock::duration, Callback) -> wheel_timer<Callback>;
+template <class Callback> wheel_timer(timer_wheel&, timer_wheel::clock::duration, stop_token, Callback) -> wheel_timer<Callback>;
+
+SNAP_END_NAMESPACE
+
+#endif // SNP_INCLUDE_SNAP_THREAD_TIMER_WHEEL_HPP
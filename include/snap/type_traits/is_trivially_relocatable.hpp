@@ -0,0 +1,109 @@
+#ifndef SNP_INCLUDE_SNAP_TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_HPP
+#define SNP_INCLUDE_SNAP_TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_HPP
+
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/internal/pp/has_builtin.hpp"
+#include "snap/meta/detector.hpp"
+
+#include <cstddef>
+#include <memory> // std::unique_ptr, std::shared_ptr, std::weak_ptr
+#include <type_traits>
+#include <utility> // std::pair
+
+/// SNAP_HAS_BUILTIN_IS_TRIVIALLY_RELOCATABLE
+/// 1 if the compiler can tell trivially relocatable class types apart by itself, 0 otherwise.
+#ifndef SNAP_HAS_BUILTIN_IS_TRIVIALLY_RELOCATABLE
+	#if SNAP_HAS_BUILTIN(__builtin_is_cpp_trivially_relocatable)
+		#define SNAP_HAS_BUILTIN_IS_TRIVIALLY_RELOCATABLE 1
+		#define SNAP_BUILTIN_IS_TRIVIALLY_RELOCATABLE(T) __builtin_is_cpp_trivially_relocatable(T)
+	#elif SNAP_HAS_BUILTIN(__is_trivially_relocatable)
+		#define SNAP_HAS_BUILTIN_IS_TRIVIALLY_RELOCATABLE 1
+		#define SNAP_BUILTIN_IS_TRIVIALLY_RELOCATABLE(T) __is_trivially_relocatable(T)
+	#else
+		#define SNAP_HAS_BUILTIN_IS_TRIVIALLY_RELOCATABLE 0
+	#endif
+#endif
+
+SNAP_BEGIN_NAMESPACE
+
+template <class T> struct is_trivially_relocatable;
+
+namespace detail
+{
+	// class X { public: using is_trivially_relocatable = std::true_type; };
+	template <class T> using member_trivially_relocatable_t = typename T::is_trivially_relocatable;
+
+	// libc++ marks its own relocatable types (string, vector, unique_ptr, ...) with `using __trivially_relocatable = T;`
+	template <class T> using libcpp_trivially_relocatable_t = typename T::__trivially_relocatable;
+
+	template <class T> struct tr_base
+		: std::bool_constant<std::is_trivially_copyable_v<T> || detected_or_t<std::false_type, member_trivially_relocatable_t, T>::value
+#if SNAP_HAS_BUILTIN_IS_TRIVIALLY_RELOCATABLE
+							 || SNAP_BUILTIN_IS_TRIVIALLY_RELOCATABLE(T)
+#endif
+#if defined(_LIBCPP_VERSION)
+							 || std::is_same_v<detected_t<libcpp_trivially_relocatable_t, T>, T>
+#endif
+							 >
+	{
+	};
+
+	template <class T> struct is_trivially_relocatable_impl : tr_base<T>
+	{
+	};
+
+	template <class T> struct is_trivially_relocatable_impl<T&> : std::false_type
+	{
+	};
+
+	template <class T> struct is_trivially_relocatable_impl<T&&> : std::false_type
+	{
+	};
+
+	template <class T, std::size_t N> struct is_trivially_relocatable_impl<T[N]> : is_trivially_relocatable<T>
+	{
+	};
+} // namespace detail
+
+// Whether moving a T to new storage and destroying the original is equivalent to copying its bytes, so that
+// containers may relocate elements with memcpy/memmove.
+//
+// Holds for trivially copyable types and for types the compiler recognises. Other types opt in by specializing this
+// template, with SNAP_DECLARE_TRIVIALLY_RELOCATABLE(Type) at global scope, or with a member alias
+// `using is_trivially_relocatable = std::true_type;`. Types that store pointers into themselves (libstdc++'s SSO
+// std::string, small_vector) must not opt in.
+template <class T> struct is_trivially_relocatable : detail::is_trivially_relocatable_impl<std::remove_cv_t<T>>
+{
+};
+
+template <class T> inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Standard library types known to be relocatable on every implementation.
+template <class T, class D> struct is_trivially_relocatable<std::unique_ptr<T, D>> : is_trivially_relocatable<D>
+{
+};
+
+template <class T> struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type
+{
+};
+
+template <class T> struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type
+{
+};
+
+template <class T1, class T2>
+struct is_trivially_relocatable<std::pair<T1, T2>> : std::bool_constant<is_trivially_relocatable_v<T1> && is_trivially_relocatable_v<T2>>
+{
+};
+
+SNAP_END_NAMESPACE
+
+// Declares Type trivially relocatable. Use at global namespace scope.
+#define SNAP_DECLARE_TRIVIALLY_RELOCATABLE(...)                                                                                                                \
+	template <> struct SNAP_NAMESPACE::is_trivially_relocatable<__VA_ARGS__> : std::true_type                                                              \
+	{                                                                                                                                                          \
+	}
+
+#endif // SNP_INCLUDE_SNAP_TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_HPP
@@ -0,0 +1,153 @@
+// Must be included first
+#include "snap/algorithm/parallel.hpp"
+
+#include "snap/internal/helpers/atomic_helpers.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace parallel
+{
+	thread_pool& default_pool()
+	{
+		static thread_pool pool;
+		return pool;
+	}
+} // namespace parallel
+
+namespace internal::detail
+{
+	namespace
+	{
+		// Shared by the caller and the helper tasks of one parallel_chunks call. Helpers hold a reference, so a helper
+		// that only gets to run after the call returned finds the cursor exhausted and never touches `ctx`.
+		struct chunk_state
+		{
+			std::atomic<std::size_t> cursor{ 0 };
+			std::atomic<std::size_t> completed{ 0 };
+			std::atomic<std::uint32_t> finished{ 0 };
+			std::atomic<bool> failed{ false };
+			std::atomic<bool> cancelled{ false };
+
+			std::mutex error_mutex;
+			std::exception_ptr error{};
+
+			std::size_t n			 = 0;
+			std::size_t grain		 = 1;
+			std::size_t participants = 1;
+			parallel_chunk_fn fn	 = nullptr;
+			void* ctx				 = nullptr;
+			stop_token token{};
+		};
+
+		void finish(chunk_state& s, std::size_t count) noexcept
+		{
+			if (s.completed.fetch_add(count, std::memory_order_acq_rel) + count == s.n)
+			{
+				s.finished.store(1, std::memory_order_release);
+				atomic_notify_all(s.finished);
+			}
+		}
+
+		// Claims whatever is left without running it.
+		void drain(chunk_state& s) noexcept
+		{
+			const std::size_t b = s.cursor.exchange(s.n, std::memory_order_acq_rel);
+			if (b < s.n) { finish(s, s.n - b); }
+		}
+
+		void participate(chunk_state& s) noexcept
+		{
+			for (;;)
+			{
+				if (s.failed.load(std::memory_order_relaxed)) { return drain(s); }
+				if (s.token.stop_requested())
+				{
+					s.cancelled.store(true, std::memory_order_relaxed);
+					return drain(s);
+				}
+
+				std::size_t b = s.cursor.load(std::memory_order_relaxed);
+				std::size_t e = 0;
+				do
+				{
+					if (b >= s.n) { return; }
+					const std::size_t remaining = s.n - b;
+					const std::size_t chunk		= std::max(s.grain, remaining / (2 * s.participants));
+					e							= b + std::min(chunk, remaining);
+				} while (!s.cursor.compare_exchange_weak(b, e, std::memory_order_relaxed));
+
+				try
+				{
+					s.fn(s.ctx, b, e);
+				}
+				catch (...)
+				{
+					const std::lock_guard<std::mutex> lock(s.error_mutex);
+					if (!s.error) { s.error = std::current_exception(); }
+					s.failed.store(true, std::memory_order_relaxed);
+				}
+				finish(s, e - b);
+			}
+		}
+	} // namespace
+
+	std::size_t parallel_concurrency(const parallel::policy& pol)
+	{
+		thread_pool& pool = pol.pool != nullptr ? *pol.pool : parallel::default_pool();
+		return pool.size() + 1;
+	}
+
+	void parallel_chunks(const parallel::policy& pol, std::size_t n, std::size_t grain, parallel_chunk_fn fn, void* ctx)
+	{
+		if (n == 0) { return; }
+		if (grain == 0) { grain = 1; }
+
+		if (pol.token.stop_requested()) { throw parallel::operation_cancelled(); }
+
+		// Not worth waking anyone for a single chunk.
+		if (n <= grain)
+		{
+			fn(ctx, 0, n);
+			return;
+		}
+
+		thread_pool& pool				= pol.pool != nullptr ? *pol.pool : parallel::default_pool();
+		const std::size_t max_chunks	= (n + grain - 1) / grain;
+		const std::size_t participants	= std::min(pool.size() + 1, max_chunks);
+
+		auto state			= std::make_shared<chunk_state>();
+		state->n			= n;
+		state->grain		= grain;
+		state->participants = participants;
+		state->fn			= fn;
+		state->ctx			= ctx;
+		state->token		= pol.token;
+
+		// If a submission fails the caller simply does more of the work itself.
+		try
+		{
+			for (std::size_t i = 1; i < participants; ++i)
+			{
+				pool.submit([state] { participate(*state); });
+			}
+		}
+		catch (...)
+		{
+		}
+
+		participate(*state);
+
+		// Every chunk is claimed by now; wait for the ones still running on helpers.
+		atomic_wait(state->finished, std::uint32_t{ 0 }, std::memory_order_acquire);
+
+		if (state->error) { std::rethrow_exception(state->error); }
+		if (state->cancelled.load(std::memory_order_relaxed)) { throw parallel::operation_cancelled(); }
+	}
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
@@ -0,0 +1,68 @@
+// Must be included first
+#include "snap/internal/helpers/asymmetric_fence.hpp"
+
+#include <mutex>
+
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#elif defined(__linux__) && defined(__has_include)
+	#if __has_include(<linux/membarrier.h>)
+		#include <linux/membarrier.h>
+		#include <sys/syscall.h>
+		#include <unistd.h>
+		#define SNAP_HAS_LINUX_MEMBARRIER 1
+	#endif
+#endif
+
+#ifndef SNAP_HAS_LINUX_MEMBARRIER
+	#define SNAP_HAS_LINUX_MEMBARRIER 0
+#endif
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	namespace
+	{
+		std::once_flag g_asymmetric_fence_once;
+
+		void init_asymmetric_fence() noexcept
+		{
+#if defined(_WIN32)
+			asymmetric_fence_native.store(true, std::memory_order_relaxed);
+#elif SNAP_HAS_LINUX_MEMBARRIER && defined(SYS_membarrier)
+			// Private expedited membarrier must be registered once per process before use (Linux 4.14+).
+			if (::syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0)
+			{
+				asymmetric_fence_native.store(true, std::memory_order_relaxed);
+			}
+#endif
+		}
+	} // namespace
+
+	void asymmetric_thread_fence_heavy() noexcept
+	{
+		// Every heavy caller passes through call_once, so none of them can see the flag flip mid-way
+		// and fall back to a local fence while a reader already relies on the native barrier.
+		std::call_once(g_asymmetric_fence_once, init_asymmetric_fence);
+
+		if (!asymmetric_fence_native.load(std::memory_order_relaxed))
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			return;
+		}
+
+#if defined(_WIN32)
+		::FlushProcessWriteBuffers();
+#elif SNAP_HAS_LINUX_MEMBARRIER && defined(SYS_membarrier)
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		[[maybe_unused]] const long rc = ::syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+#endif
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
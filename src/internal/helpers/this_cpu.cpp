@@ -0,0 +1,46 @@
+// Must be included first
+#include "snap/internal/helpers/this_cpu.hpp"
+
+#include <functional>
+#include <thread>
+
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#elif defined(__linux__) || defined(__ANDROID__)
+	#include <sched.h>
+#endif
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	namespace
+	{
+		[[maybe_unused]] std::uint32_t this_thread_hash() noexcept
+		{
+			// Fibonacci hashing spreads sequential thread ids across the high bits we keep.
+			thread_local const auto hash = static_cast<std::uint32_t>(
+				(static_cast<unsigned long long>(std::hash<std::thread::id>{}(std::this_thread::get_id())) * 0x9E3779B97F4A7C15ull) >> 32u);
+			return hash;
+		}
+	} // namespace
+
+	std::uint32_t this_cpu_hint() noexcept
+	{
+#if defined(_WIN32)
+		return static_cast<std::uint32_t>(::GetCurrentProcessorNumber());
+#elif defined(__linux__) || defined(__ANDROID__)
+		// glibc 2.35+ answers this from the rseq area without entering the kernel; older libcs use the vDSO.
+		const int cpu = ::sched_getcpu();
+		if (cpu >= 0) { return static_cast<std::uint32_t>(cpu); }
+		return this_thread_hash();
+#else
+		return this_thread_hash();
+#endif
+	}
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
@@ -0,0 +1,210 @@
+// Must be included first
+#include "snap/memory/hazard_pointer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal
+{
+	namespace
+	{
+		// Scans are amortized: a thread only scans once it has retired at least this many objects, and at least
+		// twice the number of hazard records, so each scan reclaims a constant fraction of what it inspects.
+		constexpr std::size_t hazard_scan_min_threshold = 64;
+
+		// Both are constant-initialized with trivial destructors, so thread-exit paths can still use them.
+		std::atomic<hazard_record*> g_hazard_records{ nullptr };
+		std::atomic<std::size_t> g_hazard_record_count{ 0 };
+
+		// Objects left behind by exited threads; the next scanning thread adopts them.
+		std::atomic<hazard_retired_node*> g_hazard_orphans{ nullptr };
+
+		void push_orphans(hazard_retired_node* first, hazard_retired_node* last) noexcept
+		{
+			hazard_retired_node* head = g_hazard_orphans.load(std::memory_order_relaxed);
+			do
+			{
+				last->retired_next = head;
+			} while (!g_hazard_orphans.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		bool is_protected_slow(const void* object) noexcept
+		{
+			for (hazard_record* rec = g_hazard_records.load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+			{
+				if (rec->ptr.load(std::memory_order_acquire) == object) { return true; }
+			}
+			return false;
+		}
+
+		struct hazard_thread_state
+		{
+			hazard_thread_state() = default;
+
+			hazard_thread_state(const hazard_thread_state&)			   = delete;
+			hazard_thread_state& operator=(const hazard_thread_state&) = delete;
+
+			~hazard_thread_state()
+			{
+				while (free_records != nullptr)
+				{
+					hazard_record* rec = free_records;
+					free_records	   = rec->next_free;
+					rec->next_free	   = nullptr;
+					rec->active.store(false, std::memory_order_release);
+				}
+
+				scan(true);
+
+				if (retired != nullptr)
+				{
+					hazard_retired_node* last = retired;
+					while (last->retired_next != nullptr) { last = last->retired_next; }
+					push_orphans(retired, last);
+					retired		  = nullptr;
+					retired_count = 0;
+				}
+			}
+
+			void push_retired(hazard_retired_node* node) noexcept
+			{
+				node->retired_next = retired;
+				retired			   = node;
+				++retired_count;
+			}
+
+			[[nodiscard]] std::size_t threshold() const noexcept
+			{
+				return (std::max)(hazard_scan_min_threshold, 2 * g_hazard_record_count.load(std::memory_order_relaxed));
+			}
+
+			void scan(bool adopt_orphans) noexcept
+			{
+				if (scanning) { return; }
+				scanning = true;
+
+				hazard_retired_node* pending = retired;
+				retired						 = nullptr;
+				retired_count				 = 0;
+
+				if (adopt_orphans || g_hazard_orphans.load(std::memory_order_relaxed) != nullptr)
+				{
+					hazard_retired_node* orphans = g_hazard_orphans.exchange(nullptr, std::memory_order_acquire);
+					while (orphans != nullptr)
+					{
+						hazard_retired_node* next = orphans->retired_next;
+						orphans->retired_next	  = pending;
+						pending					  = orphans;
+						orphans					  = next;
+					}
+				}
+
+				if (pending == nullptr)
+				{
+					scanning = false;
+					return;
+				}
+
+				// Pairs with the light fence in hazard_pointer::try_protect: after this, any reader that has not yet
+				// made its hazard visible will also observe the unlinking store and refuse the stale pointer.
+				detail::asymmetric_thread_fence_heavy();
+
+				bool sorted = true;
+				try
+				{
+					hazards.clear();
+					hazards.reserve(g_hazard_record_count.load(std::memory_order_relaxed));
+					for (hazard_record* rec = g_hazard_records.load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+					{
+						if (const void* p = rec->ptr.load(std::memory_order_acquire); p != nullptr) { hazards.push_back(p); }
+					}
+					std::sort(hazards.begin(), hazards.end());
+				}
+				catch (...)
+				{
+					sorted = false;
+				}
+
+				while (pending != nullptr)
+				{
+					hazard_retired_node* node = pending;
+					pending					  = node->retired_next;
+
+					const bool is_protected = sorted ? std::binary_search(hazards.begin(), hazards.end(), node->retired_object)
+													 : is_protected_slow(node->retired_object);
+					if (is_protected) { push_retired(node); }
+					else { node->reclaim(node); }
+				}
+
+				scanning = false;
+			}
+
+			hazard_record* free_records	 = nullptr;
+			hazard_retired_node* retired = nullptr;
+			std::size_t retired_count	 = 0;
+			bool scanning				 = false;
+			std::vector<const void*> hazards;
+		};
+
+		hazard_thread_state& this_thread_state() noexcept
+		{
+			thread_local hazard_thread_state state;
+			return state;
+		}
+	} // namespace
+
+	hazard_record* hazard_acquire_record()
+	{
+		auto& state = this_thread_state();
+		if (state.free_records != nullptr)
+		{
+			hazard_record* rec = state.free_records;
+			state.free_records = rec->next_free;
+			rec->next_free	   = nullptr;
+			return rec;
+		}
+
+		// Slow path: claim a record abandoned by an exited thread before growing the registry.
+		for (hazard_record* rec = g_hazard_records.load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+		{
+			if (!rec->active.load(std::memory_order_relaxed) && !rec->active.exchange(true, std::memory_order_acquire)) { return rec; }
+		}
+
+		auto* rec = new hazard_record();
+		rec->active.store(true, std::memory_order_relaxed);
+
+		hazard_record* head = g_hazard_records.load(std::memory_order_relaxed);
+		do
+		{
+			rec->next = head;
+		} while (!g_hazard_records.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+		g_hazard_record_count.fetch_add(1, std::memory_order_relaxed);
+		return rec;
+	}
+
+	void hazard_release_record(hazard_record* rec) noexcept
+	{
+		rec->ptr.store(nullptr, std::memory_order_release);
+
+		auto& state		   = this_thread_state();
+		rec->next_free	   = state.free_records;
+		state.free_records = rec;
+	}
+
+	void hazard_retire(hazard_retired_node* node) noexcept
+	{
+		auto& state = this_thread_state();
+		state.push_retired(node);
+		if (state.retired_count >= state.threshold()) { state.scan(false); }
+	}
+
+	void hazard_cleanup() noexcept
+	{
+		this_thread_state().scan(true);
+	}
+} // namespace internal
+
+SNAP_END_NAMESPACE
@@ -0,0 +1,166 @@
+// Must be included first
+#include "snap/memory/rcu.hpp"
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal
+{
+	namespace
+	{
+		// Retired objects are reclaimed in batches of at least this many, amortizing one grace period over the batch.
+		constexpr std::size_t rcu_batch_threshold = 64;
+
+		// Constant-initialized with a trivial destructor, so thread-exit paths can still walk it.
+		std::atomic<rcu_reader*> g_rcu_readers{ nullptr };
+
+		// Set while this thread runs deleters, so a deleter that retires more objects does not re-enter reclamation.
+		thread_local bool t_rcu_reclaiming = false;
+
+		struct rcu_reader_holder
+		{
+			rcu_reader_holder() = default;
+
+			rcu_reader_holder(const rcu_reader_holder&)			   = delete;
+			rcu_reader_holder& operator=(const rcu_reader_holder&) = delete;
+
+			~rcu_reader_holder()
+			{
+				if (reader == nullptr) { return; }
+				reader->nesting = 0;
+				reader->epoch.store(0, std::memory_order_release);
+				atomic_notify_all(reader->epoch);
+				reader->active.store(false, std::memory_order_release);
+				rcu_this_reader = nullptr;
+			}
+
+			rcu_reader* reader = nullptr;
+		};
+
+		rcu_reader* claim_reader()
+		{
+			for (rcu_reader* rec = g_rcu_readers.load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+			{
+				if (!rec->active.load(std::memory_order_relaxed) && !rec->active.exchange(true, std::memory_order_acquire)) { return rec; }
+			}
+
+			auto* rec = new rcu_reader();
+			rec->active.store(true, std::memory_order_relaxed);
+
+			rcu_reader* head = g_rcu_readers.load(std::memory_order_relaxed);
+			do
+			{
+				rec->next = head;
+			} while (!g_rcu_readers.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+			return rec;
+		}
+
+		bool in_read_side_section() noexcept
+		{
+			const rcu_reader* self = rcu_this_reader;
+			return self != nullptr && self->nesting != 0;
+		}
+	} // namespace
+
+	rcu_reader* rcu_register_reader()
+	{
+		thread_local rcu_reader_holder holder;
+		if (holder.reader == nullptr) { holder.reader = claim_reader(); }
+		rcu_this_reader = holder.reader;
+		return holder.reader;
+	}
+} // namespace internal
+
+rcu_domain& rcu_default_domain() noexcept
+{
+	// Intentionally leaked: threads may still enter critical sections or retire objects during static destruction.
+	static rcu_domain* const dom = new rcu_domain();
+	return *dom;
+}
+
+void rcu_domain::synchronize() noexcept
+{
+	const std::lock_guard<std::mutex> guard(gp_mutex_);
+
+	internal::rcu_reader* const readers = internal::g_rcu_readers.load(std::memory_order_acquire);
+
+	// Announce ourselves before the epoch flip, so any reader that leaves a section after the heavy fence
+	// is guaranteed to see the flag and wake us.
+	for (internal::rcu_reader* rec = readers; rec != nullptr; rec = rec->next) { rec->waiter.store(1, std::memory_order_relaxed); }
+
+	std::uint32_t next = epoch_.load(std::memory_order_relaxed) + 1;
+	if (next == 0) { next = 1; }
+	epoch_.store(next, std::memory_order_relaxed);
+
+	// Pairs with the light fences in lock()/unlock(): afterwards every reader either already published the epoch
+	// it entered with, or will observe the new epoch and every store made before this call.
+	internal::detail::asymmetric_thread_fence_heavy();
+
+	for (internal::rcu_reader* rec = readers; rec != nullptr; rec = rec->next)
+	{
+		for (;;)
+		{
+			const std::uint32_t seen = rec->epoch.load(std::memory_order_acquire);
+			if (seen == 0 || seen == next) { break; }
+			internal::atomic_wait(rec->epoch, seen, std::memory_order_acquire);
+		}
+	}
+
+	for (internal::rcu_reader* rec = readers; rec != nullptr; rec = rec->next) { rec->waiter.store(0, std::memory_order_relaxed); }
+}
+
+void rcu_domain::reclaim_batch() noexcept
+{
+	internal::rcu_retired_node* batch = retired_.exchange(nullptr, std::memory_order_acquire);
+	if (batch == nullptr) { return; }
+
+	synchronize();
+
+	internal::t_rcu_reclaiming = true;
+	std::size_t reclaimed	   = 0;
+	while (batch != nullptr)
+	{
+		internal::rcu_retired_node* next = batch->retired_next;
+		batch->reclaim(batch);
+		batch = next;
+		++reclaimed;
+	}
+	internal::t_rcu_reclaiming = false;
+
+	retired_count_.fetch_sub(reclaimed, std::memory_order_relaxed);
+}
+
+void rcu_domain::retire_node(internal::rcu_retired_node* node) noexcept
+{
+	internal::rcu_retired_node* head = retired_.load(std::memory_order_relaxed);
+	do
+	{
+		node->retired_next = head;
+	} while (!retired_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+	if (retired_count_.fetch_add(1, std::memory_order_relaxed) + 1 < internal::rcu_batch_threshold) { return; }
+
+	// Waiting for a grace period from inside a read-side section would deadlock, and a deleter that retires
+	// must not recurse into reclamation; leave the batch for the next eligible caller.
+	if (internal::in_read_side_section() || internal::t_rcu_reclaiming) { return; }
+
+	std::unique_lock<std::mutex> lock(reclaim_mutex_, std::try_to_lock);
+	if (lock.owns_lock()) { reclaim_batch(); }
+}
+
+void rcu_domain::barrier() noexcept
+{
+	const std::lock_guard<std::mutex> guard(reclaim_mutex_);
+	reclaim_batch();
+}
+
+void rcu_synchronize(rcu_domain& dom) noexcept
+{
+	dom.synchronize();
+}
+
+void rcu_barrier(rcu_domain& dom) noexcept
+{
+	dom.barrier();
+}
+
+SNAP_END_NAMESPACE
@@ -0,0 +1,93 @@
+// Must be included first
+#include "snap/stop_token/stop_state_allocation.hpp"
+
+#include <cstddef>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	namespace
+	{
+		constexpr std::size_t stop_state_block_size = sizeof(stop_state);
+		constexpr std::size_t stop_state_cache_max	= 64;
+
+		struct free_block
+		{
+			free_block* next;
+		};
+
+		static_assert(sizeof(free_block) <= stop_state_block_size, "stop_state blocks must be able to hold a free-list link");
+
+		// Trivially destructible so it stays usable while other thread_local destructors release stop sources.
+		struct stop_state_cache
+		{
+			free_block* head  = nullptr;
+			std::size_t count = 0;
+			bool draining	  = false;
+		};
+
+		thread_local stop_state_cache t_cache;
+
+		void drain(stop_state_cache& cache) noexcept
+		{
+			while (cache.head != nullptr)
+			{
+				free_block* next = cache.head->next;
+				::operator delete(static_cast<void*>(cache.head));
+				cache.head = next;
+			}
+			cache.count = 0;
+		}
+
+		// Frees the cached blocks at thread exit; after that, deallocations bypass the cache.
+		struct stop_state_cache_cleanup
+		{
+			stop_state_cache_cleanup() = default;
+
+			stop_state_cache_cleanup(const stop_state_cache_cleanup&)			 = delete;
+			stop_state_cache_cleanup& operator=(const stop_state_cache_cleanup&) = delete;
+
+			~stop_state_cache_cleanup()
+			{
+				t_cache.draining = true;
+				drain(t_cache);
+			}
+		};
+	} // namespace
+
+	void* stop_state_pool_allocate()
+	{
+		stop_state_cache& cache = t_cache;
+		if (cache.head != nullptr)
+		{
+			free_block* block = cache.head;
+			cache.head		  = block->next;
+			--cache.count;
+			return block;
+		}
+		return ::operator new(stop_state_block_size);
+	}
+
+	void stop_state_pool_deallocate(void* block) noexcept
+	{
+		stop_state_cache& cache = t_cache;
+		if (cache.draining || cache.count == stop_state_cache_max)
+		{
+			::operator delete(block);
+			return;
+		}
+
+		if (cache.head == nullptr && cache.count == 0)
+		{
+			// First block cached on this thread: arm the cleanup that returns the cache to the heap at thread exit.
+			thread_local stop_state_cache_cleanup cleanup;
+			(void)cleanup;
+		}
+
+		cache.head = ::new (block) free_block{ cache.head };
+		++cache.count;
+	}
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
@@ -0,0 +1,57 @@
+// Must be included first
+#include "snap/thread/queue_lock.hpp"
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	namespace
+	{
+		// Nodes are recycled per thread and only freed at thread exit. A releaser may still issue a wake-up
+		// on a node word after its owner has moved on, so nodes must outlive any single lock()/unlock() pair.
+		struct node_cache
+		{
+			node_cache() = default;
+
+			node_cache(const node_cache&)			 = delete;
+			node_cache& operator=(const node_cache&) = delete;
+
+			~node_cache()
+			{
+				while (head != nullptr)
+				{
+					queue_lock_node* next = head->next.load(std::memory_order_relaxed);
+					delete head;
+					head = next;
+				}
+			}
+
+			queue_lock_node* head = nullptr;
+		};
+
+		node_cache& this_thread_cache() noexcept
+		{
+			thread_local node_cache cache;
+			return cache;
+		}
+	} // namespace
+
+	queue_lock_node* queue_lock_acquire_node()
+	{
+		auto& cache = this_thread_cache();
+		if (cache.head == nullptr) { return new queue_lock_node(); }
+
+		queue_lock_node* n = cache.head;
+		cache.head		   = n->next.load(std::memory_order_relaxed);
+		return n;
+	}
+
+	void queue_lock_release_node(queue_lock_node* node) noexcept
+	{
+		auto& cache = this_thread_cache();
+		node->next.store(cache.head, std::memory_order_relaxed);
+		cache.head = node;
+	}
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
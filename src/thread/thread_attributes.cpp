@@ -0,0 +1,164 @@
+// Must be included first
+#include "snap/thread/thread_attributes.hpp"
+
+#include <cerrno>
+
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+	#include <pthread.h>
+	#include <sched.h>
+	#define SNAP_THREAD_ATTRIBUTES_PTHREAD 1
+#endif
+
+#if defined(__linux__)
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+#ifndef SNAP_THREAD_ATTRIBUTES_PTHREAD
+	#define SNAP_THREAD_ATTRIBUTES_PTHREAD 0
+#endif
+
+SNAP_BEGIN_NAMESPACE
+
+namespace internal::detail
+{
+	namespace
+	{
+		std::error_code errno_code(int e) noexcept
+		{
+			return { e, std::generic_category() };
+		}
+
+		[[maybe_unused]] std::error_code not_supported() noexcept
+		{
+			return std::make_error_code(std::errc::not_supported);
+		}
+
+#if SNAP_THREAD_ATTRIBUTES_PTHREAD
+		int native_policy(thread_attributes::sched_policy policy) noexcept
+		{
+			switch (policy)
+			{
+			case thread_attributes::sched_policy::fifo: return SCHED_FIFO;
+			case thread_attributes::sched_policy::round_robin: return SCHED_RR;
+			case thread_attributes::sched_policy::other: [[fallthrough]];
+			case thread_attributes::sched_policy::inherit: [[fallthrough]];
+			default: return SCHED_OTHER;
+			}
+		}
+#endif
+	} // namespace
+
+	std::error_code apply_thread_attributes(const thread_attributes& attrs, const char*& what) noexcept
+	{
+		if (!attrs.name.empty())
+		{
+			what = "name";
+#if defined(__linux__)
+			// The kernel limit is 16 bytes including the terminator.
+			char buf[16] = {};
+			attrs.name.copy(buf, sizeof(buf) - 1);
+			if (const int rc = ::pthread_setname_np(::pthread_self(), buf); rc != 0) { return errno_code(rc); }
+#elif defined(__APPLE__)
+			if (const int rc = ::pthread_setname_np(attrs.name.c_str()); rc != 0) { return errno_code(rc); }
+#else
+			return not_supported();
+#endif
+		}
+
+		if (!attrs.affinity.empty())
+		{
+			what = "affinity";
+#if defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			for (const unsigned cpu : attrs.affinity)
+			{
+				if (cpu >= CPU_SETSIZE) { return errno_code(EINVAL); }
+				CPU_SET(cpu, &set);
+			}
+			if (const int rc = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set); rc != 0) { return errno_code(rc); }
+#else
+			return not_supported();
+#endif
+		}
+
+		if (attrs.policy != thread_attributes::sched_policy::inherit)
+		{
+			what = "scheduling policy";
+#if SNAP_THREAD_ATTRIBUTES_PTHREAD
+			sched_param param{};
+			param.sched_priority = attrs.policy == thread_attributes::sched_policy::other ? 0 : attrs.priority;
+			if (const int rc = ::pthread_setschedparam(::pthread_self(), native_policy(attrs.policy), &param); rc != 0) { return errno_code(rc); }
+#else
+			return not_supported();
+#endif
+		}
+
+		if (attrs.nice.has_value())
+		{
+			what = "nice";
+#if defined(__linux__)
+			// On Linux, nice is a per-thread attribute addressed by the kernel thread id.
+			const auto tid = static_cast<id_t>(::syscall(SYS_gettid));
+			if (::setpriority(PRIO_PROCESS, tid, *attrs.nice) != 0) { return errno_code(errno); }
+#else
+			return not_supported();
+#endif
+		}
+
+		what = nullptr;
+		return {};
+	}
+
+	std::error_code start_native_thread(std::size_t stack_size,
+										void* (*entry)(void*),
+										void* arg,
+										std::thread::native_handle_type& handle) noexcept
+	{
+#if SNAP_HAS_NATIVE_THREAD_START
+		pthread_attr_t attr;
+		if (const int rc = ::pthread_attr_init(&attr); rc != 0) { return errno_code(rc); }
+
+		int rc = stack_size != 0 ? ::pthread_attr_setstacksize(&attr, stack_size) : 0;
+		pthread_t thread{};
+		if (rc == 0) { rc = ::pthread_create(&thread, &attr, entry, arg); }
+		::pthread_attr_destroy(&attr);
+
+		if (rc != 0) { return errno_code(rc); }
+		handle = thread;
+		return {};
+#else
+		(void)stack_size;
+		(void)entry;
+		(void)arg;
+		(void)handle;
+		return not_supported();
+#endif
+	}
+
+	std::error_code join_native_thread(std::thread::native_handle_type handle) noexcept
+	{
+#if SNAP_HAS_NATIVE_THREAD_START
+		if (const int rc = ::pthread_join(handle, nullptr); rc != 0) { return errno_code(rc); }
+		return {};
+#else
+		(void)handle;
+		return not_supported();
+#endif
+	}
+
+	std::error_code detach_native_thread(std::thread::native_handle_type handle) noexcept
+	{
+#if SNAP_HAS_NATIVE_THREAD_START
+		if (const int rc = ::pthread_detach(handle); rc != 0) { return errno_code(rc); }
+		return {};
+#else
+		(void)handle;
+		return not_supported();
+#endif
+	}
+} // namespace internal::detail
+
+SNAP_END_NAMESPACE
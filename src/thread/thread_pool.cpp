@@ -0,0 +1,191 @@
+// Must be included first
+#include "snap/thread/thread_pool.hpp"
+
+SNAP_BEGIN_NAMESPACE
+
+namespace
+{
+	// Worker of the pool the calling thread belongs to, if any.
+	thread_local const thread_pool* t_pool	 = nullptr;
+	thread_local std::size_t t_worker_index = 0;
+
+	constexpr int idle_spin_rounds = 64;
+
+	std::uint32_t next_random(std::uint32_t& state) noexcept
+	{
+		// xorshift32; only used to pick steal victims.
+		state ^= state << 13u;
+		state ^= state >> 17u;
+		state ^= state << 5u;
+		return state;
+	}
+} // namespace
+
+thread_pool::thread_pool(std::size_t thread_count)
+{
+	if (thread_count == 0) { thread_count = 1; }
+
+	workers_.reserve(thread_count);
+	for (std::size_t i = 0; i < thread_count; ++i)
+	{
+		workers_.push_back(std::make_unique<worker>());
+		workers_.back()->rng = static_cast<std::uint32_t>(i * 0x9E3779B9u + 1u);
+	}
+
+	// Deques exist before any thread starts, so workers can steal from each other from the first iteration.
+	try
+	{
+		for (std::size_t i = 0; i < thread_count; ++i)
+		{
+			workers_[i]->thread = jthread([this, i](stop_token st) { worker_main(st, i); });
+		}
+	}
+	catch (...)
+	{
+		shutdown();
+		throw;
+	}
+}
+
+thread_pool::~thread_pool()
+{
+	shutdown();
+}
+
+void thread_pool::shutdown() noexcept
+{
+	request_stop();
+
+	// Join everyone before any deque is destroyed: a worker may still be stealing from a neighbour.
+	for (auto& w : workers_)
+	{
+		if (w->thread.joinable()) { w->thread.join(); }
+	}
+
+	// A submit that was admitted just before the stop may have found every worker already gone. Run what is left
+	// here, with a stopped token, so no task_handle waits forever.
+	stop_source stopped;
+	stopped.request_stop();
+	while (internal::pool_task* task = pop_injected()) { task->run(task, stopped.get_token()); }
+}
+
+void thread_pool::request_stop() noexcept
+{
+	{
+		const std::lock_guard<std::mutex> lock(inject_mutex_);
+		stopping_ = true;
+	}
+	for (auto& w : workers_) { w->thread.request_stop(); }
+
+	epoch_.fetch_add(1, std::memory_order_seq_cst);
+	internal::atomic_notify_all(epoch_);
+}
+
+std::size_t thread_pool::current_worker_index() const noexcept
+{
+	return t_pool == this ? t_worker_index : workers_.size();
+}
+
+void thread_pool::enqueue(internal::pool_task* task)
+{
+	if (t_pool == this) { workers_[t_worker_index]->deque.push(task); }
+	else
+	{
+		const std::lock_guard<std::mutex> lock(inject_mutex_);
+		if (stopping_) { throw std::system_error(std::make_error_code(std::errc::operation_canceled), "thread_pool: stop requested"); }
+		task->next = nullptr;
+		if (inject_tail_ != nullptr) { inject_tail_->next = task; }
+		else { inject_head_ = task; }
+		inject_tail_ = task;
+		inject_size_.fetch_add(1, std::memory_order_release);
+	}
+
+	wake_idle();
+}
+
+void thread_pool::wake_idle() noexcept
+{
+	// Pairs with the fence in worker_main: either a parking worker's re-check finds the task just published, or this
+	// load sees its idle_ increment and the epoch bump wakes it. Busy pools skip the shared epoch line entirely.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (idle_.load(std::memory_order_relaxed) == 0) { return; }
+
+	epoch_.fetch_add(1, std::memory_order_seq_cst);
+	internal::atomic_notify_all(epoch_);
+}
+
+internal::pool_task* thread_pool::pop_injected() noexcept
+{
+	if (inject_size_.load(std::memory_order_acquire) == 0) { return nullptr; }
+
+	const std::lock_guard<std::mutex> lock(inject_mutex_);
+	internal::pool_task* task = inject_head_;
+	if (task != nullptr)
+	{
+		inject_head_ = task->next;
+		if (inject_head_ == nullptr) { inject_tail_ = nullptr; }
+		inject_size_.fetch_sub(1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+internal::pool_task* thread_pool::find_task(worker* self) noexcept
+{
+	if (internal::pool_task* task = self->deque.pop()) { return task; }
+	if (internal::pool_task* task = pop_injected()) { return task; }
+
+	const std::size_t n = workers_.size();
+	if (n > 1)
+	{
+		const std::size_t start = next_random(self->rng) % n;
+		for (std::size_t k = 0; k < n; ++k)
+		{
+			worker* victim = workers_[(start + k) % n].get();
+			if (victim == self) { continue; }
+			if (internal::pool_task* task = victim->deque.steal()) { return task; }
+		}
+	}
+	return nullptr;
+}
+
+void thread_pool::worker_main(const stop_token& st, std::size_t index)
+{
+	t_pool		   = this;
+	t_worker_index = index;
+
+	worker* self = workers_[index].get();
+
+	for (;;)
+	{
+		internal::pool_task* task = find_task(self);
+		for (int spin = 0; task == nullptr && spin < idle_spin_rounds; ++spin)
+		{
+			internal::detail::cpu_relax();
+			task = find_task(self);
+		}
+
+		if (task != nullptr)
+		{
+			task->run(task, st);
+			continue;
+		}
+
+		// Queues were empty. Exit only once stop is requested, so queued work always drains first.
+		if (st.stop_requested()) { break; }
+
+		const std::uint32_t seen = epoch_.load(std::memory_order_seq_cst);
+		idle_.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		task = find_task(self);
+		if (task == nullptr && !st.stop_requested()) { internal::atomic_wait(epoch_, seen, std::memory_order_seq_cst); }
+
+		idle_.fetch_sub(1, std::memory_order_seq_cst);
+
+		if (task != nullptr) { task->run(task, st); }
+	}
+
+	t_pool = nullptr;
+}
+
+SNAP_END_NAMESPACE
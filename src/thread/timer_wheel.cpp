@@ -0,0 +1,262 @@
+// Must be included first
+#include "snap/thread/timer_wheel.hpp"
+
+#include "snap/bit/countr.hpp"
+#include "snap/bit/rotr.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+SNAP_BEGIN_NAMESPACE
+
+namespace
+{
+	constexpr std::uint64_t no_event = std::numeric_limits<std::uint64_t>::max();
+
+	// Ticks covered by levels [0, level].
+	constexpr std::uint64_t span_of(unsigned level) noexcept
+	{
+		return std::uint64_t{ 1 } << (timer_wheel::level_bits * (level + 1));
+	}
+
+	void splice_back(internal::timer_node& list, internal::timer_node& from) noexcept
+	{
+		if (from.next == &from) { return; }
+
+		internal::timer_node* first = from.next;
+		internal::timer_node* last	= from.prev;
+
+		first->prev		= list.prev;
+		list.prev->next = first;
+		last->next		= &list;
+		list.prev		= last;
+
+		from.next = &from;
+		from.prev = &from;
+	}
+} // namespace
+
+timer_wheel::timer_wheel(clock::duration resolution) : resolution_(resolution > clock::duration::zero() ? resolution : clock::duration(1)), start_(clock::now())
+{
+	for (auto& level : wheel_)
+	{
+		for (auto& s : level)
+		{
+			s.head.prev = &s.head;
+			s.head.next = &s.head;
+		}
+	}
+
+	driver_ = jthread([this](stop_token st) { run(st); });
+}
+
+timer_wheel::~timer_wheel()
+{
+	driver_.request_stop();
+	{
+		const std::lock_guard<std::mutex> lock(mutex_);
+		driver_cv_.notify_all();
+	}
+	driver_.join();
+}
+
+std::size_t timer_wheel::pending() const
+{
+	const std::lock_guard<std::mutex> lock(mutex_);
+	return pending_;
+}
+
+std::uint64_t timer_wheel::ticks_until(clock::time_point t, bool round_up) const noexcept
+{
+	const auto elapsed = t - start_;
+	if (elapsed <= clock::duration::zero()) { return 0; }
+
+	const auto ticks = static_cast<std::uint64_t>(elapsed / resolution_);
+	return round_up && elapsed % resolution_ != clock::duration::zero() ? ticks + 1 : ticks;
+}
+
+void timer_wheel::arm(internal::timer_node* node, clock::time_point deadline)
+{
+	const std::lock_guard<std::mutex> lock(mutex_);
+
+	// Rounded up so a timer never fires before its deadline, and never into a tick already processed.
+	node->expires = std::max(ticks_until(deadline, true), now_ + 1);
+	place(node);
+	++pending_;
+
+	if (wake_at_ == 0 || node->expires < wake_at_) { driver_cv_.notify_one(); }
+}
+
+bool timer_wheel::cancel(internal::timer_node* node) noexcept
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (node->linked())
+	{
+		unlink(node);
+		--pending_;
+		return true;
+	}
+
+	// Already fired or firing. Wait the callback out unless we are that callback.
+	if (running_ == node && std::this_thread::get_id() != driver_id_)
+	{
+		++cancel_waiters_;
+		cancel_cv_.wait(lock, [&] { return running_ != node; });
+		--cancel_waiters_;
+	}
+	return false;
+}
+
+bool timer_wheel::is_armed(const internal::timer_node* node) const
+{
+	const std::lock_guard<std::mutex> lock(mutex_);
+	return node->linked();
+}
+
+void timer_wheel::place(internal::timer_node* node) noexcept
+{
+	const std::uint64_t delta = node->expires - now_;
+
+	unsigned level = 0;
+	while (level + 1 < levels && delta >= span_of(level)) { ++level; }
+
+	// Beyond the top level: park in its furthest slot and re-place on cascade.
+	const std::uint64_t tick  = delta < span_of(levels - 1) ? node->expires : now_ + span_of(levels - 1) - 1;
+	const unsigned index	  = static_cast<unsigned>(tick >> (level_bits * level)) & (level_size - 1);
+	internal::timer_node& head = wheel_[level][index].head;
+
+	node->prev		= head.prev;
+	node->next		= &head;
+	head.prev->next = node;
+	head.prev		= node;
+
+	occupied_[level] |= std::uint64_t{ 1 } << index;
+}
+
+void timer_wheel::unlink(internal::timer_node* node) noexcept
+{
+	internal::timer_node* prev = node->prev;
+	internal::timer_node* next = node->next;
+	prev->next				   = next;
+	next->prev				   = prev;
+	node->prev				   = nullptr;
+	node->next				   = nullptr;
+
+	// Sentinels have no fire function. If this emptied a wheel slot, clear its occupancy bit; otherwise the bit
+	// is only cleared when the slot is next processed.
+	if (prev == next && prev->fire == nullptr)
+	{
+		const slot* first = &wheel_[0][0];
+		const auto* s	  = reinterpret_cast<const slot*>(prev);
+		if (!std::less<const slot*>{}(s, first) && std::less<const slot*>{}(s, first + levels * level_size))
+		{
+			const auto offset = static_cast<unsigned>(s - first);
+			occupied_[offset / level_size] &= ~(std::uint64_t{ 1 } << (offset % level_size));
+		}
+	}
+}
+
+void timer_wheel::cascade(unsigned level) noexcept
+{
+	const unsigned index = static_cast<unsigned>(now_ >> (level_bits * level)) & (level_size - 1);
+	occupied_[level] &= ~(std::uint64_t{ 1 } << index);
+
+	internal::timer_node& head = wheel_[level][index].head;
+	internal::timer_node moving(nullptr);
+	moving.prev = &moving;
+	moving.next = &moving;
+	splice_back(moving, head);
+
+	while (moving.next != &moving)
+	{
+		internal::timer_node* node = moving.next;
+		moving.next				   = node->next;
+		node->next->prev		   = &moving;
+		place(node);
+	}
+}
+
+std::uint64_t timer_wheel::next_event() const noexcept
+{
+	std::uint64_t next = no_event;
+
+	// Bit i of `ahead` is the level-0 slot for tick now_ + 1 + i.
+	const std::uint64_t ahead = rotr(occupied_[0], static_cast<int>((now_ + 1) & (level_size - 1)));
+	if (ahead != 0) { next = now_ + 1 + static_cast<std::uint64_t>(countr_zero(ahead)); }
+
+	// Anything on a higher level needs the driver at the next level-0 wrap to cascade.
+	if (std::any_of(occupied_.begin() + 1, occupied_.end(), [](std::uint64_t bits) { return bits != 0; }))
+	{
+		next = std::min(next, (now_ | (level_size - 1)) + 1);
+	}
+	return next;
+}
+
+void timer_wheel::advance_to(std::uint64_t target, internal::timer_node& batch) noexcept
+{
+	while (now_ < target)
+	{
+		// Ticks with nothing to fire or cascade are skipped outright.
+		now_ = std::min(next_event(), target);
+
+		if ((now_ & (level_size - 1)) == 0)
+		{
+			unsigned top = 1;
+			while (top + 1 < levels && (now_ & (span_of(top) - 1)) == 0) { ++top; }
+			for (unsigned level = top; level >= 1; --level) { cascade(level); }
+		}
+
+		const unsigned index = static_cast<unsigned>(now_) & (level_size - 1);
+		occupied_[0] &= ~(std::uint64_t{ 1 } << index);
+		splice_back(batch, wheel_[0][index].head);
+	}
+}
+
+void timer_wheel::run(const stop_token& st)
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	driver_id_ = std::this_thread::get_id();
+
+	internal::timer_node batch(nullptr);
+	batch.prev = &batch;
+	batch.next = &batch;
+
+	while (!st.stop_requested())
+	{
+		advance_to(ticks_until(clock::now(), false), batch);
+
+		// Fire the batch one timer at a time so that cancel() can still pull timers out of it.
+		while (batch.next != &batch)
+		{
+			internal::timer_node* node = batch.next;
+			unlink(node);
+			--pending_;
+			running_ = node;
+
+			lock.unlock();
+			node->fire(node);
+			lock.lock();
+
+			running_ = nullptr;
+			if (cancel_waiters_ != 0) { cancel_cv_.notify_all(); }
+		}
+
+		// Re-checked under the lock: a stop requested while a callback ran must not be slept through.
+		if (st.stop_requested()) { break; }
+
+		const std::uint64_t next = next_event();
+		if (next == no_event)
+		{
+			wake_at_ = 0;
+			driver_cv_.wait(lock);
+		}
+		else
+		{
+			wake_at_ = next;
+			driver_cv_.wait_until(lock, start_ + resolution_ * static_cast<clock::rep>(next));
+		}
+	}
+}
+
+SNAP_END_NAMESPACE
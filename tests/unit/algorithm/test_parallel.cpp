@@ -0,0 +1,194 @@
+#include "snap/algorithm/parallel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace par = SNAP_NAMESPACE::parallel;
+
+TEST(Parallel, ForEachAndTransformVisitEveryElement)
+{
+	SNAP_NAMESPACE::thread_pool pool(4);
+	const par::policy pol{ &pool, {}, 64 };
+
+	std::vector<int> v(100000, 1);
+	par::for_each(pol, SNAP_NAMESPACE::span<int>(v), [](int& x) { x += 1; });
+	EXPECT_TRUE(std::all_of(v.begin(), v.end(), [](int x) { return x == 2; }));
+
+	std::vector<long> out(v.size());
+	par::transform(pol, SNAP_NAMESPACE::span<const int>(v), SNAP_NAMESPACE::span<long>(out), [](int x) { return x * 10L; });
+	EXPECT_TRUE(std::all_of(out.begin(), out.end(), [](long x) { return x == 20; }));
+
+	// Default pool, no policy.
+	par::for_each(SNAP_NAMESPACE::span<int>(v), [](int& x) { x = 0; });
+	EXPECT_EQ(std::count(v.begin(), v.end(), 0), static_cast<long>(v.size()));
+}
+
+TEST(Parallel, ReduceMatchesSerial)
+{
+	std::vector<std::uint64_t> v(1000003);
+	std::iota(v.begin(), v.end(), 1);
+
+	const std::uint64_t expected = std::accumulate(v.begin(), v.end(), std::uint64_t{ 7 });
+	EXPECT_EQ(par::reduce(SNAP_NAMESPACE::span<const std::uint64_t>(v), std::uint64_t{ 7 }), expected);
+
+	const auto squares = par::transform_reduce(SNAP_NAMESPACE::span<const std::uint64_t>(v.data(), 1000), std::uint64_t{ 0 }, std::plus<>{},
+											   [](std::uint64_t x) { return x * x; });
+	EXPECT_EQ(squares, std::uint64_t{ 1000 } * 1001 * 2001 / 6);
+
+	std::vector<double> a(5000, 2.0);
+	std::vector<double> b(5000, 0.5);
+	EXPECT_DOUBLE_EQ(par::transform_reduce(SNAP_NAMESPACE::span<const double>(a), SNAP_NAMESPACE::span<const double>(b), 0.0), 5000.0);
+}
+
+TEST(Parallel, ReduceKeepsOrderForNonCommutativeOps)
+{
+	SNAP_NAMESPACE::thread_pool pool(3);
+	const par::policy pol{ &pool, {}, 16 };
+
+	std::vector<std::string> words(1000);
+	for (std::size_t i = 0; i < words.size(); ++i) { words[i] = std::string(1, static_cast<char>('a' + i % 26)); }
+
+	const std::string expected = std::accumulate(words.begin(), words.end(), std::string{});
+	EXPECT_EQ(par::reduce(pol, SNAP_NAMESPACE::span<const std::string>(words), std::string{}), expected);
+}
+
+TEST(Parallel, InclusiveScanMatchesSerial)
+{
+	SNAP_NAMESPACE::thread_pool pool(4);
+	const par::policy pol{ &pool, {}, 100 };
+
+	for (const std::size_t n : { std::size_t{ 0 }, std::size_t{ 1 }, std::size_t{ 99 }, std::size_t{ 12345 } })
+	{
+		std::vector<long> v(n);
+		std::iota(v.begin(), v.end(), 1);
+		std::vector<long> expected(n);
+		std::partial_sum(v.begin(), v.end(), expected.begin());
+
+		std::vector<long> out(n);
+		par::inclusive_scan(pol, SNAP_NAMESPACE::span<const long>(v), SNAP_NAMESPACE::span<long>(out));
+		EXPECT_EQ(out, expected);
+
+		// In place.
+		par::inclusive_scan(pol, SNAP_NAMESPACE::span<long>(v), SNAP_NAMESPACE::span<long>(v));
+		EXPECT_EQ(v, expected);
+	}
+}
+
+TEST(Parallel, SortMatchesStdSort)
+{
+	SNAP_NAMESPACE::thread_pool pool(4);
+	const par::policy pol{ &pool, {}, 500 };
+
+	std::mt19937 rng(42);
+	std::vector<int> v(200001);
+	for (auto& x : v) { x = static_cast<int>(rng() % 100000); }
+	std::vector<int> expected = v;
+	std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+	par::sort(pol, SNAP_NAMESPACE::span<int>(v), std::greater<>{});
+	EXPECT_EQ(v, expected);
+}
+
+TEST(Parallel, SortMergesManyRunsOfNonTrivialElements)
+{
+	SNAP_NAMESPACE::thread_pool pool(3);
+	const par::policy pol{ &pool, {}, 64 };
+
+	// An odd number of uneven blocks with heavy duplicates exercises the co-rank split of every merge round.
+	std::mt19937 rng(7);
+	std::vector<std::string> v(5003);
+	for (auto& s : v) { s = std::string(24, 'a') + std::to_string(rng() % 300); }
+	std::vector<std::string> expected = v;
+	std::sort(expected.begin(), expected.end());
+
+	par::sort(pol, SNAP_NAMESPACE::span<std::string>(v));
+	EXPECT_EQ(v, expected);
+
+	std::vector<std::string> one{ "b", "a" };
+	par::sort(pol, SNAP_NAMESPACE::span<std::string>(one));
+	EXPECT_EQ(one, (std::vector<std::string>{ "a", "b" }));
+}
+
+TEST(Parallel, CancelledSortLeavesPermutation)
+{
+	SNAP_NAMESPACE::thread_pool pool(2);
+	SNAP_NAMESPACE::stop_source source;
+	const par::policy pol{ &pool, source.get_token(), 32 };
+
+	std::mt19937 rng(3);
+	std::vector<std::string> v(4000);
+	for (auto& s : v) { s = std::to_string(rng() % 1000) + std::string(20, 'x'); }
+	const std::vector<std::string> original = v;
+
+	// Count the comparisons of an uncancelled run, then stop before the last merge round starts.
+	std::atomic<std::size_t> compared{ 0 };
+	std::size_t stop_at = 0;
+	auto comp			= [&](const std::string& a, const std::string& b)
+	{
+		if (compared.fetch_add(1) + 1 == stop_at) { source.request_stop(); }
+		return a < b;
+	};
+	std::vector<std::string> dry = v;
+	par::sort(pol, SNAP_NAMESPACE::span<std::string>(dry), comp);
+	stop_at	 = compared.load() - 2 * v.size();
+	compared = 0;
+
+	EXPECT_THROW(par::sort(pol, SNAP_NAMESPACE::span<std::string>(v), comp), par::operation_cancelled);
+	EXPECT_TRUE(std::is_permutation(v.begin(), v.end(), original.begin()));
+}
+
+TEST(Parallel, ExceptionsPropagate)
+{
+	SNAP_NAMESPACE::thread_pool pool(2);
+	const par::policy pol{ &pool, {}, 10 };
+
+	std::vector<int> v(10000);
+	std::iota(v.begin(), v.end(), 0);
+	EXPECT_THROW(par::for_each(pol, SNAP_NAMESPACE::span<int>(v),
+							   [](int x)
+							   {
+								   if (x == 5000) { throw std::runtime_error("boom"); }
+							   }),
+				 std::runtime_error);
+}
+
+TEST(Parallel, StopTokenCancelsRemainingChunks)
+{
+	SNAP_NAMESPACE::thread_pool pool(2);
+	SNAP_NAMESPACE::stop_source source;
+	const par::policy pol{ &pool, source.get_token(), 1 };
+
+	std::vector<int> v(100000);
+	std::atomic<std::size_t> visited{ 0 };
+	EXPECT_THROW(par::for_each(pol, SNAP_NAMESPACE::span<int>(v),
+							   [&](int&)
+							   {
+								   if (visited.fetch_add(1) == 100) { source.request_stop(); }
+							   }),
+				 par::operation_cancelled);
+	EXPECT_LT(visited.load(), v.size());
+
+	// Already stopped: nothing runs.
+	visited = 0;
+	EXPECT_THROW(par::for_each(pol, SNAP_NAMESPACE::span<int>(v), [&](int&) { visited.fetch_add(1); }), par::operation_cancelled);
+	EXPECT_EQ(visited.load(), 0u);
+}
+
+TEST(Parallel, NestedCallsFromPoolWorkersComplete)
+{
+	SNAP_NAMESPACE::thread_pool pool(1);
+	const par::policy pol{ &pool, {}, 8 };
+
+	std::vector<int> v(1000, 1);
+	auto h = pool.submit([&] { par::for_each(pol, SNAP_NAMESPACE::span<int>(v), [](int& x) { x *= 3; }); });
+	h.wait();
+	EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 3000);
+}
@@ -0,0 +1,114 @@
+#include "snap/atomic/atomic_fetch_max.hpp"
+#include "snap/atomic/sharded_counter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+TEST(AtomicFetchMax, ReturnsPreviousValueAndOnlyRaises)
+{
+	std::atomic<int> value{ 5 };
+
+	EXPECT_EQ(SNAP_NAMESPACE::atomic_fetch_max(&value, 3), 5);
+	EXPECT_EQ(value.load(), 5);
+
+	EXPECT_EQ(SNAP_NAMESPACE::atomic_fetch_max(&value, 9), 5);
+	EXPECT_EQ(value.load(), 9);
+}
+
+TEST(AtomicFetchMax, FetchMinOnlyLowers)
+{
+	std::atomic<std::int64_t> value{ 10 };
+
+	EXPECT_EQ(SNAP_NAMESPACE::atomic_fetch_min_explicit(&value, std::int64_t{ 20 }, std::memory_order_acq_rel), 10);
+	EXPECT_EQ(value.load(), 10);
+
+	EXPECT_EQ(SNAP_NAMESPACE::atomic_fetch_min_explicit(&value, std::int64_t{ -4 }, std::memory_order_relaxed), 10);
+	EXPECT_EQ(value.load(), -4);
+}
+
+TEST(AtomicFetchMax, PointersUseTotalOrder)
+{
+	int storage[4]{};
+	std::atomic<int*> ptr{ &storage[1] };
+
+	SNAP_NAMESPACE::atomic_fetch_max(&ptr, &storage[3]);
+	EXPECT_EQ(ptr.load(), &storage[3]);
+
+	SNAP_NAMESPACE::atomic_fetch_min(&ptr, &storage[0]);
+	EXPECT_EQ(ptr.load(), &storage[0]);
+}
+
+TEST(ShardedCounter, ShardCountIsPowerOfTwo)
+{
+	SNAP_NAMESPACE::sharded_counter<long> counter(5);
+	EXPECT_EQ(counter.shard_count(), 8u);
+
+	SNAP_NAMESPACE::sharded_counter<long> single(0);
+	EXPECT_EQ(single.shard_count(), 1u);
+}
+
+TEST(ShardedCounter, AggregatesConcurrentIncrements)
+{
+	constexpr int thread_count = 4;
+	constexpr int iterations   = 10000;
+
+	SNAP_NAMESPACE::sharded_counter<std::uint64_t> counter;
+
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count);
+	for (int t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back(
+			[&]
+			{
+				for (int i = 0; i < iterations; ++i) { ++counter; }
+				counter += 2;
+				counter -= 2;
+			});
+	}
+	for (auto& th : threads) { th.join(); }
+
+	EXPECT_EQ(counter.load(), static_cast<std::uint64_t>(thread_count) * iterations);
+
+	counter.reset();
+	EXPECT_EQ(counter.load(), 0u);
+}
+
+TEST(ShardedCounter, TracksExtremaPerSlot)
+{
+	SNAP_NAMESPACE::sharded_counter<int> high;
+	high.reset(std::numeric_limits<int>::lowest());
+	high.update_max(-7);
+	high.update_max(-3);
+	high.update_max(-11);
+	EXPECT_EQ(high.load_max(), -3);
+
+	SNAP_NAMESPACE::sharded_counter<int> low;
+	low.reset(std::numeric_limits<int>::max());
+	low.update_min(42);
+	low.update_min(17);
+	EXPECT_EQ(low.load_min(), 17);
+}
+
+TEST(ShardedCounter, ExtremumCountersStartAtTheIdentity)
+{
+	SNAP_NAMESPACE::sharded_counter<unsigned> low(4, std::numeric_limits<unsigned>::max());
+	EXPECT_EQ(low.load_min(), std::numeric_limits<unsigned>::max());
+	low.update_min(42u);
+	low.update_min(17u);
+	EXPECT_EQ(low.load_min(), 17u);
+
+	SNAP_NAMESPACE::sharded_counter<long> high(SNAP_NAMESPACE::sharded_counter<long>::default_shard_count(), std::numeric_limits<long>::lowest());
+	high.update_max(-9L);
+	high.update_max(-4L);
+	EXPECT_EQ(high.load_max(), -4L);
+
+	// A plain counter starts at 0 in every slot, which is what load_max() reports before any update.
+	const SNAP_NAMESPACE::sharded_counter<int> fresh(4);
+	EXPECT_EQ(fresh.load_max(), 0);
+}
@@ -0,0 +1,160 @@
+#include "snap/execution.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+namespace ex = SNAP_NAMESPACE::execution;
+
+namespace
+{
+	// Completes with set_stopped if its token is stopped before start, otherwise never completes until stopped.
+	struct wait_for_stop_sender
+	{
+		using value_types					= SNAP_NAMESPACE::type_list<>;
+		static constexpr bool sends_stopped = true;
+
+		template <class Receiver> struct op
+		{
+			struct on_stop
+			{
+				op* self;
+
+				void operator()() const noexcept { ex::set_stopped(std::move(self->rcvr)); }
+			};
+
+			using token_t = ex::receiver_token_t<Receiver>;
+
+			Receiver rcvr;
+			std::optional<ex::stop_callback_for_t<token_t, on_stop>> callback{};
+
+			void start() & noexcept { callback.emplace(ex::get_stop_token(ex::get_env(rcvr)), on_stop{ this }); }
+		};
+
+		template <class Receiver> op<Receiver> connect(Receiver rcvr) && { return { std::move(rcvr) }; }
+	};
+} // namespace
+
+TEST(Execution, JustThenSyncWait)
+{
+	auto result = ex::sync_wait(ex::just(20, 1) | ex::then([](int a, int b) { return a * 2 + b; }));
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(std::get<0>(*result), 41);
+
+	auto unit = ex::sync_wait(ex::just() | ex::then([] {}));
+	static_assert(std::is_same_v<decltype(unit), std::optional<std::tuple<>>>);
+	EXPECT_TRUE(unit.has_value());
+}
+
+TEST(Execution, ThenExceptionBecomesError)
+{
+	auto sndr = ex::just(1) | ex::then([](int) -> int { throw std::runtime_error("boom"); });
+	EXPECT_THROW(ex::sync_wait(std::move(sndr)), std::runtime_error);
+}
+
+TEST(Execution, LetValueKeepsValuesAlive)
+{
+	auto sndr = ex::just(std::string("snap")) | ex::let_value([](std::string& s) { return ex::just(&s) | ex::then([](std::string* p) { return p->size(); }); });
+	auto result = ex::sync_wait(std::move(sndr));
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(std::get<0>(*result), 4u);
+}
+
+TEST(Execution, WhenAllConcatenatesValues)
+{
+	auto result = ex::sync_wait(ex::when_all(ex::just(1), ex::just(), ex::just(2.5, std::string("x"))));
+	ASSERT_TRUE(result.has_value());
+	static_assert(std::is_same_v<std::decay_t<decltype(*result)>, std::tuple<int, double, std::string>>);
+	EXPECT_EQ(std::get<0>(*result), 1);
+	EXPECT_DOUBLE_EQ(std::get<1>(*result), 2.5);
+	EXPECT_EQ(std::get<2>(*result), "x");
+}
+
+TEST(Execution, WhenAllErrorStopsSiblings)
+{
+	auto failing = ex::just() | ex::then([] { throw std::logic_error("fail"); });
+	EXPECT_THROW(ex::sync_wait(ex::when_all(wait_for_stop_sender{}, std::move(failing))), std::logic_error);
+}
+
+TEST(Execution, TransferRunsOnPool)
+{
+	SNAP_NAMESPACE::thread_pool pool(2);
+	ex::pool_scheduler sched(pool);
+	EXPECT_TRUE(sched == ex::pool_scheduler(pool));
+
+	const auto caller = std::this_thread::get_id();
+	auto result		  = ex::sync_wait(ex::just(7) | ex::transfer(sched) |
+									  ex::then(
+										  [&](int v)
+										  {
+											  EXPECT_NE(std::this_thread::get_id(), caller);
+											  EXPECT_LT(pool.current_worker_index(), pool.size());
+											  return v + 1;
+										  }));
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(std::get<0>(*result), 8);
+}
+
+TEST(Execution, WhenAllOnPoolRunsInParallel)
+{
+	SNAP_NAMESPACE::thread_pool pool(4);
+	ex::pool_scheduler sched(pool);
+
+	std::atomic<int> hits{ 0 };
+	auto work	= [&] { return ex::schedule(sched) | ex::then([&] { return hits.fetch_add(1) >= 0 ? 1 : 0; }); };
+	auto result = ex::sync_wait(ex::when_all(work(), work(), work(), work()) | ex::then([](int a, int b, int c, int d) { return a + b + c + d; }));
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(std::get<0>(*result), 4);
+	EXPECT_EQ(hits.load(), 4);
+}
+
+TEST(Execution, RunLoopSchedulerFromEnvironment)
+{
+	ex::run_loop loop;
+	auto sched = loop.get_scheduler();
+
+	int value = 0;
+	std::thread driver([&] { loop.run(); });
+	auto result = ex::sync_wait(ex::just(5) | ex::transfer(sched) | ex::then([&](int v) { return value = v; }));
+	loop.finish();
+	driver.join();
+
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(value, 5);
+}
+
+TEST(Execution, StopTokenFromEnvironmentIsHonoured)
+{
+	SNAP_NAMESPACE::inplace_stop_source source;
+	source.request_stop();
+
+	struct receiver
+	{
+		SNAP_NAMESPACE::inplace_stop_token token;
+		int* outcome;
+
+		void set_value() && noexcept { *outcome = 1; }
+		void set_error(std::exception_ptr) && noexcept { *outcome = 2; }
+		void set_stopped() && noexcept { *outcome = 3; }
+		[[nodiscard]] ex::stop_token_env<SNAP_NAMESPACE::inplace_stop_token> get_env() const noexcept { return { token }; }
+	};
+
+	int outcome = 0;
+	auto op		= ex::connect(ex::when_all(ex::just()), receiver{ source.get_token(), &outcome });
+	ex::start(op);
+	EXPECT_EQ(outcome, 3);
+
+	ex::run_loop loop;
+	int scheduled = 0;
+	auto op2	  = ex::connect(ex::schedule(loop.get_scheduler()), receiver{ source.get_token(), &scheduled });
+	ex::start(op2);
+	loop.finish();
+	loop.run();
+	EXPECT_EQ(scheduled, 3);
+}
@@ -0,0 +1,193 @@
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/flat_map.hpp"
+#include "snap/inplace_vector.hpp"
+#include "snap/testing/assertions.hpp"
+
+#include <functional>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	template <class Map> std::vector<std::pair<int, int>> entries_of(const Map& map)
+	{
+		std::vector<std::pair<int, int>> result;
+		for (const auto& [key, value] : map) { result.emplace_back(key, value); }
+		return result;
+	}
+
+	// Outside namespace snap, so erase_if can only be found by argument dependent lookup.
+	template <class Map, class Pred> std::size_t erase_if_by_adl(Map& map, Pred pred)
+	{
+		return erase_if(map, pred);
+	}
+} // namespace
+
+SNAP_BEGIN_NAMESPACE
+namespace test_cases
+{
+	TEST(FlatMap, InsertLookupAndErase)
+	{
+		SNAP_NAMESPACE::flat_map<int, int> map;
+		EXPECT_TRUE(map.emplace(3, 30).second);
+		EXPECT_TRUE(map.insert({ 1, 10 }).second);
+		EXPECT_FALSE(map.try_emplace(3, 99).second);
+		map[2] = 20;
+		EXPECT_FALSE(map.insert_or_assign(1, 11).second);
+
+		EXPECT_EQ((std::vector<std::pair<int, int>>{ { 1, 11 }, { 2, 20 }, { 3, 30 } }), entries_of(map));
+		SNAP_NAMESPACE::test::ExpectRangeEq(map.keys(), std::vector<int>{ 1, 2, 3 });
+		EXPECT_EQ(30, map.at(3));
+		EXPECT_THROW(map.at(4), std::out_of_range);
+		EXPECT_TRUE(map.contains(2));
+		EXPECT_EQ(map.end(), map.find(4));
+		EXPECT_EQ(2, map.lower_bound(2)->first);
+		EXPECT_EQ(3, (*map.upper_bound(2)).first);
+
+		map.find(2)->second = 21;
+		EXPECT_EQ(21, map[2]);
+
+		EXPECT_EQ(1U, map.erase(2));
+		EXPECT_EQ(0U, map.erase(2));
+		auto next = map.erase(map.begin());
+		EXPECT_EQ(3, next->first);
+		EXPECT_EQ(1U, map.size());
+	}
+
+	TEST(FlatMap, BulkInsertSortsAndMergesOnce)
+	{
+		SNAP_NAMESPACE::flat_map<int, int> map{ { 5, 50 }, { 1, 10 }, { 5, 51 }, { 3, 30 } };
+		EXPECT_EQ((std::vector<std::pair<int, int>>{ { 1, 10 }, { 3, 30 }, { 5, 50 } }), entries_of(map));
+
+		// existing keys win, duplicates in the input keep their first occurrence
+		const std::list<std::pair<int, int>> more{ { 4, 40 }, { 3, 31 }, { 0, 0 }, { 4, 41 }, { 9, 90 } };
+		map.insert(more.begin(), more.end());
+		EXPECT_EQ((std::vector<std::pair<int, int>>{ { 0, 0 }, { 1, 10 }, { 3, 30 }, { 4, 40 }, { 5, 50 }, { 9, 90 } }), entries_of(map));
+
+		map.insert(SNAP_NAMESPACE::sorted_unique, { { 10, 100 }, { 11, 110 } });
+		EXPECT_EQ(8U, map.size());
+		EXPECT_EQ(110, map.at(11));
+
+		SNAP_NAMESPACE::flat_map<int, int> adopted(SNAP_NAMESPACE::sorted_unique, std::vector<int>{ 1, 2 }, std::vector<int>{ 10, 20 });
+		EXPECT_EQ(20, adopted.at(2));
+
+		SNAP_NAMESPACE::flat_map<int, int> from_containers(std::vector<int>{ 2, 1, 2 }, std::vector<int>{ 20, 10, 21 });
+		EXPECT_EQ((std::vector<std::pair<int, int>>{ { 1, 10 }, { 2, 20 } }), entries_of(from_containers));
+
+		EXPECT_EQ(3U, SNAP_NAMESPACE::erase_if(map, [](const auto& entry) { return entry.first % 2 == 0; }));
+		SNAP_NAMESPACE::test::ExpectRangeEq(map.keys(), std::vector<int>{ 1, 3, 5, 9, 11 });
+		SNAP_NAMESPACE::test::ExpectRangeEq(map.values(), std::vector<int>{ 10, 30, 50, 90, 110 });
+	}
+
+	TEST(FlatMap, DeductionGuidesAndArgumentDependentLookup)
+	{
+		SNAP_NAMESPACE::flat_map from_containers(std::vector<int>{ 2, 1 }, std::vector<std::string>{ "b", "a" });
+		static_assert(std::is_same_v<decltype(from_containers), SNAP_NAMESPACE::flat_map<int, std::string>>);
+		EXPECT_EQ("a", from_containers.at(1));
+
+		const std::map<int, int> source{ { 3, 30 }, { 1, 10 } };
+		SNAP_NAMESPACE::flat_map from_range(source.begin(), source.end());
+		static_assert(std::is_same_v<decltype(from_range), SNAP_NAMESPACE::flat_map<int, int>>);
+		EXPECT_EQ((std::vector<std::pair<int, int>>{ { 1, 10 }, { 3, 30 } }), entries_of(from_range));
+
+		SNAP_NAMESPACE::flat_map from_list({ std::pair{ 2, 2.5 }, std::pair{ 1, 1.5 } }, std::greater<int>());
+		static_assert(std::is_same_v<decltype(from_list), SNAP_NAMESPACE::flat_map<int, double, std::greater<int>>>);
+		EXPECT_EQ(2, from_list.begin()->first);
+
+		SNAP_NAMESPACE::flat_multimap sorted(SNAP_NAMESPACE::sorted_equivalent, std::vector<int>{ 1, 1, 2 }, std::vector<int>{ 10, 11, 20 });
+		static_assert(std::is_same_v<decltype(sorted), SNAP_NAMESPACE::flat_multimap<int, int>>);
+		EXPECT_EQ(2U, sorted.count(1));
+
+		EXPECT_EQ(1U, erase_if_by_adl(from_range, [](const auto& entry) { return entry.first == 3; }));
+		EXPECT_EQ(2U, erase_if_by_adl(sorted, [](const auto& entry) { return entry.first == 1; }));
+		EXPECT_EQ(1U, sorted.size());
+	}
+
+	TEST(FlatMap, MultimapKeepsEquivalentKeysInOrder)
+	{
+		SNAP_NAMESPACE::flat_multimap<int, int> map{ { 2, 20 }, { 1, 10 }, { 2, 21 } };
+		map.emplace(2, 22);
+		map.insert({ { 0, 0 }, { 2, 23 } });
+		EXPECT_EQ((std::vector<std::pair<int, int>>{ { 0, 0 }, { 1, 10 }, { 2, 20 }, { 2, 21 }, { 2, 22 }, { 2, 23 } }), entries_of(map));
+
+		EXPECT_EQ(4U, map.count(2));
+		const auto range = map.equal_range(2);
+		EXPECT_EQ(4, std::distance(range.first, range.second));
+		EXPECT_EQ(4U, map.erase(2));
+		EXPECT_EQ(2U, map.size());
+	}
+
+	TEST(FlatMap, TransparentLookupAndMoveOnlyValues)
+	{
+		SNAP_NAMESPACE::flat_map<std::string, std::unique_ptr<int>, std::less<>> map;
+		map.try_emplace("beta", std::make_unique<int>(2));
+		map.try_emplace("alpha", std::make_unique<int>(1));
+
+		const std::string_view key = "beta";
+		EXPECT_TRUE(map.contains(key));
+		EXPECT_EQ(2, *map.find(key)->second);
+		EXPECT_EQ(1, *map.at(std::string_view("alpha")));
+		EXPECT_EQ(1U, map.erase(key));
+
+		auto containers = std::move(map).extract();
+		EXPECT_TRUE(map.empty());
+		EXPECT_EQ(1U, containers.keys.size());
+	}
+
+	TEST(FlatMap, InlineStorageAndSearchPolicies)
+	{
+		using inline_map = SNAP_NAMESPACE::flat_map<int,
+													int,
+													std::less<int>,
+													SNAP_NAMESPACE::inplace_vector<int, 64>,
+													SNAP_NAMESPACE::inplace_vector<int, 64>,
+													SNAP_NAMESPACE::eytzinger_search>;
+		using binary_map = SNAP_NAMESPACE::flat_map<int,
+													int,
+													std::less<int>,
+													SNAP_NAMESPACE::inplace_vector<int, 64>,
+													SNAP_NAMESPACE::inplace_vector<int, 64>,
+													SNAP_NAMESPACE::branchless_search<0>>;
+
+		inline_map eytzinger;
+		binary_map binary;
+		SNAP_NAMESPACE::flat_map<int, int> linear;
+		for (int i = 0; i < 40; ++i)
+		{
+			const int key = (i * 7) % 40 * 2; // even keys 0..78 in scrambled order
+			eytzinger.emplace(key, i);
+			binary.emplace(key, i);
+			if (i < 16) linear.emplace(key, i);
+		}
+
+		for (int probe = -1; probe <= 80; ++probe)
+		{
+			EXPECT_EQ(binary.lower_bound(probe) - binary.begin(), eytzinger.lower_bound(probe) - eytzinger.begin()) << probe;
+			EXPECT_EQ(binary.upper_bound(probe) - binary.begin(), eytzinger.upper_bound(probe) - eytzinger.begin()) << probe;
+			EXPECT_EQ(binary.contains(probe), eytzinger.contains(probe)) << probe;
+			const auto expected = std::lower_bound(linear.keys().begin(), linear.keys().end(), probe) - linear.keys().begin();
+			EXPECT_EQ(expected, linear.lower_bound(probe) - linear.begin()) << probe;
+		}
+
+		eytzinger.erase(eytzinger.begin(), eytzinger.begin() + 10);
+		EXPECT_EQ(20, eytzinger.begin()->first);
+		EXPECT_EQ(eytzinger.end(), eytzinger.find(18));
+		EXPECT_EQ(78, eytzinger.find(78)->first);
+
+		inline_map copy = eytzinger;
+		EXPECT_TRUE(copy == eytzinger);
+		copy[5] = 0;
+		EXPECT_TRUE(copy < eytzinger);
+	}
+} // namespace test_cases
+SNAP_END_NAMESPACE
@@ -0,0 +1,105 @@
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/flat_set.hpp"
+#include "snap/inplace_vector.hpp"
+#include "snap/testing/assertions.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+	// Outside namespace snap, so erase_if can only be found by argument dependent lookup.
+	template <class Set, class Pred> std::size_t erase_if_by_adl(Set& set, Pred pred)
+	{
+		return erase_if(set, pred);
+	}
+} // namespace
+
+SNAP_BEGIN_NAMESPACE
+namespace test_cases
+{
+	TEST(FlatSet, InsertLookupAndErase)
+	{
+		SNAP_NAMESPACE::flat_set<int> set{ 4, 1, 4, 3 };
+		SNAP_NAMESPACE::test::ExpectRangeEq(set, std::vector<int>{ 1, 3, 4 });
+
+		EXPECT_FALSE(set.insert(3).second);
+		EXPECT_EQ(2, *set.insert(2).first);
+		EXPECT_EQ(1, *set.emplace_hint(set.begin(), 1));
+		EXPECT_EQ(0, *set.insert(set.begin(), 0));
+		SNAP_NAMESPACE::test::ExpectRangeEq(set, std::vector<int>{ 0, 1, 2, 3, 4 });
+
+		EXPECT_TRUE(set.contains(2));
+		EXPECT_EQ(1U, set.erase(2));
+		EXPECT_EQ(set.end(), set.find(2));
+		EXPECT_EQ(3, *set.lower_bound(2));
+
+		const std::deque<int> more{ 9, 7, 3, 7 };
+		set.insert(more.begin(), more.end());
+		SNAP_NAMESPACE::test::ExpectRangeEq(set, std::vector<int>{ 0, 1, 3, 4, 7, 9 });
+
+		EXPECT_EQ(3U, SNAP_NAMESPACE::erase_if(set, [](int v) { return v % 2 == 1 && v > 1; }));
+		SNAP_NAMESPACE::test::ExpectRangeEq(set, std::vector<int>{ 0, 1, 4 });
+	}
+
+	TEST(FlatSet, MultisetAndSortedInput)
+	{
+		SNAP_NAMESPACE::flat_multiset<int> set{ 2, 1, 2 };
+		set.insert(2);
+		set.insert(SNAP_NAMESPACE::sorted_equivalent, { 3, 3 });
+		SNAP_NAMESPACE::test::ExpectRangeEq(set, std::vector<int>{ 1, 2, 2, 2, 3, 3 });
+		EXPECT_EQ(3U, set.count(2));
+		EXPECT_EQ(2U, set.erase(3));
+
+		SNAP_NAMESPACE::flat_set<int> sorted(SNAP_NAMESPACE::sorted_unique, std::vector<int>{ 1, 5, 8 });
+		sorted.insert(SNAP_NAMESPACE::sorted_unique, { 2, 9 });
+		SNAP_NAMESPACE::test::ExpectRangeEq(sorted, std::vector<int>{ 1, 2, 5, 8, 9 });
+	}
+
+	TEST(FlatSet, DeductionGuidesAndArgumentDependentLookup)
+	{
+		SNAP_NAMESPACE::flat_set from_container(std::deque<int>{ 3, 1, 3 });
+		static_assert(std::is_same_v<decltype(from_container), SNAP_NAMESPACE::flat_set<int, std::less<int>, std::deque<int>>>);
+		SNAP_NAMESPACE::test::ExpectRangeEq(from_container, std::vector<int>{ 1, 3 });
+
+		const std::vector<std::string> words{ "b", "a", "b" };
+		SNAP_NAMESPACE::flat_multiset from_range(words.begin(), words.end());
+		static_assert(std::is_same_v<decltype(from_range), SNAP_NAMESPACE::flat_multiset<std::string>>);
+		EXPECT_EQ(2U, from_range.count("b"));
+
+		SNAP_NAMESPACE::flat_set from_list{ 5, 2, 7 };
+		static_assert(std::is_same_v<decltype(from_list), SNAP_NAMESPACE::flat_set<int>>);
+
+		SNAP_NAMESPACE::flat_set sorted(SNAP_NAMESPACE::sorted_unique, { 1, 4 }, std::greater<int>());
+		static_assert(std::is_same_v<decltype(sorted), SNAP_NAMESPACE::flat_set<int, std::greater<int>>>);
+
+		EXPECT_EQ(2U, erase_if_by_adl(from_list, [](int v) { return v > 3; }));
+		EXPECT_EQ(2U, erase_if_by_adl(from_range, [](const std::string& v) { return v == "b"; }));
+		SNAP_NAMESPACE::test::ExpectRangeEq(from_list, std::vector<int>{ 2 });
+	}
+
+	TEST(FlatSet, InlineStorageWithEytzingerSearch)
+	{
+		using inline_set = SNAP_NAMESPACE::flat_set<std::string, std::less<>, SNAP_NAMESPACE::inplace_vector<std::string, 8>, SNAP_NAMESPACE::eytzinger_search>;
+		inline_set set{ "delta", "alpha", "charlie", "bravo", "echo" };
+		EXPECT_EQ("alpha", *set.begin());
+		EXPECT_TRUE(set.contains(std::string_view("charlie")));
+		EXPECT_FALSE(set.contains(std::string_view("foxtrot")));
+		EXPECT_EQ("delta", *set.upper_bound(std::string_view("charlie")));
+
+		set.erase(std::string_view("alpha"));
+		EXPECT_EQ(set.end(), set.find(std::string_view("alpha")));
+		EXPECT_EQ("bravo", *set.find(std::string_view("bravo")));
+
+		auto keys = std::move(set).extract();
+		EXPECT_EQ(4U, keys.size());
+	}
+} // namespace test_cases
+SNAP_END_NAMESPACE
@@ -0,0 +1,193 @@
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/hive.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+SNAP_BEGIN_NAMESPACE
+namespace test_cases
+{
+	namespace
+	{
+		template <class Hive> std::vector<int> sorted_values(const Hive& h)
+		{
+			std::vector<int> values(h.begin(), h.end());
+			std::sort(values.begin(), values.end());
+			return values;
+		}
+
+		struct counted
+		{
+			static inline int alive = 0;
+
+			explicit counted(int v) : value(v) { ++alive; }
+			counted(const counted& other) : value(other.value) { ++alive; }
+			~counted() { --alive; }
+
+			int value;
+		};
+	} // namespace
+
+	TEST(Hive, InsertEraseAndIterate)
+	{
+		SNAP_NAMESPACE::hive<int> h{ 1, 2, 3, 4, 5 };
+		EXPECT_EQ(5U, h.size());
+		EXPECT_EQ((std::vector<int>{ 1, 2, 3, 4, 5 }), sorted_values(h));
+
+		auto it = std::find(h.begin(), h.end(), 3);
+		ASSERT_NE(h.end(), it);
+		it = h.erase(it);
+		EXPECT_EQ(4, *it);
+		EXPECT_EQ((std::vector<int>{ 1, 2, 4, 5 }), sorted_values(h));
+
+		// erased slots are reused before the hive grows
+		const auto capacity = h.capacity();
+		EXPECT_EQ(7, *h.insert(7));
+		EXPECT_EQ(capacity, h.capacity());
+		EXPECT_EQ((std::vector<int>{ 1, 2, 4, 5, 7 }), sorted_values(h));
+
+		EXPECT_EQ(5U, static_cast<std::size_t>(std::distance(h.begin(), h.end())));
+		EXPECT_EQ(5U, static_cast<std::size_t>(std::distance(h.rbegin(), h.rend())));
+
+		h.clear();
+		EXPECT_TRUE(h.empty());
+		EXPECT_EQ(h.begin(), h.end());
+	}
+
+	TEST(Hive, PointersStayValidAcrossInsertAndErase)
+	{
+		SNAP_NAMESPACE::hive<int> h(SNAP_NAMESPACE::hive_limits(4, 16));
+		std::vector<int*> pointers;
+		for (int i = 0; i < 100; ++i) pointers.push_back(&*h.insert(i));
+
+		for (int i = 0; i < 100; i += 2) h.erase(h.get_iterator(pointers[static_cast<std::size_t>(i)]));
+		for (int i = 0; i < 1000; ++i) h.insert(-1);
+		for (int i = 1; i < 100; i += 2) EXPECT_EQ(i, *pointers[static_cast<std::size_t>(i)]);
+
+		EXPECT_EQ(h.end(), h.get_iterator(nullptr));
+		int outside = 0;
+		EXPECT_EQ(h.end(), h.get_iterator(&outside));
+	}
+
+	TEST(Hive, RandomOperationsMatchReference)
+	{
+		SNAP_NAMESPACE::hive<int> h(SNAP_NAMESPACE::hive_limits(3, 32));
+		std::unordered_map<int, int*> live;
+		std::mt19937 rng(42);
+		int next = 0;
+		for (int step = 0; step < 20000; ++step)
+		{
+			if (live.empty() || rng() % 5 < 3)
+			{
+				int* p = &*h.insert(next);
+				live.emplace(next++, p);
+			}
+			else
+			{
+				auto victim = live.begin();
+				std::advance(victim, static_cast<std::ptrdiff_t>(rng() % live.size()));
+				auto it = h.get_iterator(victim->second);
+				ASSERT_NE(h.end(), it);
+				h.erase(it);
+				live.erase(victim);
+			}
+			if (step % 997 == 0)
+			{
+				ASSERT_EQ(live.size(), h.size());
+				std::vector<int> expected;
+				for (const auto& entry : live) expected.push_back(entry.first);
+				std::sort(expected.begin(), expected.end());
+				ASSERT_EQ(expected, sorted_values(h));
+
+				std::vector<int> backwards;
+				for (auto it = h.end(); it != h.begin();) backwards.push_back(*--it);
+				std::reverse(backwards.begin(), backwards.end());
+				ASSERT_EQ(std::vector<int>(h.begin(), h.end()), backwards);
+			}
+		}
+		for (const auto& entry : live) EXPECT_EQ(entry.first, *entry.second);
+	}
+
+	TEST(Hive, EraseRangeAndEraseIf)
+	{
+		SNAP_NAMESPACE::hive<int> h(SNAP_NAMESPACE::hive_limits(4, 4));
+		for (int i = 0; i < 20; ++i) h.insert(i);
+
+		EXPECT_EQ(10U, SNAP_NAMESPACE::erase_if(h, [](int v) { return v % 2 == 0; }));
+		EXPECT_EQ((std::vector<int>{ 1, 3, 5, 7, 9, 11, 13, 15, 17, 19 }), sorted_values(h));
+		EXPECT_EQ(1U, SNAP_NAMESPACE::erase(h, 7));
+
+		auto first = h.begin();
+		std::advance(first, 3);
+		EXPECT_EQ(h.end(), h.erase(first, h.end()));
+		EXPECT_EQ(3U, h.size());
+		EXPECT_EQ(h.end(), h.erase(h.begin(), h.end()));
+		EXPECT_TRUE(h.empty());
+
+		// emptied blocks are kept until trimmed
+		EXPECT_GE(h.capacity(), 20U);
+		h.trim_capacity();
+		EXPECT_EQ(0U, h.capacity());
+	}
+
+	TEST(Hive, ReserveCopyMoveAndSplice)
+	{
+		SNAP_NAMESPACE::hive<std::string> a;
+		a.reserve(50);
+		EXPECT_GE(a.capacity(), 50U);
+		const auto capacity = a.capacity();
+		for (int i = 0; i < 50; ++i) a.insert(std::to_string(i));
+		EXPECT_EQ(capacity, a.capacity());
+
+		SNAP_NAMESPACE::hive<std::string> b(a);
+		EXPECT_EQ(a, b);
+
+		std::string* p = &*a.begin();
+		SNAP_NAMESPACE::hive<std::string> c(std::move(a));
+		EXPECT_TRUE(a.empty()); // NOLINT(bugprone-use-after-move)
+		EXPECT_EQ(p, &*c.begin());
+
+		b.splice(c);
+		EXPECT_EQ(100U, b.size());
+		EXPECT_TRUE(c.empty());
+		EXPECT_NE(b.end(), b.get_iterator(p));
+
+		c = b;
+		EXPECT_EQ(b, c);
+		b = std::move(c);
+		EXPECT_EQ(100U, b.size());
+	}
+
+	TEST(Hive, DestroysEveryElement)
+	{
+		{
+			SNAP_NAMESPACE::hive<counted> h;
+			for (int i = 0; i < 100; ++i) h.emplace(i);
+			for (auto it = h.begin(); it != h.end();) it = it->value % 3 == 0 ? h.erase(it) : std::next(it);
+			EXPECT_EQ(static_cast<int>(h.size()), counted::alive);
+			SNAP_NAMESPACE::hive<counted> copy(h);
+			EXPECT_EQ(2 * static_cast<int>(h.size()), counted::alive);
+		}
+		EXPECT_EQ(0, counted::alive);
+	}
+
+	TEST(Hive, RejectsInvalidLimits)
+	{
+		EXPECT_THROW(SNAP_NAMESPACE::hive<int>(SNAP_NAMESPACE::hive_limits(10, 5)), std::length_error);
+		EXPECT_THROW(SNAP_NAMESPACE::hive<int>(SNAP_NAMESPACE::hive_limits(0, 5)), std::length_error);
+		EXPECT_THROW(SNAP_NAMESPACE::hive<int>(SNAP_NAMESPACE::hive_limits(1, 1U << 20)), std::length_error);
+		const SNAP_NAMESPACE::hive<int> h(SNAP_NAMESPACE::hive_limits(2, 100));
+		EXPECT_EQ(2U, h.block_capacity_limits().min);
+		EXPECT_EQ(100U, h.block_capacity_limits().max);
+	}
+} // namespace test_cases
+SNAP_END_NAMESPACE
@@ -5,14 +5,23 @@
 #include "snap/internal/abi_namespace.hpp"
 
 #include "snap/inplace_vector.hpp"
+#include "snap/span.hpp"
 #include "snap/testing/assertions.hpp"
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
+#include <list>
+#include <memory>
 #include <new>
+#include <sstream>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace
@@ -142,6 +151,19 @@ namespace test_cases
 		EXPECT_EQ(4U, values.capacity());
 	}
 
+	TEST(InplaceVector, ValueInitializationLeavesStorageUntouched)
+	{
+		using vector = SNAP_NAMESPACE::inplace_vector<std::uint32_t, 64>;
+		alignas(vector) unsigned char buffer[sizeof(vector)];
+		std::memset(buffer, 0xA5, sizeof(buffer));
+
+		vector* values = ::new (static_cast<void*>(buffer)) vector();
+		EXPECT_TRUE(values->empty());
+		// the elements come first; only the size counter after them is written
+		for (std::size_t i = 0; i < 64 * sizeof(std::uint32_t); ++i) ASSERT_EQ(0xA5, buffer[i]) << "byte " << i;
+		values->~vector();
+	}
+
 	TEST(InplaceVector, PushBackPopBackAndIterators)
 	{
 		SNAP_NAMESPACE::inplace_vector<int, 4> values;
@@ -256,5 +278,185 @@ namespace test_cases
 		EXPECT_EQ(Tracking::constructions, Tracking::destructions);
 	}
 
+	TEST(InplaceVector, TriviallyCopyableCopyMoveAndSwap)
+	{
+		static_assert(std::is_trivially_destructible_v<SNAP_NAMESPACE::inplace_vector<int, 4>>);
+		static_assert(!std::is_trivially_destructible_v<SNAP_NAMESPACE::inplace_vector<Tracking, 4>>);
+
+		SNAP_NAMESPACE::inplace_vector<int, 8> a{ 1, 2, 3, 4, 5 };
+		SNAP_NAMESPACE::inplace_vector<int, 8> b(a);
+		SNAP_NAMESPACE::test::ExpectRangeEq(b, std::vector<int>{ 1, 2, 3, 4, 5 });
+
+		SNAP_NAMESPACE::inplace_vector<int, 8> c(std::move(b));
+		SNAP_NAMESPACE::test::ExpectRangeEq(c, std::vector<int>{ 1, 2, 3, 4, 5 });
+
+		SNAP_NAMESPACE::inplace_vector<int, 8> d{ 9, 8 };
+		d = a;
+		SNAP_NAMESPACE::test::ExpectRangeEq(d, std::vector<int>{ 1, 2, 3, 4, 5 });
+		d = SNAP_NAMESPACE::inplace_vector<int, 8>{ 7 };
+		SNAP_NAMESPACE::test::ExpectRangeEq(d, std::vector<int>{ 7 });
+
+		d.swap(a);
+		SNAP_NAMESPACE::test::ExpectRangeEq(a, std::vector<int>{ 7 });
+		SNAP_NAMESPACE::test::ExpectRangeEq(d, std::vector<int>{ 1, 2, 3, 4, 5 });
+		swap(a, d);
+		SNAP_NAMESPACE::test::ExpectRangeEq(a, std::vector<int>{ 1, 2, 3, 4, 5 });
+		SNAP_NAMESPACE::test::ExpectRangeEq(d, std::vector<int>{ 7 });
+	}
+
+	TEST(InplaceVector, NonTrivialSwapOfUnequalSizes)
+	{
+		Tracking::reset();
+		{
+			SNAP_NAMESPACE::inplace_vector<Tracking, 4> a;
+			a.emplace_back(1);
+			SNAP_NAMESPACE::inplace_vector<Tracking, 4> b;
+			b.emplace_back(2);
+			b.emplace_back(3);
+			b.emplace_back(4);
+
+			a.swap(b);
+			SNAP_NAMESPACE::test::ExpectRangeEq(values_of(a), std::vector<int>{ 2, 3, 4 });
+			SNAP_NAMESPACE::test::ExpectRangeEq(values_of(b), std::vector<int>{ 1 });
+
+			a = b;
+			SNAP_NAMESPACE::test::ExpectRangeEq(values_of(a), std::vector<int>{ 1 });
+			EXPECT_EQ(2, Tracking::alive);
+		}
+		EXPECT_EQ(0, Tracking::alive);
+	}
+
+	TEST(InplaceVector, BulkRangeOperations)
+	{
+		const int raw[] = { 1, 2, 3, 4 };
+		const SNAP_NAMESPACE::span<const int> packet(raw);
+
+		SNAP_NAMESPACE::inplace_vector<int, 10> values(packet);
+		values.append_range(packet);
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 1, 2, 3, 4, 1, 2, 3, 4 });
+
+		// overflow is detected before anything is written
+		EXPECT_THROW(values.append_range(packet), std::bad_alloc);
+		EXPECT_EQ(8U, values.size());
+
+		const std::deque<int> middle{ 7, 8 };
+		auto* it = values.insert_range(std::next(values.begin(), 2), middle);
+		EXPECT_EQ(std::next(values.begin(), 2), it);
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 1, 2, 7, 8, 3, 4, 1, 2, 3, 4 });
+
+		values.assign_range(std::list<int>{ 5, 6 });
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 5, 6 });
+
+		const std::vector<int> many(12, 9);
+		auto rest = values.try_append_range(many);
+		EXPECT_EQ(std::next(many.begin(), 8), rest);
+		EXPECT_EQ(10U, values.size());
+		EXPECT_EQ(9, values.back());
+
+		std::istringstream in("10 20 30");
+		SNAP_NAMESPACE::inplace_vector<int, 5> parsed{ 1, 2 };
+		parsed.insert(std::next(parsed.begin()), std::istream_iterator<int>(in), std::istream_iterator<int>());
+		SNAP_NAMESPACE::test::ExpectRangeEq(parsed, std::vector<int>{ 1, 10, 20, 30, 2 });
+	}
+
+	TEST(InplaceVector, BulkInsertOfNonTrivialElements)
+	{
+		Tracking::reset();
+		{
+			SNAP_NAMESPACE::inplace_vector<Tracking, 6> values;
+			values.emplace_back(1);
+			values.emplace_back(4);
+
+			std::vector<Tracking> source;
+			source.emplace_back(2);
+			source.emplace_back(3);
+			values.insert(std::next(values.begin()), source.begin(), source.end());
+			SNAP_NAMESPACE::test::ExpectRangeEq(values_of(values), std::vector<int>{ 1, 2, 3, 4 });
+
+			const std::vector<Tracking> too_many(3);
+			EXPECT_THROW(values.insert_range(values.begin(), too_many), std::bad_alloc);
+			EXPECT_EQ(4U, values.size());
+		}
+		EXPECT_EQ(0, Tracking::alive);
+	}
+
+	TEST(InplaceVector, RelocatesUniquePtrElements)
+	{
+		static_assert(SNAP_NAMESPACE::is_trivially_relocatable_v<SNAP_NAMESPACE::inplace_vector<std::unique_ptr<int>, 4>>);
+
+		SNAP_NAMESPACE::inplace_vector<std::unique_ptr<int>, 6> values;
+		for (int i = 0; i < 4; ++i) { values.push_back(std::make_unique<int>(i)); }
+		const int* owned = values[1].get();
+
+		values.erase(values.begin());
+		values.emplace(values.begin() + 1, std::make_unique<int>(9));
+		values.insert(values.begin(), std::make_unique<int>(8));
+		EXPECT_EQ(owned, values[1].get());
+
+		std::vector<int> seen;
+		for (const auto& p : values) { seen.push_back(*p); }
+		SNAP_NAMESPACE::test::ExpectRangeEq(seen, std::vector<int>{ 8, 1, 9, 2, 3 });
+
+		SNAP_NAMESPACE::inplace_vector<std::unique_ptr<int>, 6> moved(std::move(values));
+		EXPECT_TRUE(values.empty());
+		EXPECT_EQ(owned, moved[1].get());
+
+		values.push_back(std::make_unique<int>(5));
+		values.swap(moved);
+		EXPECT_EQ(5U, values.size());
+		EXPECT_EQ(1U, moved.size());
+		EXPECT_EQ(owned, values[1].get());
+	}
+
+	TEST(InplaceVector, ShiftingNonRelocatableElementsKeepsLifetimesBalanced)
+	{
+		Tracking::reset();
+		{
+			SNAP_NAMESPACE::inplace_vector<Tracking, 8> values;
+			for (int i = 0; i < 5; ++i) { values.emplace_back(i); }
+
+			values.erase(values.begin() + 1, values.begin() + 3);
+			EXPECT_EQ(3, Tracking::alive);
+			values.insert(values.begin() + 1, 2, values[2]);
+			values.emplace(values.begin(), values.back());
+			SNAP_NAMESPACE::test::ExpectRangeEq(values_of(values), std::vector<int>{ 4, 0, 4, 4, 3, 4 });
+			EXPECT_EQ(6, Tracking::alive);
+		}
+		EXPECT_EQ(0, Tracking::alive);
+		EXPECT_EQ(Tracking::constructions, Tracking::destructions);
+	}
+
+	TEST(InplaceVector, SizeCounterFitsTheCapacity)
+	{
+		static_assert(sizeof(SNAP_NAMESPACE::inplace_vector<char, 15>) == 16);
+		static_assert(sizeof(SNAP_NAMESPACE::inplace_vector<std::uint32_t, 3>) == 16);
+		static_assert(sizeof(SNAP_NAMESPACE::inplace_vector<char, 300>) == 302);
+		static_assert(sizeof(SNAP_NAMESPACE::inplace_vector<std::uint64_t, 2>) == 24);
+
+		SNAP_NAMESPACE::inplace_vector<char, 255> bytes(255, 'x');
+		EXPECT_EQ(255U, bytes.size());
+		bytes.pop_back();
+		bytes.push_back('y');
+		EXPECT_EQ(255U, bytes.size());
+		EXPECT_EQ('y', bytes.back());
+
+		SNAP_NAMESPACE::inplace_vector<char, 300> more(256, 'z');
+		EXPECT_EQ(256U, more.size());
+	}
+
+#if SNAP_HAS_CPP20
+	constexpr int constexpr_sum()
+	{
+		SNAP_NAMESPACE::inplace_vector<int, 4> values{ 1, 2 };
+		values.push_back(3);
+		SNAP_NAMESPACE::inplace_vector<int, 4> copy = values;
+		copy.emplace_back(4);
+		int sum = 0;
+		for (const int v : copy) { sum += v; }
+		return sum;
+	}
+	static_assert(constexpr_sum() == 10);
+#endif
+
 } // namespace test_cases
 SNAP_END_NAMESPACE
@@ -0,0 +1,139 @@
+#include "snap/memory/hazard_pointer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct tracked : SNAP_NAMESPACE::hazard_pointer_obj_base<tracked>
+	{
+		explicit tracked(int v, std::atomic<int>& destroyed) : value(v), destroyed_count(&destroyed) {}
+		~tracked() { destroyed_count->fetch_add(1, std::memory_order_relaxed); }
+
+		int value;
+		std::atomic<int>* destroyed_count;
+	};
+
+	struct counting_deleter
+	{
+		int* calls;
+		template <class T> void operator()(T* p) const noexcept
+		{
+			++*calls;
+			delete p;
+		}
+	};
+
+	struct custom_tracked : SNAP_NAMESPACE::hazard_pointer_obj_base<custom_tracked, counting_deleter>
+	{
+	};
+} // namespace
+
+TEST(HazardPointer, DefaultIsEmptyAndMadeIsNot)
+{
+	SNAP_NAMESPACE::hazard_pointer empty;
+	EXPECT_TRUE(empty.empty());
+
+	auto hp = SNAP_NAMESPACE::make_hazard_pointer();
+	EXPECT_FALSE(hp.empty());
+
+	SNAP_NAMESPACE::hazard_pointer moved(std::move(hp));
+	EXPECT_TRUE(hp.empty()); // NOLINT(bugprone-use-after-move)
+	EXPECT_FALSE(moved.empty());
+
+	swap(moved, empty);
+	EXPECT_TRUE(moved.empty());
+	EXPECT_FALSE(empty.empty());
+}
+
+TEST(HazardPointer, ProtectReturnsCurrentValue)
+{
+	std::atomic<int> destroyed{ 0 };
+	auto* obj = new tracked(7, destroyed);
+	std::atomic<tracked*> src{ obj };
+
+	auto hp			= SNAP_NAMESPACE::make_hazard_pointer();
+	tracked* seen	= hp.protect(src);
+	tracked* expect = obj;
+	EXPECT_EQ(seen, obj);
+	EXPECT_TRUE(hp.try_protect(expect, src));
+	EXPECT_EQ(expect->value, 7);
+
+	hp.reset_protection();
+	src.store(nullptr);
+	obj->retire();
+	SNAP_NAMESPACE::hazard_pointer_cleanup();
+	EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(HazardPointer, ProtectedObjectOutlivesRetire)
+{
+	std::atomic<int> destroyed{ 0 };
+	std::atomic<tracked*> src{ new tracked(1, destroyed) };
+
+	auto hp		   = SNAP_NAMESPACE::make_hazard_pointer();
+	tracked* guard = hp.protect(src);
+
+	src.store(nullptr);
+	guard->retire();
+	SNAP_NAMESPACE::hazard_pointer_cleanup();
+	EXPECT_EQ(destroyed.load(), 0);
+	EXPECT_EQ(guard->value, 1);
+
+	hp.reset_protection();
+	SNAP_NAMESPACE::hazard_pointer_cleanup();
+	EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(HazardPointer, CustomDeleterIsInvoked)
+{
+	int calls = 0;
+	(new custom_tracked())->retire(counting_deleter{ &calls });
+	SNAP_NAMESPACE::hazard_pointer_cleanup();
+	EXPECT_EQ(calls, 1);
+}
+
+TEST(HazardPointer, ConcurrentReadersNeverSeeReclaimedObjects)
+{
+	constexpr int reader_count = 3;
+	constexpr int swaps		   = 5000;
+
+	std::atomic<int> destroyed{ 0 };
+	std::atomic<tracked*> src{ new tracked(0, destroyed) };
+	std::atomic<bool> done{ false };
+	std::atomic<int> bad_reads{ 0 };
+
+	std::vector<std::thread> readers;
+	readers.reserve(reader_count);
+	for (int r = 0; r < reader_count; ++r)
+	{
+		readers.emplace_back(
+			[&]
+			{
+				auto hp = SNAP_NAMESPACE::make_hazard_pointer();
+				while (!done.load(std::memory_order_acquire))
+				{
+					tracked* p = hp.protect(src);
+					if (p->value < 0 || p->value > swaps) { bad_reads.fetch_add(1); }
+					hp.reset_protection();
+				}
+			});
+	}
+
+	for (int i = 1; i <= swaps; ++i)
+	{
+		tracked* old = src.exchange(new tracked(i, destroyed), std::memory_order_acq_rel);
+		old->retire();
+	}
+	done.store(true, std::memory_order_release);
+	for (auto& t : readers) { t.join(); }
+
+	src.exchange(nullptr)->retire();
+	SNAP_NAMESPACE::hazard_pointer_cleanup();
+
+	EXPECT_EQ(bad_reads.load(), 0);
+	EXPECT_EQ(destroyed.load(), swaps + 1);
+}
@@ -0,0 +1,112 @@
+#include "snap/memory/rcu.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct config : SNAP_NAMESPACE::rcu_obj_base<config>
+	{
+		config(int v, std::atomic<int>& destroyed) : value(v), destroyed_count(&destroyed) {}
+		~config() { destroyed_count->fetch_add(1, std::memory_order_relaxed); }
+
+		int value;
+		std::atomic<int>* destroyed_count;
+	};
+} // namespace
+
+TEST(Rcu, CriticalSectionsNestAndWorkWithScopedLock)
+{
+	auto& dom = SNAP_NAMESPACE::rcu_default_domain();
+	{
+		std::scoped_lock outer(dom);
+		EXPECT_TRUE(dom.try_lock());
+		dom.unlock();
+	}
+	SNAP_NAMESPACE::rcu_synchronize();
+}
+
+TEST(Rcu, RetireReclaimsAfterBarrier)
+{
+	std::atomic<int> destroyed{ 0 };
+	(new config(1, destroyed))->retire();
+
+	int* raw		 = new int(5);
+	bool deleter_ran = false;
+	SNAP_NAMESPACE::rcu_retire(raw,
+							   [&deleter_ran](int* p) noexcept
+							   {
+								   deleter_ran = true;
+								   delete p;
+							   });
+
+	SNAP_NAMESPACE::rcu_barrier();
+	EXPECT_EQ(destroyed.load(), 1);
+	EXPECT_TRUE(deleter_ran);
+}
+
+TEST(Rcu, SynchronizeWaitsForPreexistingReaders)
+{
+	auto& dom = SNAP_NAMESPACE::rcu_default_domain();
+	std::atomic<bool> entered{ false };
+	std::atomic<bool> left{ false };
+
+	std::thread reader(
+		[&]
+		{
+			dom.lock();
+			entered.store(true);
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			left.store(true);
+			dom.unlock();
+		});
+
+	while (!entered.load()) { std::this_thread::yield(); }
+	SNAP_NAMESPACE::rcu_synchronize();
+	EXPECT_TRUE(left.load());
+
+	reader.join();
+}
+
+TEST(Rcu, ConcurrentReadersSeeConsistentSnapshots)
+{
+	constexpr int reader_count = 3;
+	constexpr int swaps		   = 2000;
+
+	auto& dom = SNAP_NAMESPACE::rcu_default_domain();
+	std::atomic<int> destroyed{ 0 };
+	std::atomic<config*> current{ new config(0, destroyed) };
+	std::atomic<bool> done{ false };
+	std::atomic<int> bad_reads{ 0 };
+
+	std::vector<std::thread> readers;
+	readers.reserve(reader_count);
+	for (int r = 0; r < reader_count; ++r)
+	{
+		readers.emplace_back(
+			[&]
+			{
+				while (!done.load(std::memory_order_acquire))
+				{
+					std::scoped_lock section(dom);
+					const config* snapshot = current.load(std::memory_order_acquire);
+					if (snapshot->value < 0 || snapshot->value > swaps) { bad_reads.fetch_add(1); }
+				}
+			});
+	}
+
+	for (int i = 1; i <= swaps; ++i) { current.exchange(new config(i, destroyed), std::memory_order_acq_rel)->retire(); }
+	done.store(true, std::memory_order_release);
+	for (auto& t : readers) { t.join(); }
+
+	current.exchange(nullptr)->retire();
+	SNAP_NAMESPACE::rcu_barrier();
+
+	EXPECT_EQ(bad_reads.load(), 0);
+	EXPECT_EQ(destroyed.load(), swaps + 1);
+}
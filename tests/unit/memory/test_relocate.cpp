@@ -0,0 +1,140 @@
+#include "snap/memory/relocate.hpp"
+#include "snap/memory/retain_ptr.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+	struct MemberOptIn
+	{
+		using is_trivially_relocatable = std::true_type;
+
+		MemberOptIn() = default;
+		MemberOptIn(MemberOptIn&&) noexcept {}
+		~MemberOptIn() {}
+	};
+
+	struct MacroOptIn
+	{
+		std::unique_ptr<int> owned;
+		~MacroOptIn() {}
+	};
+
+	// Points into itself, so a bytewise copy would leave the copy pointing at the original.
+	struct SelfReferential
+	{
+		int value = 0;
+		int* self = &value;
+
+		SelfReferential() = default;
+		explicit SelfReferential(int v) : value(v) {}
+		SelfReferential(SelfReferential&& other) noexcept : value(other.value) {}
+		SelfReferential& operator=(SelfReferential&&) = delete;
+	};
+
+	struct ThrowingMove
+	{
+		static inline int alive		  = 0;
+		static inline int move_budget = 0;
+
+		int value = 0;
+
+		explicit ThrowingMove(int v) : value(v) { ++alive; }
+		// NOLINTNEXTLINE(performance-noexcept-move-constructor)
+		ThrowingMove(ThrowingMove&& other) : value(other.value)
+		{
+			if (--move_budget < 0) { throw std::runtime_error("move budget exceeded"); }
+			++alive;
+		}
+		~ThrowingMove() { --alive; }
+	};
+
+	struct Counted : SNAP_NAMESPACE::reference_count<Counted>
+	{
+	};
+
+	template <class T> T* storage_of(void* raw) { return static_cast<T*>(raw); }
+} // namespace
+
+SNAP_DECLARE_TRIVIALLY_RELOCATABLE(MacroOptIn);
+
+TEST(Relocate, TraitRecognisesOptIns)
+{
+	static_assert(SNAP_NAMESPACE::is_trivially_relocatable_v<int>);
+	static_assert(SNAP_NAMESPACE::is_trivially_relocatable_v<const double[4]>);
+	static_assert(!SNAP_NAMESPACE::is_trivially_relocatable_v<int&>);
+	static_assert(SNAP_NAMESPACE::is_trivially_relocatable_v<std::unique_ptr<int>>);
+	static_assert(SNAP_NAMESPACE::is_trivially_relocatable_v<std::shared_ptr<int>>);
+	static_assert(SNAP_NAMESPACE::is_trivially_relocatable_v<std::pair<std::unique_ptr<int>, int>>);
+	static_assert(SNAP_NAMESPACE::is_trivially_relocatable_v<SNAP_NAMESPACE::retain_ptr<Counted>>);
+	static_assert(SNAP_NAMESPACE::is_trivially_relocatable_v<MemberOptIn>);
+	static_assert(SNAP_NAMESPACE::is_trivially_relocatable_v<MacroOptIn>);
+	static_assert(!SNAP_NAMESPACE::is_trivially_relocatable_v<SelfReferential>);
+	static_assert(!SNAP_NAMESPACE::is_trivially_relocatable_v<std::pair<SelfReferential, int>>);
+}
+
+TEST(Relocate, RelocateAtMovesTheObject)
+{
+	alignas(std::unique_ptr<int>) unsigned char raw[2][sizeof(std::unique_ptr<int>)];
+	auto* source = ::new (raw[0]) std::unique_ptr<int>(new int(7));
+	int* owned	 = source->get();
+
+	std::unique_ptr<int>* moved = SNAP_NAMESPACE::relocate_at(source, storage_of<std::unique_ptr<int>>(raw[1]));
+	EXPECT_EQ(owned, moved->get());
+	moved->~unique_ptr();
+
+	alignas(SelfReferential) unsigned char raw_self[2][sizeof(SelfReferential)];
+	auto* self			  = ::new (raw_self[0]) SelfReferential(3);
+	SelfReferential* dest = SNAP_NAMESPACE::relocate_at(self, storage_of<SelfReferential>(raw_self[1]));
+	EXPECT_EQ(3, dest->value);
+	EXPECT_EQ(&dest->value, dest->self);
+}
+
+TEST(Relocate, OverlappingRangesShiftBothWays)
+{
+	alignas(std::string) unsigned char raw[5][sizeof(std::string)];
+	auto* first = storage_of<std::string>(raw);
+	for (int i = 0; i < 3; ++i) { ::new (first + i) std::string(20, static_cast<char>('a' + i)); }
+
+	// [0, 3) -> [2, 5)
+	std::string* d_first = SNAP_NAMESPACE::uninitialized_relocate_backward(first, first + 3, first + 5);
+	EXPECT_EQ(first + 2, d_first);
+	EXPECT_EQ(std::string(20, 'a'), first[2]);
+	EXPECT_EQ(std::string(20, 'c'), first[4]);
+
+	// [2, 5) -> [0, 3)
+	std::string* d_last = SNAP_NAMESPACE::uninitialized_relocate(first + 2, first + 5, first);
+	EXPECT_EQ(first + 3, d_last);
+	EXPECT_EQ(std::string(20, 'b'), first[1]);
+	for (int i = 0; i < 3; ++i) { first[i].~basic_string(); }
+
+	alignas(std::unique_ptr<int>) unsigned char raw_ptrs[4][sizeof(std::unique_ptr<int>)];
+	auto* ptrs = storage_of<std::unique_ptr<int>>(raw_ptrs);
+	for (int i = 0; i < 3; ++i) { ::new (ptrs + i) std::unique_ptr<int>(new int(i)); }
+	SNAP_NAMESPACE::uninitialized_relocate_backward(ptrs, ptrs + 3, ptrs + 4);
+	EXPECT_EQ(0, *ptrs[1]);
+	EXPECT_EQ(2, *ptrs[3]);
+	for (int i = 1; i < 4; ++i) { ptrs[i].~unique_ptr(); }
+}
+
+TEST(Relocate, ThrowingMoveDestroysBothRanges)
+{
+	alignas(ThrowingMove) unsigned char raw[6][sizeof(ThrowingMove)];
+	auto* first = storage_of<ThrowingMove>(raw);
+	for (int i = 0; i < 3; ++i) { ::new (first + i) ThrowingMove(i); }
+
+	ThrowingMove::move_budget = 1;
+	EXPECT_THROW(SNAP_NAMESPACE::uninitialized_relocate(first, first + 3, first + 3), std::runtime_error);
+	EXPECT_EQ(0, ThrowingMove::alive);
+
+	for (int i = 0; i < 3; ++i) { ::new (first + i) ThrowingMove(i); }
+	ThrowingMove::move_budget = 1;
+	EXPECT_THROW(SNAP_NAMESPACE::uninitialized_relocate_backward(first, first + 3, first + 6), std::runtime_error);
+	EXPECT_EQ(0, ThrowingMove::alive);
+}
@@ -0,0 +1,179 @@
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/small_vector.hpp"
+#include "snap/testing/assertions.hpp"
+
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Tracked
+	{
+		static inline int alive = 0;
+
+		int value = 0;
+
+		Tracked() { ++alive; }
+		explicit Tracked(int v) : value(v) { ++alive; }
+		Tracked(const Tracked& other) : value(other.value) { ++alive; }
+		Tracked(Tracked&& other) noexcept : value(other.value) { ++alive; }
+		Tracked& operator=(const Tracked&) = default;
+		Tracked& operator=(Tracked&&)	   = default;
+		~Tracked() { --alive; }
+	};
+
+	// Counts allocations so spills are observable.
+	template <class T> struct CountingAllocator
+	{
+		using value_type = T;
+
+		static inline int allocations = 0;
+
+		CountingAllocator() = default;
+		template <class U> CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+		T* allocate(std::size_t n)
+		{
+			++allocations;
+			return std::allocator<T>().allocate(n);
+		}
+		void deallocate(T* p, std::size_t n) noexcept
+		{
+			--allocations;
+			std::allocator<T>().deallocate(p, n);
+		}
+
+		friend bool operator==(const CountingAllocator&, const CountingAllocator&) { return true; }
+		friend bool operator!=(const CountingAllocator&, const CountingAllocator&) { return false; }
+	};
+
+	template <class Container> std::vector<int> values_of(const Container& container)
+	{
+		std::vector<int> result;
+		for (const auto& element : container) { result.push_back(element.value); }
+		return result;
+	}
+} // namespace
+
+SNAP_BEGIN_NAMESPACE
+namespace test_cases
+{
+	TEST(SmallVector, StaysInlineUpToN)
+	{
+		SNAP_NAMESPACE::small_vector<int, 4, CountingAllocator<int>> values{ 1, 2, 3, 4 };
+		EXPECT_TRUE(values.is_inline());
+		EXPECT_EQ(4U, values.capacity());
+		EXPECT_EQ(0, CountingAllocator<int>::allocations);
+
+		values.push_back(5);
+		EXPECT_FALSE(values.is_inline());
+		EXPECT_EQ(8U, values.capacity());
+		EXPECT_EQ(1, CountingAllocator<int>::allocations);
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 1, 2, 3, 4, 5 });
+
+		values.erase(values.begin(), values.begin() + 2);
+		values.shrink_to_fit();
+		EXPECT_TRUE(values.is_inline());
+		EXPECT_EQ(0, CountingAllocator<int>::allocations);
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 3, 4, 5 });
+	}
+
+	TEST(SmallVector, GrowthPolicyControlsCapacity)
+	{
+		SNAP_NAMESPACE::small_vector<int, 2, std::allocator<int>, SNAP_NAMESPACE::exact_growth> exact{ 1, 2 };
+		exact.push_back(3);
+		EXPECT_EQ(3U, exact.capacity());
+
+		SNAP_NAMESPACE::small_vector<int, 4, std::allocator<int>, SNAP_NAMESPACE::geometric_growth<3, 2>> golden{ 1, 2, 3, 4 };
+		golden.push_back(5);
+		EXPECT_EQ(6U, golden.capacity());
+
+		// a single large append never grows below what it needs
+		golden.append_range(std::vector<int>(20, 0));
+		EXPECT_EQ(25U, golden.size());
+		EXPECT_LE(25U, golden.capacity());
+	}
+
+	TEST(SmallVector, PushBackOfOwnElementWhileGrowing)
+	{
+		SNAP_NAMESPACE::small_vector<std::string, 2> values{ "first", "second" };
+		values.push_back(values.front());
+		values.emplace_back(values[1]);
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<std::string>{ "first", "second", "first", "second" });
+	}
+
+	TEST(SmallVector, InsertAndErase)
+	{
+		SNAP_NAMESPACE::small_vector<int, 4> values{ 1, 5 };
+		values.insert(values.begin() + 1, { 2, 3, 4 });
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 1, 2, 3, 4, 5 });
+
+		values.insert(values.begin(), 2, values[4]);
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 5, 5, 1, 2, 3, 4, 5 });
+
+		values.emplace(values.begin() + 2, 0);
+		values.erase(values.begin());
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 5, 0, 1, 2, 3, 4, 5 });
+
+		EXPECT_EQ(2U, SNAP_NAMESPACE::erase(values, 5));
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 0, 1, 2, 3, 4 });
+
+		std::istringstream in("7 8");
+		values.insert(values.end(), std::istream_iterator<int>(in), std::istream_iterator<int>());
+		SNAP_NAMESPACE::test::ExpectRangeEq(values, std::vector<int>{ 0, 1, 2, 3, 4, 7, 8 });
+	}
+
+	TEST(SmallVector, NonTrivialElementsAcrossSpillAndShrink)
+	{
+		Tracked::alive = 0;
+		{
+			SNAP_NAMESPACE::small_vector<Tracked, 2> values;
+			for (int i = 0; i < 5; ++i) { values.emplace_back(i); }
+			values.insert(values.begin() + 1, Tracked(9));
+			EXPECT_EQ(6, Tracked::alive);
+			SNAP_NAMESPACE::test::ExpectRangeEq(values_of(values), std::vector<int>{ 0, 9, 1, 2, 3, 4 });
+
+			values.resize(2);
+			values.shrink_to_fit();
+			EXPECT_TRUE(values.is_inline());
+			EXPECT_EQ(2, Tracked::alive);
+			SNAP_NAMESPACE::test::ExpectRangeEq(values_of(values), std::vector<int>{ 0, 9 });
+		}
+		EXPECT_EQ(0, Tracked::alive);
+	}
+
+	TEST(SmallVector, CopyMoveAndSwap)
+	{
+		SNAP_NAMESPACE::small_vector<std::unique_ptr<int>, 2> heap;
+		for (int i = 0; i < 3; ++i) { heap.push_back(std::make_unique<int>(i)); }
+		const int* first = heap.front().get();
+
+		SNAP_NAMESPACE::small_vector<std::unique_ptr<int>, 2> stolen(std::move(heap));
+		EXPECT_TRUE(heap.empty());
+		EXPECT_TRUE(heap.is_inline());
+		EXPECT_EQ(first, stolen.front().get());
+
+		SNAP_NAMESPACE::small_vector<std::string, 2> a{ "x" };
+		SNAP_NAMESPACE::small_vector<std::string, 2> b{ "p", "q", "r" };
+		a.swap(b);
+		SNAP_NAMESPACE::test::ExpectRangeEq(a, std::vector<std::string>{ "p", "q", "r" });
+		SNAP_NAMESPACE::test::ExpectRangeEq(b, std::vector<std::string>{ "x" });
+
+		SNAP_NAMESPACE::small_vector<std::string, 2> c(a);
+		EXPECT_TRUE(c == a);
+		c = b;
+		EXPECT_TRUE(c == b);
+		c = std::move(a);
+		SNAP_NAMESPACE::test::ExpectRangeEq(c, std::vector<std::string>{ "p", "q", "r" });
+
+		c.assign_range(std::list<std::string>{ "only" });
+		SNAP_NAMESPACE::test::ExpectRangeEq(c, std::vector<std::string>{ "only" });
+	}
+} // namespace test_cases
+SNAP_END_NAMESPACE
@@ -0,0 +1,213 @@
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/soa_vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+SNAP_BEGIN_NAMESPACE
+namespace test_cases
+{
+	namespace
+	{
+		using record = soa_vector<type_list<double, int, char>>;
+
+		struct counted
+		{
+			static inline int alive		  = 0;
+			static inline int copies_left = -1; // copies allowed before one throws; -1 for no limit
+
+			int value = 0;
+
+			counted() noexcept { ++alive; }
+			explicit counted(int v) noexcept : value(v) { ++alive; }
+			counted(const counted& other) : value(other.value)
+			{
+				if (copies_left == 0) throw std::runtime_error("copy");
+				if (copies_left > 0) --copies_left;
+				++alive;
+			}
+			counted& operator=(const counted&) = default;
+			~counted() { --alive; }
+		};
+
+		struct no_default
+		{
+			explicit no_default(int v) noexcept : value(v) {}
+			int value;
+		};
+
+		template <class T> bool aligned(const T* p, std::size_t alignment)
+		{
+			return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+		}
+	} // namespace
+
+	TEST(SoaVector, ColumnsAreContiguousAndAligned)
+	{
+		record v;
+		for (int i = 0; i < 100; ++i) v.emplace_back(i * 0.5, i, static_cast<char>('a' + i % 26));
+		ASSERT_EQ(100U, v.size());
+		EXPECT_GE(v.capacity(), v.size());
+
+		span<double> d = v.get<0>();
+		span<int> n	   = v.get<int>();
+		span<char> c   = v.get<2>();
+		EXPECT_EQ(100U, d.size());
+		EXPECT_TRUE(aligned(d.data(), record::column_alignment));
+		EXPECT_TRUE(aligned(n.data(), record::column_alignment));
+		EXPECT_TRUE(aligned(c.data(), record::column_alignment));
+
+		for (int i = 0; i < 100; ++i)
+		{
+			EXPECT_EQ(i * 0.5, d[static_cast<std::size_t>(i)]);
+			EXPECT_EQ(i, n[static_cast<std::size_t>(i)]);
+			EXPECT_EQ('a' + i % 26, c[static_cast<std::size_t>(i)]);
+		}
+		EXPECT_EQ(n.data(), v.data<1>());
+
+		const record& cv = v;
+		static_assert(std::is_same_v<decltype(cv.get<1>()), span<const int>>);
+		EXPECT_EQ(n.data(), cv.get<1>().data());
+	}
+
+	TEST(SoaVector, ProxyReferencesWriteThrough)
+	{
+		record v{ { 1.0, 1, 'x' }, { 2.0, 2, 'y' } };
+		auto [d, n, c] = v[1];
+		d			   = 4.0;
+		n += 40;
+		c = 'z';
+		EXPECT_EQ(4.0, v.get<0>()[1]);
+		EXPECT_EQ(42, v.get<1>()[1]);
+		EXPECT_EQ('z', v.get<2>()[1]);
+
+		std::get<1>(v.front()) = 7;
+		EXPECT_EQ(7, std::get<1>(v[0]));
+		EXPECT_EQ(record::value_type(4.0, 42, 'z'), record::value_type(v.back()));
+
+		int sum = 0;
+		for (auto row : v) sum += std::get<1>(row);
+		EXPECT_EQ(49, sum);
+		EXPECT_EQ(2, v.end() - v.begin());
+		EXPECT_THROW(v.at(2), std::out_of_range);
+	}
+
+	TEST(SoaVector, GrowthKeepsNonTrivialFields)
+	{
+		soa_vector<type_list<std::string, int>> v;
+		for (int i = 0; i < 50; ++i) v.push_back({ std::string(20, static_cast<char>('a' + i % 26)), i });
+		v.push_back(v[3]); // argument refers into the vector while it may grow
+		ASSERT_EQ(51U, v.size());
+		for (int i = 0; i < 50; ++i)
+		{
+			EXPECT_EQ(std::string(20, static_cast<char>('a' + i % 26)), v.get<0>()[static_cast<std::size_t>(i)]);
+			EXPECT_EQ(i, v.get<1>()[static_cast<std::size_t>(i)]);
+		}
+		EXPECT_EQ(std::string(20, 'd'), std::get<0>(v.back()));
+
+		v.erase(v.begin() + 1, v.begin() + 49);
+		ASSERT_EQ(3U, v.size());
+		EXPECT_EQ(0, v.get<1>()[0]);
+		EXPECT_EQ(49, v.get<1>()[1]);
+		EXPECT_EQ(3, v.get<1>()[2]);
+
+		EXPECT_EQ(1U, erase_if(v, [](const auto& row) { return std::get<1>(row) == 49; }));
+		EXPECT_EQ(2U, v.size());
+		EXPECT_EQ(3, v.get<1>()[1]);
+
+		v.shrink_to_fit();
+		EXPECT_EQ(2U, v.capacity());
+		EXPECT_EQ(std::string(20, 'd'), v.get<0>()[1]);
+	}
+
+	TEST(SoaVector, CopyMoveAndResize)
+	{
+		soa_vector<type_list<int, std::string>> a(3, { 5, "five" });
+		a.resize(5);
+		EXPECT_EQ(0, a.get<0>()[4]);
+		EXPECT_TRUE(a.get<1>()[4].empty());
+
+		auto b = a;
+		EXPECT_EQ(a, b);
+		b.get<1>()[0] = "changed";
+		EXPECT_NE(a, b);
+
+		auto c = std::move(b);
+		EXPECT_TRUE(b.empty());
+		EXPECT_EQ("changed", c.get<1>()[0]);
+
+		a = c;
+		EXPECT_EQ(a, c);
+		b = std::move(c);
+		EXPECT_EQ(a, b);
+
+		swap(a, c);
+		EXPECT_TRUE(a.empty());
+		EXPECT_EQ(5U, c.size());
+
+		c.resize(1);
+		c.pop_back();
+		EXPECT_TRUE(c.empty());
+	}
+
+	TEST(SoaVector, ThrowingGrowthLeavesVectorUnchanged)
+	{
+		counted::alive = 0;
+		{
+			// std::string moves without throwing, but must not be moved while counted can still fail to copy
+			soa_vector<type_list<std::string, counted>> v;
+			v.reserve(4);
+			for (int i = 0; i < 4; ++i) v.emplace_back(std::string(20, static_cast<char>('a' + i)), counted(i));
+			EXPECT_EQ(4, counted::alive);
+
+			counted::copies_left = 2;
+			EXPECT_THROW(v.reserve(64), std::runtime_error);
+			counted::copies_left = 0;
+			EXPECT_THROW(v.emplace_back(std::string(20, 'z'), counted(9)), std::runtime_error);
+			counted::copies_left = -1;
+			ASSERT_EQ(4U, v.size());
+			EXPECT_EQ(4U, v.capacity());
+			EXPECT_EQ(4, counted::alive);
+			for (int i = 0; i < 4; ++i)
+			{
+				EXPECT_EQ(std::string(20, static_cast<char>('a' + i)), v.get<0>()[static_cast<std::size_t>(i)]);
+				EXPECT_EQ(i, v.get<1>()[static_cast<std::size_t>(i)].value);
+			}
+
+			v.resize(20);
+			EXPECT_EQ(20, counted::alive);
+			EXPECT_EQ(std::string(20, 'd'), v.get<0>()[3]);
+		}
+		EXPECT_EQ(0, counted::alive);
+	}
+
+	TEST(SoaVector, EraseIfMovesFieldsWithoutDefaultConstruction)
+	{
+		soa_vector<type_list<std::unique_ptr<int>, no_default>> v;
+		for (int i = 0; i < 6; ++i) v.emplace_back(std::make_unique<int>(i), no_default(i * 10));
+
+		EXPECT_EQ(3U, erase_if(v, [](const auto& row) { return *std::get<0>(row) % 2 == 0; }));
+		ASSERT_EQ(3U, v.size());
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			ASSERT_NE(nullptr, v.get<0>()[i]);
+			EXPECT_EQ(static_cast<int>(2 * i + 1), *v.get<0>()[i]);
+			EXPECT_EQ(static_cast<int>(20 * i + 10), v.get<1>()[i].value);
+		}
+
+		v.erase(v.begin());
+		EXPECT_EQ(3, *v.get<0>()[0]);
+		EXPECT_EQ(30, v.get<no_default>()[0].value);
+	}
+} // namespace test_cases
+SNAP_END_NAMESPACE
@@ -0,0 +1,155 @@
+// Must be included first
+#include "snap/internal/abi_namespace.hpp"
+
+#include "snap/static_map.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+SNAP_BEGIN_NAMESPACE
+namespace test_cases
+{
+	enum class method
+	{
+		get,
+		head,
+		post,
+		put,
+		del,
+	};
+
+	constexpr auto methods = SNAP_NAMESPACE::make_static_map<method>({
+		{ "GET", method::get },
+		{ "HEAD", method::head },
+		{ "POST", method::post },
+		{ "PUT", method::put },
+		{ "DELETE", method::del },
+	});
+
+	static_assert(methods.size() == 5);
+	static_assert(methods.at("PUT") == method::put);
+	static_assert(methods.contains("DELETE"));
+	static_assert(!methods.contains("PATCH"));
+	static_assert(!methods.contains("get"));
+	static_assert(!methods.contains(""));
+
+	// "hdr-000" ... "hdr-299", laid out in one constant buffer so the map's views can point into it
+	struct generated_names
+	{
+		static constexpr std::size_t count	= 300;
+		static constexpr std::size_t length = 7;
+
+		constexpr generated_names() noexcept
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				char* name = chars + i * length;
+				name[0]	   = 'h';
+				name[1]	   = 'd';
+				name[2]	   = 'r';
+				name[3]	   = '-';
+				name[4]	   = static_cast<char>('0' + i / 100);
+				name[5]	   = static_cast<char>('0' + i / 10 % 10);
+				name[6]	   = static_cast<char>('0' + i % 10);
+			}
+		}
+
+		constexpr std::string_view operator[](std::size_t i) const noexcept { return { chars + i * length, length }; }
+
+		char chars[count * length]{};
+	};
+
+	constexpr generated_names names{};
+
+	template <std::size_t... I> constexpr auto make_generated_map(std::index_sequence<I...>)
+	{
+		using map = SNAP_NAMESPACE::static_map<int, sizeof...(I)>;
+		return map({ typename map::value_type(names[I], static_cast<int>(I))... });
+	}
+
+	constexpr auto generated = make_generated_map(std::make_index_sequence<generated_names::count>{});
+
+	static_assert(generated.at("hdr-000") == 0);
+	static_assert(generated.at("hdr-299") == 299);
+	static_assert(!generated.contains("hdr-300"));
+
+	TEST(StaticMap, FindsEveryKeyAndRejectsMisses)
+	{
+		for (const auto& entry : methods)
+		{
+			const std::string key(entry.first);
+			ASSERT_NE(methods.end(), methods.find(key));
+			EXPECT_EQ(entry.second, methods.find(key)->second);
+			EXPECT_EQ(1U, methods.count(key));
+		}
+		EXPECT_EQ(methods.end(), methods.find("GETS"));
+		EXPECT_EQ(methods.end(), methods.find("GE"));
+		EXPECT_THROW((void)methods.at("OPTIONS"), std::out_of_range);
+	}
+
+	TEST(StaticMap, IteratesInInputOrder)
+	{
+		std::vector<std::string_view> keys;
+		for (const auto& entry : methods) keys.push_back(entry.first);
+		EXPECT_EQ((std::vector<std::string_view>{ "GET", "HEAD", "POST", "PUT", "DELETE" }), keys);
+	}
+
+	TEST(StaticMap, ManyKeysEachTakeOneSlot)
+	{
+		for (std::size_t i = 0; i < generated_names::count; ++i)
+		{
+			const std::string key(names[i]);
+			EXPECT_EQ(static_cast<int>(i), generated.at(key)) << key;
+		}
+
+		std::size_t misses = 0;
+		for (std::size_t i = 300; i < 1000; ++i)
+		{
+			const std::string key = "hdr-" + std::to_string(i);
+			misses += static_cast<std::size_t>(!generated.contains(key));
+		}
+		EXPECT_EQ(700U, misses);
+		EXPECT_FALSE(generated.contains("hdr-00"));
+		EXPECT_FALSE(generated.contains("hdr-0000"));
+	}
+
+	TEST(StaticMap, BuildsAtRuntimeAndDetectsDuplicates)
+	{
+		using map = SNAP_NAMESPACE::static_map<int, 3>;
+		const std::string a = "alpha";
+		const std::string b = "beta";
+		const map m({ { a, 1 }, { b, 2 }, { "a long key that spans several words", 3 } });
+		EXPECT_EQ(3, m.at("a long key that spans several words"));
+		EXPECT_EQ(2, m.at("beta"));
+		EXPECT_FALSE(m.contains("a long key that spans several word"));
+
+		EXPECT_THROW((map({ { a, 1 }, { b, 2 }, { "alpha", 3 } })), std::invalid_argument);
+	}
+
+	TEST(StaticMap, WideKeys)
+	{
+		constexpr auto m = SNAP_NAMESPACE::make_static_map<int, wchar_t>({ { L"one", 1 }, { L"two", 2 } });
+		static_assert(m.at(L"two") == 2);
+		EXPECT_EQ(1, m.at(L"one"));
+		EXPECT_FALSE(m.contains(L"three"));
+	}
+
+#if SNAP_HAS_CPP20 && defined(__cpp_nontype_template_args) && (__cpp_nontype_template_args >= 201911L)
+	TEST(StaticMap, FixedStringKeys)
+	{
+		constexpr auto m = SNAP_NAMESPACE::make_static_map<"content-type", "content-length", "host">(1, 2, 3);
+		static_assert(m.at("host") == 3);
+		EXPECT_EQ(2, m.at("content-length"));
+		EXPECT_EQ(1, m.find("content-type")->second);
+		EXPECT_FALSE(m.contains("accept"));
+	}
+#endif
+} // namespace test_cases
+SNAP_END_NAMESPACE
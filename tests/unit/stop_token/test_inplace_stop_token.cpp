@@ -0,0 +1,53 @@
+#include "snap/stop_token/inplace_stop_token.hpp"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<SNAP_NAMESPACE::inplace_stop_token>);
+static_assert(sizeof(SNAP_NAMESPACE::inplace_stop_token) == sizeof(void*));
+
+TEST(InplaceStopToken, DefaultTokenHasNoState)
+{
+	SNAP_NAMESPACE::inplace_stop_token token;
+	EXPECT_FALSE(token.stop_possible());
+	EXPECT_FALSE(token.stop_requested());
+	EXPECT_EQ(token, SNAP_NAMESPACE::inplace_stop_token{});
+}
+
+TEST(InplaceStopToken, TokensReflectSource)
+{
+	SNAP_NAMESPACE::inplace_stop_source source;
+	auto token = source.get_token();
+
+	EXPECT_TRUE(token.stop_possible());
+	EXPECT_FALSE(token.stop_requested());
+	EXPECT_EQ(token, source.get_token());
+
+	EXPECT_TRUE(source.request_stop());
+	EXPECT_FALSE(source.request_stop());
+	EXPECT_TRUE(source.stop_requested());
+	EXPECT_TRUE(token.stop_requested());
+
+	SNAP_NAMESPACE::inplace_stop_source other;
+	EXPECT_NE(token, other.get_token());
+}
+
+TEST(InplaceStopToken, CallbacksRunOnceAndUnregister)
+{
+	SNAP_NAMESPACE::inplace_stop_source source;
+	int calls	  = 0;
+	bool detached = false;
+
+	SNAP_NAMESPACE::inplace_stop_callback cb(source.get_token(), [&calls] { ++calls; });
+	{
+		SNAP_NAMESPACE::inplace_stop_callback gone(source.get_token(), [&detached] { detached = true; });
+	}
+
+	source.request_stop();
+	EXPECT_EQ(calls, 1);
+	EXPECT_FALSE(detached);
+
+	SNAP_NAMESPACE::inplace_stop_callback late(source.get_token(), [&calls] { ++calls; });
+	EXPECT_EQ(calls, 2);
+}
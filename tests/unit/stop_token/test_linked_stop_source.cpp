@@ -0,0 +1,94 @@
+#include "snap/stop_token/linked_stop_source.hpp"
+
+#include "snap/stop_token/stop_callback.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+TEST(LinkedStopSource, ParentStopPropagatesThroughChain)
+{
+	SNAP_NAMESPACE::stop_source server;
+	SNAP_NAMESPACE::linked_stop_source connection(server.get_token());
+	SNAP_NAMESPACE::linked_stop_source request(connection.get_token());
+	SNAP_NAMESPACE::linked_stop_source subcall(request.get_token());
+
+	int fired = 0;
+	SNAP_NAMESPACE::stop_callback cb(subcall.get_token(), [&fired] { ++fired; });
+
+	EXPECT_FALSE(subcall.stop_requested());
+	EXPECT_TRUE(server.request_stop());
+
+	EXPECT_TRUE(connection.stop_requested());
+	EXPECT_TRUE(request.get_token().stop_requested());
+	EXPECT_TRUE(subcall.stop_requested());
+	EXPECT_EQ(fired, 1);
+}
+
+TEST(LinkedStopSource, ChildStopDoesNotReachParents)
+{
+	SNAP_NAMESPACE::stop_source a;
+	SNAP_NAMESPACE::stop_source b;
+	SNAP_NAMESPACE::linked_stop_source child(a.get_token(), b.get_token());
+
+	EXPECT_TRUE(child.request_stop());
+	EXPECT_TRUE(child.stop_requested());
+	EXPECT_FALSE(a.stop_requested());
+	EXPECT_FALSE(b.stop_requested());
+}
+
+TEST(LinkedStopSource, AnyParentStopsChild)
+{
+	SNAP_NAMESPACE::stop_source a;
+	SNAP_NAMESPACE::stop_source b;
+	SNAP_NAMESPACE::linked_stop_source child(a.get_token(), b.get_token());
+
+	b.request_stop();
+	EXPECT_TRUE(child.stop_requested());
+
+	a.request_stop();
+	EXPECT_FALSE(child.request_stop());
+}
+
+TEST(LinkedStopSource, AlreadyStoppedParentStopsChildImmediately)
+{
+	SNAP_NAMESPACE::stop_source parent;
+	parent.request_stop();
+
+	SNAP_NAMESPACE::linked_stop_source child(parent.get_token(), SNAP_NAMESPACE::stop_token{});
+	EXPECT_TRUE(child.stop_requested());
+}
+
+TEST(LinkedStopSource, DestroyedChildIsUnlinked)
+{
+	SNAP_NAMESPACE::stop_source parent;
+	{
+		SNAP_NAMESPACE::linked_stop_source child(parent.get_token());
+		EXPECT_FALSE(child.stop_requested());
+	}
+	EXPECT_TRUE(parent.request_stop());
+}
+
+TEST(LinkedStopSource, ConcurrentChildChurnDuringStop)
+{
+	SNAP_NAMESPACE::stop_source parent;
+	const auto token = parent.get_token();
+	std::atomic<bool> go{ false };
+
+	std::thread churn(
+		[&]
+		{
+			go.store(true);
+			for (int i = 0; i < 2000; ++i)
+			{
+				auto child = std::make_unique<SNAP_NAMESPACE::linked_stop_source<1>>(token);
+				if (token.stop_requested()) { EXPECT_TRUE(child->stop_requested()); }
+			}
+		});
+
+	while (!go.load()) { std::this_thread::yield(); }
+	parent.request_stop();
+	churn.join();
+}
@@ -0,0 +1,92 @@
+#include "snap/stop_token/stop_callback.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+
+TEST(StopCallback, InvokedOnRequestStop)
+{
+	SNAP_NAMESPACE::stop_source source;
+	int calls = 0;
+
+	SNAP_NAMESPACE::stop_callback cb(source.get_token(), [&calls] { ++calls; });
+	EXPECT_EQ(calls, 0);
+
+	EXPECT_TRUE(source.request_stop());
+	EXPECT_EQ(calls, 1);
+
+	EXPECT_FALSE(source.request_stop());
+	EXPECT_EQ(calls, 1);
+}
+
+TEST(StopCallback, InvokedImmediatelyWhenAlreadyStopped)
+{
+	SNAP_NAMESPACE::stop_source source;
+	source.request_stop();
+
+	bool called = false;
+	SNAP_NAMESPACE::stop_callback cb(source.get_token(), [&called] { called = true; });
+	EXPECT_TRUE(called);
+}
+
+TEST(StopCallback, NotInvokedAfterDestructionOrWithoutState)
+{
+	SNAP_NAMESPACE::stop_source source;
+	bool called = false;
+	{
+		SNAP_NAMESPACE::stop_callback cb(source.get_token(), [&called] { called = true; });
+	}
+	source.request_stop();
+	EXPECT_FALSE(called);
+
+	SNAP_NAMESPACE::stop_callback none(SNAP_NAMESPACE::stop_token{}, [&called] { called = true; });
+	EXPECT_FALSE(called);
+}
+
+TEST(StopCallback, CallbackMayDestroyItsOwnRegistration)
+{
+	using callback_t = std::function<void()>;
+
+	SNAP_NAMESPACE::stop_source source;
+	std::optional<SNAP_NAMESPACE::stop_callback<callback_t>> cb;
+	bool called = false;
+
+	cb.emplace(source.get_token(),
+			   [&]
+			   {
+				   called = true;
+				   cb.reset();
+			   });
+
+	source.request_stop();
+	EXPECT_TRUE(called);
+	EXPECT_FALSE(cb.has_value());
+}
+
+TEST(StopCallback, DestructorWaitsForCallbackRunningOnAnotherThread)
+{
+	SNAP_NAMESPACE::stop_source source;
+	std::atomic<bool> started{ false };
+	std::atomic<bool> finished{ false };
+
+	auto cb = std::make_unique<SNAP_NAMESPACE::stop_callback<std::function<void()>>>(source.get_token(),
+																					  [&]
+																					  {
+																						  started.store(true);
+																						  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+																						  finished.store(true);
+																					  });
+
+	std::thread requester([&] { source.request_stop(); });
+	while (!started.load()) { std::this_thread::yield(); }
+
+	cb.reset();
+	EXPECT_TRUE(finished.load());
+
+	requester.join();
+}
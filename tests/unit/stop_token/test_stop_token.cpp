@@ -4,10 +4,13 @@
 
 #include <snap/stop_token/intrusive_list_view.hpp>
 #include <snap/stop_token/intrusive_shared_ptr.hpp>
+#include <snap/stop_token/stop_callback.hpp>
 #include <snap/stop_token/stop_source.hpp>
 #include <snap/stop_token/stop_state.hpp>
 
 #include <atomic>
+#include <cstddef>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -132,3 +135,122 @@ TEST(StopTokenStopSource, TokensReflectState)
 	EXPECT_FALSE(none.stop_possible());
 	EXPECT_FALSE(none.get_token().stop_possible());
 }
+
+namespace
+{
+	struct CountingAllocatorStats
+	{
+		int allocations	  = 0;
+		int deallocations = 0;
+	};
+
+	template <class T> struct CountingAllocator
+	{
+		using value_type = T;
+
+		explicit CountingAllocator(CountingAllocatorStats* s) noexcept : stats(s) {}
+		template <class U> CountingAllocator(const CountingAllocator<U>& other) noexcept : stats(other.stats) {}
+
+		T* allocate(std::size_t n)
+		{
+			++stats->allocations;
+			return std::allocator<T>{}.allocate(n);
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept
+		{
+			++stats->deallocations;
+			std::allocator<T>{}.deallocate(p, n);
+		}
+
+		template <class U> friend bool operator==(const CountingAllocator& a, const CountingAllocator<U>& b) noexcept { return a.stats == b.stats; }
+		template <class U> friend bool operator!=(const CountingAllocator& a, const CountingAllocator<U>& b) noexcept { return a.stats != b.stats; }
+
+		CountingAllocatorStats* stats;
+	};
+} // namespace
+
+TEST(StopTokenStopSource, AllocatorConstructedStateIsReturnedToAllocator)
+{
+	CountingAllocatorStats stats;
+	{
+		SNAP_NAMESPACE::stop_source source(std::allocator_arg, CountingAllocator<char>(&stats));
+		EXPECT_EQ(stats.allocations, 1);
+
+		auto token = source.get_token();
+
+		SNAP_NAMESPACE::stop_source copy(source);
+		EXPECT_EQ(stats.allocations, 1);
+
+		EXPECT_TRUE(copy.request_stop());
+		EXPECT_TRUE(token.stop_requested());
+	}
+	EXPECT_EQ(stats.allocations, 1);
+	EXPECT_EQ(stats.deallocations, 1);
+}
+
+TEST(StopTokenStopSource, PooledStatesAreRecycledAcrossThreads)
+{
+	std::vector<SNAP_NAMESPACE::stop_token> tokens;
+	for (int round = 0; round < 3; ++round)
+	{
+		{
+			std::vector<SNAP_NAMESPACE::stop_source> sources(100);
+			for (auto& s : sources) { tokens.push_back(s.get_token()); }
+		}
+
+		// Tokens keep the states alive; release them on another thread so its cache takes ownership of the blocks.
+		std::thread releaser([moved = std::move(tokens)]() mutable { moved.clear(); });
+		releaser.join();
+		tokens.clear();
+	}
+
+	SNAP_NAMESPACE::stop_source fresh;
+	EXPECT_TRUE(fresh.stop_possible());
+	EXPECT_FALSE(fresh.get_token().stop_requested());
+}
+
+TEST(StopTokenStopSource, ShardedCallbacksRunOnceEachAndUnregister)
+{
+	constexpr int thread_count		   = 4;
+	constexpr int callbacks_per_thread = 64;
+
+	SNAP_NAMESPACE::stop_source source(SNAP_NAMESPACE::sharded_callbacks, 8);
+	const auto token = source.get_token();
+
+	std::atomic<int> invoked{ 0 };
+	std::atomic<int> registered{ 0 };
+	std::atomic<bool> release{ false };
+
+	const auto bump  = [&invoked] { invoked.fetch_add(1); };
+	using callback_t = SNAP_NAMESPACE::stop_callback<decltype(bump)>;
+
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count);
+	for (int t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back(
+			[&]
+			{
+				std::vector<std::unique_ptr<callback_t>> kept;
+				for (int i = 0; i < callbacks_per_thread; ++i)
+				{
+					auto cb = std::make_unique<callback_t>(token, bump);
+					if (i % 2 != 0) { kept.push_back(std::move(cb)); }
+				}
+
+				registered.fetch_add(1);
+				while (!release.load()) { std::this_thread::yield(); }
+			});
+	}
+
+	while (registered.load() != thread_count) { std::this_thread::yield(); }
+	EXPECT_TRUE(source.request_stop());
+	EXPECT_EQ(invoked.load(), thread_count * callbacks_per_thread / 2);
+
+	release.store(true);
+	for (auto& th : threads) { th.join(); }
+
+	callback_t late(token, bump);
+	EXPECT_EQ(invoked.load(), thread_count * callbacks_per_thread / 2 + 1);
+}
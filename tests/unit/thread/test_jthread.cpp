@@ -3,6 +3,16 @@
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <cstddef>
+#include <future>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#if defined(__linux__)
+	#include <pthread.h>
+	#include <sched.h>
+#endif
 
 TEST(Thread, JthreadInvokesCallableWithStopToken)
 {
@@ -15,3 +25,104 @@ TEST(Thread, JthreadInvokesCallableWithStopToken)
 	}
 	EXPECT_TRUE(stop_possible.load(std::memory_order_relaxed));
 }
+
+TEST(Thread, JthreadAppliesAttributesBeforeRunning)
+{
+	SNAP_NAMESPACE::thread_attributes attrs;
+	attrs.name		 = "snap-worker";
+	attrs.stack_size = 1024 * 1024;
+
+	std::atomic<bool> stop_possible{ false };
+	std::atomic<std::size_t> stack_size{ 0 };
+	std::string name;
+	{
+		SNAP_NAMESPACE::jthread worker(attrs,
+									   [&](SNAP_NAMESPACE::stop_token token, int)
+									   {
+										   stop_possible.store(token.stop_possible(), std::memory_order_relaxed);
+#if defined(__linux__)
+										   char buf[16] = {};
+										   ::pthread_getname_np(::pthread_self(), buf, sizeof(buf));
+										   name = buf;
+
+										   pthread_attr_t self_attr;
+										   if (::pthread_getattr_np(::pthread_self(), &self_attr) == 0)
+										   {
+											   std::size_t sz = 0;
+											   ::pthread_attr_getstacksize(&self_attr, &sz);
+											   stack_size.store(sz, std::memory_order_relaxed);
+											   ::pthread_attr_destroy(&self_attr);
+										   }
+#endif
+									   },
+									   42);
+	}
+	EXPECT_TRUE(stop_possible.load(std::memory_order_relaxed));
+#if defined(__linux__)
+	EXPECT_EQ(name, "snap-worker");
+	EXPECT_GE(stack_size.load(std::memory_order_relaxed), attrs.stack_size);
+	EXPECT_LT(stack_size.load(std::memory_order_relaxed), std::size_t{ 8 } * 1024 * 1024);
+#endif
+}
+
+#if defined(__linux__)
+TEST(Thread, JthreadPinsToRequestedCpu)
+{
+	SNAP_NAMESPACE::thread_attributes attrs;
+	attrs.affinity = { 0 };
+
+	std::atomic<int> cpu_count{ -1 };
+	std::atomic<bool> on_cpu0{ false };
+	{
+		SNAP_NAMESPACE::jthread worker(attrs,
+									   [&]
+									   {
+										   cpu_set_t set;
+										   CPU_ZERO(&set);
+										   ::pthread_getaffinity_np(::pthread_self(), sizeof(set), &set);
+										   cpu_count.store(CPU_COUNT(&set), std::memory_order_relaxed);
+										   on_cpu0.store(CPU_ISSET(0, &set) != 0, std::memory_order_relaxed);
+									   });
+	}
+	EXPECT_EQ(cpu_count.load(std::memory_order_relaxed), 1);
+	EXPECT_TRUE(on_cpu0.load(std::memory_order_relaxed));
+}
+#endif
+
+TEST(Thread, JthreadWithAttributesReportsIdAndMoves)
+{
+	SNAP_NAMESPACE::thread_attributes attrs;
+	attrs.stack_size = 512 * 1024;
+
+	std::atomic<bool> release{ false };
+	std::promise<std::thread::id> inner_id;
+	std::future<std::thread::id> inner_future = inner_id.get_future();
+
+	SNAP_NAMESPACE::jthread worker(attrs,
+								   [&]
+								   {
+									   inner_id.set_value(std::this_thread::get_id());
+									   while (!release.load(std::memory_order_acquire)) std::this_thread::yield();
+								   });
+	const std::thread::id expected = inner_future.get();
+	EXPECT_EQ(expected, worker.get_id());
+	EXPECT_TRUE(worker.joinable());
+
+	SNAP_NAMESPACE::jthread moved(std::move(worker));
+	EXPECT_FALSE(worker.joinable());
+	EXPECT_EQ(expected, moved.get_id());
+
+	release.store(true, std::memory_order_release);
+	moved.join();
+	EXPECT_FALSE(moved.joinable());
+}
+
+TEST(Thread, JthreadThrowsWhenAttributesCannotBeApplied)
+{
+	SNAP_NAMESPACE::thread_attributes attrs;
+	attrs.affinity = { 1u << 20 };
+
+	std::atomic<bool> ran{ false };
+	EXPECT_THROW(SNAP_NAMESPACE::jthread(attrs, [&] { ran.store(true, std::memory_order_relaxed); }), std::system_error);
+	EXPECT_FALSE(ran.load(std::memory_order_relaxed));
+}
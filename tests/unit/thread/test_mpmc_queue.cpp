@@ -0,0 +1,129 @@
+#include "snap/thread/mpmc_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(MpmcQueue, RoundsCapacityAndKeepsFifoOrder)
+{
+	SNAP_NAMESPACE::mpmc_queue<int> q(5);
+	EXPECT_EQ(8U, q.capacity());
+	for (int i = 0; i < 8; ++i) EXPECT_TRUE(q.try_push(i));
+	EXPECT_FALSE(q.try_push(8));
+
+	int out = -1;
+	for (int i = 0; i < 8; ++i)
+	{
+		ASSERT_TRUE(q.try_pop(out));
+		EXPECT_EQ(i, out);
+	}
+	EXPECT_FALSE(q.try_pop(out));
+	EXPECT_TRUE(q.empty());
+}
+
+TEST(MpmcQueue, BatchesClaimRunsOfCells)
+{
+	SNAP_NAMESPACE::mpmc_queue<std::string> q(4);
+	const std::vector<std::string> input{ "a", "b", "c", "d", "e" };
+
+	EXPECT_EQ(4U, q.push_n(input.begin(), input.size()));
+	std::vector<std::string> out;
+	EXPECT_EQ(2U, q.pop_n(std::back_inserter(out), 2));
+	EXPECT_EQ(1U, q.push_n(input.begin() + 4, 1));
+	EXPECT_EQ(3U, q.pop_n(std::back_inserter(out), 8));
+	EXPECT_EQ(input, out);
+}
+
+TEST(MpmcQueue, DestroysQueuedElements)
+{
+	auto tracker = std::make_shared<int>(0);
+	{
+		SNAP_NAMESPACE::mpmc_queue<std::shared_ptr<int>> q(4);
+		for (int i = 0; i < 3; ++i) ASSERT_TRUE(q.try_push(tracker));
+		EXPECT_EQ(4, tracker.use_count());
+	}
+	EXPECT_EQ(1, tracker.use_count());
+}
+
+TEST(MpmcQueue, ManyProducersManyConsumers)
+{
+	constexpr std::size_t producers = 4;
+	constexpr std::size_t consumers = 4;
+	constexpr std::size_t per_producer = 50000;
+
+	SNAP_NAMESPACE::mpmc_queue<std::size_t> q(256);
+	std::atomic<std::size_t> popped{ 0 };
+	std::atomic<std::size_t> sum{ 0 };
+	std::vector<std::atomic<int>> seen(producers * per_producer);
+
+	std::vector<std::thread> threads;
+	for (std::size_t p = 0; p < producers; ++p)
+	{
+		threads.emplace_back(
+			[&, p]
+			{
+				for (std::size_t i = 0; i < per_producer; ++i)
+				{
+					while (!q.try_push(p * per_producer + i)) std::this_thread::yield();
+				}
+			});
+	}
+	for (std::size_t c = 0; c < consumers; ++c)
+	{
+		threads.emplace_back(
+			[&]
+			{
+				std::size_t batch[8];
+				while (popped.load(std::memory_order_relaxed) < producers * per_producer)
+				{
+					const std::size_t n = q.pop_n(batch, 8);
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						seen[batch[i]].fetch_add(1, std::memory_order_relaxed);
+						sum.fetch_add(batch[i], std::memory_order_relaxed);
+					}
+					popped.fetch_add(n, std::memory_order_relaxed);
+					if (n == 0) std::this_thread::yield();
+				}
+			});
+	}
+	for (auto& t : threads) t.join();
+
+	const std::size_t total = producers * per_producer;
+	EXPECT_EQ(total, popped.load());
+	EXPECT_EQ(total * (total - 1) / 2, sum.load());
+	for (const auto& s : seen) ASSERT_EQ(1, s.load());
+}
+
+TEST(MpmcQueue, BlockingPushAndPopPark)
+{
+	constexpr int per_thread = 20000;
+	SNAP_NAMESPACE::mpmc_queue<int, true> q(2);
+	std::atomic<long long> sum{ 0 };
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 2; ++t)
+	{
+		threads.emplace_back(
+			[&]
+			{
+				for (int i = 0; i < per_thread; ++i) q.push(i);
+			});
+		threads.emplace_back(
+			[&]
+			{
+				long long local = 0;
+				for (int i = 0; i < per_thread; ++i) local += q.pop();
+				sum.fetch_add(local);
+			});
+	}
+	for (auto& t : threads) t.join();
+	EXPECT_EQ(2LL * per_thread * (per_thread - 1) / 2, sum.load());
+	EXPECT_TRUE(q.empty());
+}
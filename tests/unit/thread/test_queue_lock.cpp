@@ -0,0 +1,74 @@
+#include "snap/thread/queue_lock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST(QueueLock, LockUnlockAndTryLock)
+{
+	SNAP_NAMESPACE::queue_lock lock;
+	EXPECT_FALSE(lock.is_locked());
+
+	lock.lock();
+	EXPECT_TRUE(lock.is_locked());
+	EXPECT_FALSE(lock.try_lock());
+	lock.unlock();
+
+	EXPECT_FALSE(lock.is_locked());
+	EXPECT_TRUE(lock.try_lock());
+	lock.unlock();
+}
+
+TEST(QueueLock, CallerSuppliedNode)
+{
+	SNAP_NAMESPACE::queue_lock lock;
+	SNAP_NAMESPACE::queue_lock::node first;
+	SNAP_NAMESPACE::queue_lock::node second;
+
+	lock.lock(first);
+	EXPECT_FALSE(lock.try_lock(second));
+	lock.unlock(first);
+
+	EXPECT_TRUE(lock.try_lock(second));
+	lock.unlock(second);
+}
+
+TEST(QueueLock, WorksWithStandardGuards)
+{
+	SNAP_NAMESPACE::queue_lock lock;
+	{
+		std::lock_guard<SNAP_NAMESPACE::queue_lock> guard(lock);
+		EXPECT_TRUE(lock.is_locked());
+	}
+	EXPECT_FALSE(lock.is_locked());
+}
+
+TEST(QueueLock, ProvidesMutualExclusionUnderContention)
+{
+	constexpr int thread_count = 4;
+	constexpr int iterations   = 20000;
+
+	SNAP_NAMESPACE::queue_lock lock;
+	long counter = 0;
+
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count);
+	for (int t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back(
+			[&]
+			{
+				for (int i = 0; i < iterations; ++i)
+				{
+					std::lock_guard<SNAP_NAMESPACE::queue_lock> guard(lock);
+					++counter;
+				}
+			});
+	}
+	for (auto& th : threads) { th.join(); }
+
+	EXPECT_EQ(counter, static_cast<long>(thread_count) * iterations);
+	EXPECT_FALSE(lock.is_locked());
+}
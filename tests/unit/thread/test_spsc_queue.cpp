@@ -0,0 +1,102 @@
+#include "snap/thread/spsc_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST(SpscQueue, PushPopInOrderUntilFull)
+{
+	SNAP_NAMESPACE::spsc_queue<int, 4> q;
+	EXPECT_TRUE(q.empty());
+	for (int i = 0; i < 4; ++i) EXPECT_TRUE(q.try_push(i));
+	EXPECT_FALSE(q.try_push(4));
+	EXPECT_EQ(4U, q.size());
+
+	int out = -1;
+	for (int i = 0; i < 4; ++i)
+	{
+		ASSERT_TRUE(q.try_pop(out));
+		EXPECT_EQ(i, out);
+	}
+	EXPECT_FALSE(q.try_pop(out));
+}
+
+TEST(SpscQueue, BatchesWrapAround)
+{
+	SNAP_NAMESPACE::spsc_queue<int, 5> q;
+	std::vector<int> input(8);
+	std::iota(input.begin(), input.end(), 0);
+
+	EXPECT_EQ(5U, q.push_n(input.begin(), input.size()));
+	std::vector<int> out;
+	EXPECT_EQ(3U, q.pop_n(std::back_inserter(out), 3));
+	EXPECT_EQ(3U, q.push_n(input.begin() + 5, 3));
+	EXPECT_EQ(5U, q.pop_n(std::back_inserter(out), 10));
+	EXPECT_EQ(input, out);
+	EXPECT_EQ(0U, q.pop_n(std::back_inserter(out), 10));
+}
+
+TEST(SpscQueue, DestroysQueuedElements)
+{
+	auto tracker = std::make_shared<int>(0);
+	{
+		SNAP_NAMESPACE::spsc_queue<std::shared_ptr<int>, 8> q;
+		for (int i = 0; i < 5; ++i) ASSERT_TRUE(q.try_push(tracker));
+		std::shared_ptr<int> out;
+		ASSERT_TRUE(q.try_pop(out));
+		EXPECT_EQ(6, tracker.use_count());
+	}
+	EXPECT_EQ(1, tracker.use_count());
+}
+
+TEST(SpscQueue, TransfersEverythingAcrossThreads)
+{
+	constexpr std::size_t count = 200000;
+	SNAP_NAMESPACE::spsc_queue<std::size_t, 64> q;
+
+	std::thread producer(
+		[&]
+		{
+			std::size_t next = 0;
+			std::size_t batch[16];
+			while (next < count)
+			{
+				std::size_t n = 0;
+				for (; n < 16 && next + n < count; ++n) batch[n] = next + n;
+				const std::size_t pushed = q.push_n(batch, n);
+				if (pushed == 0) std::this_thread::yield();
+				next += pushed;
+			}
+		});
+
+	std::size_t expected = 0;
+	std::vector<std::size_t> got;
+	while (expected < count)
+	{
+		got.clear();
+		if (q.pop_n(std::back_inserter(got), 32) == 0) std::this_thread::yield();
+		for (const std::size_t v : got) ASSERT_EQ(expected++, v);
+	}
+	producer.join();
+}
+
+TEST(SpscQueue, BlockingPushAndPopPark)
+{
+	constexpr int count = 50000;
+	SNAP_NAMESPACE::spsc_queue<int, 2, true> q;
+
+	std::thread producer(
+		[&]
+		{
+			for (int i = 0; i < count; ++i) q.push(i);
+		});
+	long long sum = 0;
+	for (int i = 0; i < count; ++i) sum += q.pop();
+	producer.join();
+	EXPECT_EQ(static_cast<long long>(count) * (count - 1) / 2, sum);
+}
@@ -0,0 +1,101 @@
+#include "snap/thread/stop_wait.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(StopWait, SleepCompletesWithoutStopRequest)
+{
+	SNAP_NAMESPACE::stop_source source;
+	EXPECT_TRUE(SNAP_NAMESPACE::this_thread::sleep_for(1ms, source.get_token()));
+	EXPECT_TRUE(SNAP_NAMESPACE::this_thread::sleep_for(1ms, SNAP_NAMESPACE::stop_token{}));
+}
+
+TEST(StopWait, SleepReturnsEarlyOnStopRequest)
+{
+	SNAP_NAMESPACE::stop_source source;
+	const auto start = std::chrono::steady_clock::now();
+
+	std::thread stopper(
+		[&]
+		{
+			std::this_thread::sleep_for(10ms);
+			source.request_stop();
+		});
+
+	EXPECT_FALSE(SNAP_NAMESPACE::this_thread::sleep_for(10s, source.get_token()));
+	EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+	stopper.join();
+
+	EXPECT_FALSE(SNAP_NAMESPACE::this_thread::sleep_for(10s, source.get_token()));
+}
+
+TEST(StopWait, WaitReturnsWhenValueChanges)
+{
+	SNAP_NAMESPACE::stop_source source;
+	std::atomic<int> value{ 0 };
+
+	std::thread writer(
+		[&]
+		{
+			std::this_thread::sleep_for(5ms);
+			value.store(1);
+			SNAP_NAMESPACE::notify_one(value);
+		});
+
+	EXPECT_TRUE(SNAP_NAMESPACE::wait(source.get_token(), value, 0));
+	EXPECT_EQ(value.load(), 1);
+	writer.join();
+}
+
+TEST(StopWait, NotifyAllWakesStopAwareAndPlainWaiters)
+{
+	SNAP_NAMESPACE::stop_source source;
+	std::atomic<int> value{ 0 };
+	std::atomic<bool> stop_aware_woke{ false };
+
+	std::thread stop_aware([&] { stop_aware_woke = SNAP_NAMESPACE::wait(source.get_token(), value, 0); });
+	std::thread plain([&] { SNAP_NAMESPACE::internal::atomic_wait(value, 0); });
+
+	std::this_thread::sleep_for(5ms);
+	value.store(1);
+	SNAP_NAMESPACE::notify_all(value);
+	stop_aware.join();
+	plain.join();
+	EXPECT_TRUE(stop_aware_woke.load());
+}
+
+TEST(StopWait, WaitReturnsOnStopRequest)
+{
+	SNAP_NAMESPACE::stop_source source;
+	std::atomic<long long> value{ 7 };
+
+	std::thread stopper(
+		[&]
+		{
+			std::this_thread::sleep_for(5ms);
+			source.request_stop();
+		});
+
+	EXPECT_FALSE(SNAP_NAMESPACE::wait(source.get_token(), value, 7LL));
+	stopper.join();
+
+	EXPECT_TRUE(SNAP_NAMESPACE::wait(source.get_token(), value, 8LL));
+}
+
+TEST(StopWait, WaitOnNativeWidthValueReturnsOnStopRequest)
+{
+	for (int round = 0; round < 50; ++round)
+	{
+		SNAP_NAMESPACE::stop_source source;
+		std::atomic<int> value{ 3 };
+
+		std::thread stopper([&] { source.request_stop(); });
+		EXPECT_FALSE(SNAP_NAMESPACE::wait(source.get_token(), value, 3));
+		stopper.join();
+	}
+}
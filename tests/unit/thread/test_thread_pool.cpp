@@ -0,0 +1,124 @@
+#include "snap/thread/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+TEST(ThreadPool, RunsSubmittedTasks)
+{
+	SNAP_NAMESPACE::thread_pool pool(4);
+	EXPECT_EQ(pool.size(), 4u);
+	EXPECT_EQ(pool.current_worker_index(), pool.size());
+
+	std::atomic<int> sum{ 0 };
+	std::vector<SNAP_NAMESPACE::task_handle> handles;
+	for (int i = 1; i <= 100; ++i)
+	{
+		handles.push_back(pool.submit([&sum, i] { sum.fetch_add(i); }));
+	}
+	for (auto& h : handles) { h.wait(); }
+
+	EXPECT_EQ(sum.load(), 5050);
+}
+
+TEST(ThreadPool, NestedSubmissionsUseWorkerDeques)
+{
+	SNAP_NAMESPACE::thread_pool pool(3);
+	std::atomic<int> leaves{ 0 };
+	std::atomic<bool> inside_pool{ true };
+
+	auto root = pool.submit(
+		[&]
+		{
+			for (int i = 0; i < 64; ++i)
+			{
+				pool.submit(
+						[&]
+						{
+							if (pool.current_worker_index() >= pool.size()) { inside_pool.store(false); }
+							leaves.fetch_add(1);
+						})
+					.wait();
+			}
+		});
+	root.wait();
+
+	EXPECT_EQ(leaves.load(), 64);
+	EXPECT_TRUE(inside_pool.load());
+}
+
+TEST(ThreadPool, WaitRethrowsTaskException)
+{
+	SNAP_NAMESPACE::thread_pool pool(1);
+	auto h = pool.submit([] { throw std::runtime_error("boom"); });
+	EXPECT_THROW(h.wait(), std::runtime_error);
+	EXPECT_TRUE(h.done());
+}
+
+TEST(ThreadPool, DestructorDrainsQueueAndStopsTokenAwareTasks)
+{
+	std::atomic<int> ran{ 0 };
+	std::atomic<bool> saw_stop{ false };
+	{
+		SNAP_NAMESPACE::thread_pool pool(2);
+		pool.submit(
+			[&](SNAP_NAMESPACE::stop_token st)
+			{
+				while (!st.stop_requested()) { std::this_thread::yield(); }
+				saw_stop.store(true);
+			});
+		for (int i = 0; i < 50; ++i)
+		{
+			pool.submit([&ran] { ran.fetch_add(1); });
+		}
+	}
+
+	EXPECT_TRUE(saw_stop.load());
+	EXPECT_EQ(ran.load(), 50);
+}
+
+TEST(ThreadPool, SubmitAfterStopIsRejectedAndAdmittedTasksFinish)
+{
+	{
+		SNAP_NAMESPACE::thread_pool pool(1);
+		auto before = pool.submit([] {});
+		pool.request_stop();
+		EXPECT_THROW(pool.submit([] {}), std::system_error);
+		before.wait();
+	}
+
+	// A submitter racing the stop: every handle it got back must complete.
+	for (int round = 0; round < 20; ++round)
+	{
+		std::atomic<int> ran{ 0 };
+		std::vector<SNAP_NAMESPACE::task_handle> handles;
+		{
+			auto pool = std::make_unique<SNAP_NAMESPACE::thread_pool>(2);
+			std::thread producer(
+				[&]
+				{
+					for (;;)
+					{
+						try
+						{
+							handles.push_back(pool->submit([&ran] { ran.fetch_add(1); }));
+						}
+						catch (const std::system_error&)
+						{
+							return;
+						}
+					}
+				});
+			std::this_thread::yield();
+			pool->request_stop();
+			producer.join();
+		}
+		for (auto& h : handles) { h.wait(); }
+		EXPECT_EQ(static_cast<std::size_t>(ran.load()), handles.size());
+	}
+}
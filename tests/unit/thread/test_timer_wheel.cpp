@@ -0,0 +1,186 @@
+#include "snap/thread/timer_wheel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+	template <class Pred> bool eventually(Pred pred, std::chrono::milliseconds timeout = 5s)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + timeout;
+		while (!pred())
+		{
+			if (std::chrono::steady_clock::now() > deadline) { return false; }
+			std::this_thread::sleep_for(1ms);
+		}
+		return true;
+	}
+} // namespace
+
+TEST(TimerWheel, FiresAfterDelay)
+{
+	SNAP_NAMESPACE::timer_wheel wheel;
+
+	std::atomic<bool> fired{ false };
+	const auto armed = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point fired_at{};
+
+	SNAP_NAMESPACE::wheel_timer timer(wheel, 20ms,
+									  [&]
+									  {
+										  fired_at = std::chrono::steady_clock::now();
+										  fired.store(true);
+									  });
+	EXPECT_TRUE(timer.pending());
+	EXPECT_EQ(wheel.pending(), 1u);
+
+	ASSERT_TRUE(eventually([&] { return fired.load(); }));
+	EXPECT_GE(fired_at - armed, 20ms);
+	EXPECT_FALSE(timer.pending());
+	EXPECT_EQ(wheel.pending(), 0u);
+	EXPECT_FALSE(timer.cancel());
+}
+
+TEST(TimerWheel, CancelPreventsCallback)
+{
+	SNAP_NAMESPACE::timer_wheel wheel;
+
+	std::atomic<int> fired{ 0 };
+	{
+		SNAP_NAMESPACE::wheel_timer timer(wheel, 10ms, [&] { fired.fetch_add(1); });
+		EXPECT_TRUE(timer.cancel());
+		EXPECT_FALSE(timer.cancel());
+	}
+	{
+		// Destruction cancels too.
+		SNAP_NAMESPACE::wheel_timer timer(wheel, 10ms, [&] { fired.fetch_add(1); });
+	}
+	std::this_thread::sleep_for(40ms);
+	EXPECT_EQ(fired.load(), 0);
+	EXPECT_EQ(wheel.pending(), 0u);
+}
+
+TEST(TimerWheel, StopTokenCancels)
+{
+	SNAP_NAMESPACE::timer_wheel wheel;
+	SNAP_NAMESPACE::stop_source source;
+
+	std::atomic<int> fired{ 0 };
+	SNAP_NAMESPACE::wheel_timer timer(wheel, 30ms, source.get_token(), [&] { fired.fetch_add(1); });
+	EXPECT_TRUE(timer.pending());
+	source.request_stop();
+	EXPECT_FALSE(timer.pending());
+
+	// Already stopped: never armed.
+	SNAP_NAMESPACE::wheel_timer late(wheel, 1ms, source.get_token(), [&] { fired.fetch_add(1); });
+	EXPECT_FALSE(late.pending());
+
+	std::this_thread::sleep_for(60ms);
+	EXPECT_EQ(fired.load(), 0);
+}
+
+TEST(TimerWheel, FiresInDeadlineOrderAcrossLevels)
+{
+	// Coarse ticks keep the test fast while still crossing level boundaries (level 0 covers 64 ticks).
+	SNAP_NAMESPACE::timer_wheel wheel(1ms);
+
+	std::vector<int> order;
+	std::mutex order_mutex;
+	auto record = [&](int id)
+	{
+		return [&, id]
+		{
+			const std::lock_guard<std::mutex> lock(order_mutex);
+			order.push_back(id);
+		};
+	};
+
+	SNAP_NAMESPACE::wheel_timer t3(wheel, 150ms, record(3));
+	SNAP_NAMESPACE::wheel_timer t1(wheel, 5ms, record(1));
+	SNAP_NAMESPACE::wheel_timer t2(wheel, 70ms, record(2));
+
+	ASSERT_TRUE(eventually(
+		[&]
+		{
+			const std::lock_guard<std::mutex> lock(order_mutex);
+			return order.size() == 3;
+		}));
+	EXPECT_EQ(order, (std::vector<int>{ 1, 2, 3 }));
+}
+
+TEST(TimerWheel, ManyTimersArmAndCancelConcurrently)
+{
+	SNAP_NAMESPACE::timer_wheel wheel;
+	std::atomic<int> fired{ 0 };
+
+	auto bump = [&] { fired.fetch_add(1, std::memory_order_relaxed); };
+	using timer_t = SNAP_NAMESPACE::wheel_timer<decltype(bump)>;
+
+	constexpr int per_thread = 2000;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back(
+			[&, t]
+			{
+				std::vector<std::unique_ptr<timer_t>> timers;
+				timers.reserve(per_thread);
+				for (int i = 0; i < per_thread; ++i) { timers.push_back(std::make_unique<timer_t>(wheel, std::chrono::milliseconds(1 + (i + t) % 50), bump)); }
+				// Cancel every other one; the rest are left to fire.
+				for (int i = 0; i < per_thread; i += 2) { timers[static_cast<std::size_t>(i)]->cancel(); }
+				eventually([&] { return wheel.pending() == 0; });
+			});
+	}
+	for (auto& th : threads) { th.join(); }
+
+	ASSERT_TRUE(eventually([&] { return wheel.pending() == 0; }));
+	EXPECT_GE(fired.load(), 4 * per_thread / 2);
+	EXPECT_LE(fired.load(), 4 * per_thread);
+}
+
+TEST(TimerWheel, CancelWaitsForRunningCallback)
+{
+	SNAP_NAMESPACE::timer_wheel wheel;
+	std::atomic<bool> entered{ false };
+	std::atomic<bool> finished{ false };
+
+	auto timer = std::make_unique<SNAP_NAMESPACE::wheel_timer<std::function<void()>>>(wheel, 1ms,
+																						  [&]
+																						  {
+																							  entered.store(true);
+																							  std::this_thread::sleep_for(30ms);
+																							  finished.store(true);
+																						  });
+	ASSERT_TRUE(eventually([&] { return entered.load(); }));
+	EXPECT_FALSE(timer->cancel());
+	EXPECT_TRUE(finished.load());
+}
+
+TEST(TimerWheel, FarTimersCascadeDown)
+{
+	// 300ms at 50us per tick is 6000 ticks: armed on level 2 and cascaded twice before firing.
+	SNAP_NAMESPACE::timer_wheel wheel(std::chrono::microseconds(50));
+
+	std::atomic<bool> fired{ false };
+	const auto armed = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point fired_at{};
+	SNAP_NAMESPACE::wheel_timer timer(wheel, 300ms,
+									  [&]
+									  {
+										  fired_at = std::chrono::steady_clock::now();
+										  fired.store(true);
+									  });
+
+	ASSERT_TRUE(eventually([&] { return fired.load(); }));
+	EXPECT_GE(fired_at - armed, 300ms);
+	EXPECT_LT(fired_at - armed, 1s);
+}